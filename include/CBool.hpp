@@ -37,10 +37,19 @@ private:
 public:
     // CONSTRUCTORS
     cbool() : m_value(false) {}
+    cbool(const cbool &b) : m_value(b.m_value) {}
     ~cbool() {}
     
     template <class T> cbool(const T &m_value) : m_value(__to_bool(m_value)) {}
 
+    /**
+     * @brief Create a cbool holding the given value, without converting it to bool.
+     * 
+     * @param v The value of the cbool object.
+     * @return cbool The cbool object.
+     */
+    static cbool from_value(const char &v) { cbool b; b.m_value = v; return b; }
+
     // GETTERS
     /**
      * @brief Get the value of the cbool object.
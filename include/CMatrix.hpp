@@ -21,19 +21,241 @@
 #include <vector>
 
 #include "CBool.hpp"
+#include "CMatrixArena.hpp"
+#include "CMatrixBits.hpp"
+#include "CMatrixCallable.hpp"
+#include "CMatrixExec.hpp"
+#include "CMatrixExpr.hpp"
+#include "CMatrixFixed.hpp"
+#include "CMatrixInline.hpp"
+#include "CMatrixLayout.hpp"
+#include "CMatrixParallel.hpp"
+#include "CMatrixShared.hpp"
+#include "CMatrixSimd.hpp"
+#include "CMatrixSparse.hpp"
+#include "CMatrixTask.hpp"
+#include "CMatrixView.hpp"
+
+/**
+ * @brief Enable the bounds checking of the unchecked accessors.
+ * The public accessors (cell, set_cell, ...) always check the indexes. The unchecked ones (at_unchecked,
+ * row_data) and the internal kernels only check them if CMATRIX_BOUNDS_CHECK is 1: by default in the debug
+ * builds, and never in the release builds (NDEBUG defined). Define it before including CMatrix.hpp to override it.
+ */
+#ifndef CMATRIX_BOUNDS_CHECK
+#ifdef NDEBUG
+#define CMATRIX_BOUNDS_CHECK 0
+#else
+#define CMATRIX_BOUNDS_CHECK 1
+#endif
+#endif
 
 /**
  * @brief The main template class that can work with any data type.
  * The cmatrix class is a matrix of any type except bool.
  * To use the bool type, use the cbool class instead. (see CBool.hpp)
+ * The cbool matrices are bit-packed, 64 cells per word. (see CMatrixBits.hpp)
+ * The copies of a matrix share its buffer until one of them is modified. (see CMatrixShared.hpp)
+ * The small matrices of arithmetic type store their cells in the object, without allocation. (see CMatrixInline.hpp)
+ * The buffers of the other matrices can be drawn from a scoped arena, or from a resource of the application. (see CMatrixArena.hpp)
+ * The cells are stored row by row, or column by column with cmatrix_layout::col_major. (see CMatrixLayout.hpp)
+ * The operations only run on several threads above a threshold of work. (see CMatrixParallel.hpp)
+ * The threads are OpenMP threads by default, or the threads of a pool of the application. (see CMatrixExec.hpp)
+ * The recursive kernels spawn their halves as tasks, stolen by the idle threads of a scheduler. (see CMatrixTask.hpp)
  *
  * @tparam T The type of elements in the cmatrix.
+ * @tparam Layout The order of the cells in the buffer. (default: cmatrix_layout::row_major)
  */
-template <class T>
+template <class T, class Layout>
 class cmatrix
 {
 private:
-    std::vector<std::vector<T>> matrix = std::vector<std::vector<T>>();
+    // ATTRIBUTES
+    typedef typename cmatrix_inline::storage<T>::type storage_type;
+    storage_type matrix = storage_type();
+    size_t m_height = 0;
+    size_t m_width = 0;
+    size_t m_stride = 0;
+
+    // ACCESS METHODS
+    /**
+     * @brief Get the position of a cell in the contiguous buffer of the matrix.
+     * The cells are stored row by row, each row starting `m_stride` cells after the previous one,
+     * or column by column with the column-major layout. (see CMatrixLayout.hpp)
+     * With CMATRIX_ALIGNED_ROWS, the lines of the float and double matrices are padded to a cache line.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return size_t The position of the cell in the buffer.
+     *
+     * @note The indexes are not checked.
+     * @ingroup getter
+     */
+    size_t __index(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Get the reference to a cell of the matrix without checking the indexes.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return storage_type::reference The reference to the cell.
+     *
+     * @note The indexes are only checked if CMATRIX_BOUNDS_CHECK is 1.
+     * @ingroup getter
+     */
+    typename storage_type::reference __at(const size_t &row, const size_t &col);
+    /**
+     * @brief Get a cell of the matrix without checking the indexes.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return storage_type::const_reference The cell.
+     *
+     * @note The indexes are only checked if CMATRIX_BOUNDS_CHECK is 1.
+     * @ingroup getter
+     */
+    typename storage_type::const_reference __at(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Resize the matrix to the given dimensions. The previous content of the buffer is lost.
+     *
+     * @param height The number of rows.
+     * @param width The number of columns.
+     * @param val The value to fill the matrix.
+     *
+     * @note A matrix without rows has no columns.
+     * @ingroup general
+     */
+    void __reset(const size_t &height, const size_t &width, const T &val = T());
+    /**
+     * @brief Get the distance between two lines of the buffer, for lines of the given length.
+     * With CMATRIX_ALIGNED_ROWS, the lines of the float and double matrices are padded to a multiple
+     * of 64 bytes, so each line of the aligned buffer starts on a cache line.
+     *
+     * @param width The number of cells of a line: the width, or the height with the column-major layout.
+     * @return size_t The number of cells between the beginning of two lines.
+     *
+     * @ingroup general
+     */
+    static size_t __stride(const size_t &width);
+    /**
+     * @brief Get the transpose of a cbool matrix. The cbool matrices are row-major only, so the cells are copied.
+     *
+     * @param true_type The type of the matrix is cbool.
+     * @return cmatrix<T> The transpose of the matrix.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup getter
+     */
+    cmatrix<T, Layout> __transpose(std::true_type true_type) const;
+    /**
+     * @brief Get the transpose of the matrix in the other layout, sharing the buffer of the matrix.
+     *
+     * @param false_type The type of the matrix is not cbool.
+     * @return cmatrix<T> The transpose of the matrix, in the other layout.
+     *
+     * @ingroup getter
+     */
+    cmatrix<T, typename cmatrix_layout::transposed<Layout>::type> __transpose(std::false_type false_type) const;
+    /**
+     * @brief Get a copy of the rows of a cbool matrix between two indexes. The bit-packed cells have no view.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @param true_type The type of the matrix is cbool.
+     * @return cmatrix<T> The copied rows.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @ingroup getter
+     */
+    cmatrix<T, Layout> __slice_rows(const size_t &start, const size_t &end, std::true_type true_type) const;
+    /**
+     * @brief Get a view on the rows of the matrix between two indexes.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @param false_type The type of the matrix is not cbool.
+     * @return cmatrix_view<T> The view on the rows.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @ingroup getter
+     */
+    cmatrix_view<T> __slice_rows(const size_t &start, const size_t &end, std::false_type false_type) const;
+    /**
+     * @brief Get a copy of the columns of a cbool matrix between two indexes. The bit-packed cells have no view.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @param true_type The type of the matrix is cbool.
+     * @return cmatrix<T> The copied columns.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @ingroup getter
+     */
+    cmatrix<T, Layout> __slice_columns(const size_t &start, const size_t &end, std::true_type true_type) const;
+    /**
+     * @brief Get a view on the columns of the matrix between two indexes.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @param false_type The type of the matrix is not cbool.
+     * @return cmatrix_view<T> The view on the columns.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @ingroup getter
+     */
+    cmatrix_view<T> __slice_columns(const size_t &start, const size_t &end, std::false_type false_type) const;
+    /**
+     * @brief Write the lines of the buffer as the columns of the buffer of another matrix. (see CMatrixTranspose.tpp)
+     * It is the transpose in a matrix of the same layout, and the conversion to a matrix of the other layout.
+     * The cells of a cbool matrix are bit-packed, so they are written one by one through the iterators.
+     *
+     * @param out The matrix receiving the cells. Its dimensions must be checked.
+     * @param true_type The type of the matrix is cbool.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup getter
+     */
+    template <class M>
+    void __transpose_into(cmatrix<T, M> &out, std::true_type true_type) const;
+    /**
+     * @brief Write the lines of the buffer as the columns of the buffer of another matrix, by tiles kept
+     * in the vector registers for the arithmetic types. (see CMatrixTranspose.tpp)
+     *
+     * @param out The matrix receiving the cells. Its dimensions must be checked.
+     * @param false_type The type of the matrix is not cbool.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup getter
+     */
+    template <class M>
+    void __transpose_into(cmatrix<T, M> &out, std::false_type false_type) const;
+
+    // The cbool matrices are bit-packed row by row
+    static_assert(cmatrix_layout::is_row_major<Layout>::value or not std::is_same<T, cbool>::value,
+                  "The cbool matrices must be row-major.");
+
+    // Matrices of other types and layouts can access the buffer directly
+    template <class U, class M>
+    friend class cmatrix;
+
+    // The nodes of the expressions read the buffer directly
+    template <class U>
+    friend struct cmatrix_expr::leaf;
+
+    // The views write their results directly in the buffer
+    template <class U>
+    friend class cmatrix_view;
+
+    // The sparse matrices read and write the dense matrices directly
+    template <class U>
+    friend class csr_matrix;
+
+    // The fixed-size matrices write their conversions directly in the buffer
+    template <class U, size_t R, size_t C>
+    friend class cmatrix_fixed;
 
     // CHECK METHODS
     /**
@@ -53,7 +275,20 @@ private:
      *
      * @ingroup check
      */
-    void __check_size(const cmatrix<T> &m) const;
+    void __check_size(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if the output matrix of a method has the dimensions of the result.
+     *
+     * @tparam U The type of the output matrix.
+     * @param out The output matrix.
+     * @param height The vertical dimension of the result.
+     * @param width The horizontal dimension of the result.
+     * @throw std::invalid_argument If the dimensions of the output matrix are not the dimensions of the result.
+     *
+     * @ingroup check
+     */
+    template <class U, class M>
+    static void __check_out(const cmatrix<U, M> &out, const size_t &height, const size_t &width);
     /**
      * @brief Check if the vector is a valid row of the matrix.
      *
@@ -131,32 +366,45 @@ private:
      * @ingroup check
      */
     void __check_valid_type() const;
+    /**
+     * @brief Check if the indexes are valid indexes of the matrix, if CMATRIX_BOUNDS_CHECK is 1.
+     * Compiled out otherwise, so the unchecked accessors cost a single index computation.
+     *
+     * @param row The row index to check.
+     * @param col The column index to check.
+     * @throw std::out_of_range If an index is out of range and the bounds checking is enabled.
+     *
+     * @ingroup check
+     */
+    void __check_bounds(const size_t &row, const size_t &col) const;
 
     // STATISTIC METHODS
     /**
      * @brief Compute the mean value for each row (axis: 0) or column (axis: 1) of the matrix.
      * This method is used when the type of the matrix is arithmetic.
      *
-     * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns. (default: 0)
+     * @param out The matrix receiving the mean value for each row or column of the matrix.
+     * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns.
      * @param true_type The type of the matrix is arithmetic.
-     * @return cmatrix<float> The mean value for each row or column of the matrix.
      * @throw std::invalid_argument If the axis is not 0 or 1.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the result.
      *
      * @ingroup statistic
      */
-    cmatrix<float> __mean(const unsigned int &axis, std::true_type true_type) const;
+    void __mean_into(cmatrix<float, Layout> &out, const unsigned int &axis, std::true_type true_type) const;
     /**
      * @brief Compute the mean value for each row (axis: 0) or column (axis: 1) of the matrix.
      * This method is used when the type of the matrix is not arithmetic.
      *
-     * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns. (default: 0)
+     * @param out The matrix receiving the mean value for each row or column of the matrix.
+     * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns.
      * @param false_type The type of the matrix is not arithmetic.
      * @throw std::invalid_argument If the matrix is not arithmetic.
      *
      * @ingroup statistic
      *
      */
-    cmatrix<float> __mean(const unsigned int &axis, std::false_type false_type) const;
+    void __mean_into(cmatrix<float, Layout> &out, const unsigned int &axis, std::false_type false_type) const;
     /**
      * @brief Compute the std value for each row (axis: 0) or column (axis: 1) of the matrix.
      * This method is used when the type of the matrix is arithmetic.
@@ -169,7 +417,7 @@ private:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<float> __std(const unsigned int &axis, std::true_type true_type) const;
+    cmatrix<float, Layout> __std(const unsigned int &axis, std::true_type true_type) const;
     /**
      * @brief Compute the std value for each row (axis: 0) or column (axis: 1) of the matrix.
      * This method is used when the type of the matrix is not arithmetic.
@@ -180,21 +428,102 @@ private:
      *
      * @ingroup statistic
      */
-    cmatrix<float> __std(const unsigned int &axis, std::false_type false_type) const;
+    cmatrix<float, Layout> __std(const unsigned int &axis, std::false_type false_type) const;
     /**
-     * @brief Apply a operator to each cell of the matrix.
+     * @brief Fold the cells of each row (axis: 0) or column (axis: 1) of the matrix, in the order of the buffer.
+     * Along the lines of the buffer, each result is folded from its own line. Across the lines, each line
+     * updates a block of results, so the cells are read one after the other instead of with a stride.
      *
-     * @param f The operator to apply. f(T value, T value) -> T
-     * @param m The matrix to apply.
-     * @return cmatrix<T> The result of the operator.
+     * @tparam U The type of the results.
+     * @tparam F The type of the function.
+     * @param acc The initial value of each row or column, replaced by its result.
+     * @param axis The axis to fold. 0 for the rows, 1 for the columns.
+     * @param f The function taking the value of a row or column, one of its cells and the index of the row or column.
+     *
+     * @note The axis is not checked.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup statistic
+     */
+    template <class U, class F>
+    void __fold(std::vector<U> &acc, const unsigned int &axis, const F &f) const;
+    /**
+     * @brief Evaluate an expression in the matrix, in a single pass over the cells.
+     * The expression must have the dimensions of the matrix. It can reference the matrix itself.
+     *
+     * @tparam E The type of the expression.
+     * @param e The expression to evaluate.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup operator
+     */
+    template <class E>
+    void __assign_expr(const E &e);
+    /**
+     * @brief Evaluate an operator between two matrices in the matrix.
+     * The float, double, int32 and int64 matrices use the SIMD kernels of the processor. (see CMatrixSimd.hpp)
+     * A broadcast operand is processed row by row, its single row or value being read in place.
+     *
+     * @tparam O The operator.
+     * @param e The expression to evaluate.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup operator
+     */
+    template <cmatrix_simd::op O>
+    void __assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::leaf<T>> &e);
+    /**
+     * @brief Evaluate an operator between a matrix and a value in the matrix.
+     * The float, double, int32 and int64 matrices use the SIMD kernels of the processor. (see CMatrixSimd.hpp)
+     *
+     * @tparam O The operator.
+     * @param e The expression to evaluate.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> __map_op_arithmetic(const std::function<T(T, T)> &f, const cmatrix<T> &m) const;
+    template <cmatrix_simd::op O>
+    void __assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::scalar<T>> &e);
+    /**
+     * @brief Evaluate an operator between two matrices in the matrix, when one of them is broadcast.
+     * Each row uses the SIMD kernels, with the broadcast row or the value of the broadcast column.
+     *
+     * @tparam O The operator.
+     * @param e The expression to evaluate.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup operator
+     */
+    template <cmatrix_simd::op O>
+    void __assign_broadcast(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::leaf<T>> &e);
+    /**
+     * @brief Evaluate the expression of an assignment operator (+=, -=, ...) in the matrix.
+     * The result must keep the dimensions of the matrix, so only the other operand can be broadcast.
+     *
+     * @tparam E The type of the expression.
+     * @param e The expression to evaluate.
+     * @return cmatrix<T>& The matrix.
+     * @throw std::invalid_argument If the result doesn't have the dimensions of the matrix.
+     *
+     * @ingroup operator
+     */
+    template <class E>
+    cmatrix<T, Layout> &__assign_update(const E &e);
+    /**
+     * @brief Check if an expression reads the buffer of the matrix through a view, so it can't be evaluated in place.
+     * The buffer is read without being copied, so the views of a copy sharing it overlap it too.
+     *
+     * @tparam E The type of the expression.
+     * @param e The expression.
+     * @return bool True if the expression must be evaluated in a temporary matrix.
+     *
+     * @ingroup operator
+     */
+    template <class E>
+    bool __overlaps(const E &e) const;
     /**
      * @brief Apply a operator to each cell of the matrix.
      *
+     * @tparam F The type of the operator, inlined in the loop.
      * @param f The operator to apply. f(T value, T value) -> T
      * @param val The value to apply.
      * @return cmatrix<T> The result of the operator.
@@ -202,7 +531,125 @@ private:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> __map_op_arithmetic(const std::function<T(T, T)> &f, const T &val) const;
+    template <class F>
+    cmatrix<T, Layout> __map_op_arithmetic(const F &f, const T &val) const;
+
+    // MANIPULATION METHODS
+    /**
+     * @brief Insert a line in the buffer: a row, or a column with the column-major layout.
+     *
+     * @param pos The position of the line.
+     * @param val The cells of the line.
+     *
+     * @note The dimensions are not checked.
+     * @ingroup manipulation
+     */
+    void __insert_line(const size_t &pos, const std::vector<T> &val);
+    /**
+     * @brief Insert a cell in each line of the buffer: a column, or a row with the column-major layout.
+     *
+     * @param pos The position of the cell in the lines.
+     * @param val The cell of each line.
+     *
+     * @note The dimensions are not checked.
+     * @ingroup manipulation
+     */
+    void __insert_across(const size_t &pos, const std::vector<T> &val);
+    /**
+     * @brief Remove a line of the buffer: a row, or a column with the column-major layout.
+     *
+     * @param pos The position of the line.
+     *
+     * @note The position is not checked.
+     * @ingroup manipulation
+     */
+    void __remove_line(const size_t &pos);
+    /**
+     * @brief Remove a cell of each line of the buffer: a column, or a row with the column-major layout.
+     *
+     * @param pos The position of the cell in the lines.
+     *
+     * @note The position is not checked.
+     * @ingroup manipulation
+     */
+    void __remove_across(const size_t &pos);
+    /**
+     * @brief Transpose the square buffer in place, cell by cell through the iterators of the bit-packed buffer.
+     *
+     * @param true_type The type of the matrix is cbool.
+     *
+     * @note The matrix must be square.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    void __transpose_inplace(std::true_type true_type);
+    /**
+     * @brief Transpose the square buffer in place, by swapping the tiles across the diagonal.
+     *
+     * @param false_type The type of the matrix is not cbool.
+     *
+     * @note The matrix must be square.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    void __transpose_inplace(std::false_type false_type);
+
+    // MASK METHODS
+    /**
+     * @brief Compare each cell of the matrix to the cell of another matrix.
+     * The float, double, int32 and int64 matrices use the SIMD kernels of the processor, which write
+     * the bits of the mask directly. The cbool matrices are compared a word at a time.
+     * A matrix with a single row or column is broadcast to the dimensions of the other one.
+     *
+     * @tparam C The comparison.
+     * @param m The matrix to compare.
+     * @return cmatrix<cbool> The mask of the cells satisfying the comparison.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    template <cmatrix_simd::cmp C>
+    cmatrix<cbool> __compare(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Compare each cell of the matrix to the cell of another matrix, broadcasting their single rows or columns.
+     *
+     * @tparam C The comparison.
+     * @param m The matrix to compare.
+     * @return cmatrix<cbool> The mask of the cells satisfying the comparison, with the broadcast dimensions.
+     * @throw std::invalid_argument If the dimensions can't be broadcast together.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    template <cmatrix_simd::cmp C>
+    cmatrix<cbool> __compare_broadcast(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Compare each cell of the matrix to the cell of a view, broadcasting their single rows or columns.
+     * The cells of the view are read in place, through its strides.
+     *
+     * @tparam C The comparison.
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the cells satisfying the comparison, with the broadcast dimensions.
+     * @throw std::invalid_argument If the dimensions can't be broadcast together.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    template <cmatrix_simd::cmp C>
+    cmatrix<cbool> __compare(const cmatrix_view<T> &m) const;
+    /**
+     * @brief Compare each cell of the matrix to a value.
+     *
+     * @tparam C The comparison.
+     * @param val The value to compare.
+     * @return cmatrix<cbool> The mask of the cells satisfying the comparison.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    template <cmatrix_simd::cmp C>
+    cmatrix<cbool> __compare(const T &val) const;
 
     // GENERAL METHODS
     /**
@@ -215,7 +662,7 @@ private:
      * @ingroup general
      */
     template <class U>
-    cmatrix<U> __cast(std::true_type true_type) const;
+    cmatrix<U, Layout> __cast(std::true_type true_type) const;
     /**
      * @brief Convert the matrix to a matrix of another type.
      *
@@ -226,7 +673,7 @@ private:
      * @ingroup general
      */
     template <class U>
-    cmatrix<U> __cast(std::false_type false_type) const;
+    cmatrix<U, Layout> __cast(std::false_type false_type) const;
     /**
      * @brief Convert the matrix to a string matrix.
      *
@@ -236,7 +683,7 @@ private:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup general
      */
-    cmatrix<std::string> __to_string(std::true_type true_type) const;
+    cmatrix<std::string, Layout> __to_string(std::true_type true_type) const;
     /**
      * @brief Convert the matrix to a string matrix.
      *
@@ -245,9 +692,21 @@ private:
      *
      * @ingroup general
      */
-    cmatrix<std::string> __to_string(std::false_type false_type) const;
+    cmatrix<std::string, Layout> __to_string(std::false_type false_type) const;
 
 public:
+    // TYPES
+    /**
+     * @brief The type of the transpose of the matrix: the matrix in the other layout, reading the buffer of
+     * the matrix. The cbool matrices are row-major only, so their transpose is row-major too.
+     */
+    typedef cmatrix<T, typename std::conditional<std::is_same<T, cbool>::value, Layout, typename cmatrix_layout::transposed<Layout>::type>::type> transpose_type;
+    /**
+     * @brief The type of the slices of the matrix: a view on its buffer. The cells of the cbool matrices are
+     * bit-packed, so a view can't address them and their slices are copies.
+     */
+    typedef typename std::conditional<std::is_same<T, cbool>::value, cmatrix<T, Layout>, cmatrix_view<T>>::type slice_type;
+
     // CONSTRUCTOR METHODS
     /**
      * @brief Construct a new cmatrix object.
@@ -275,6 +734,21 @@ public:
      * @endcode
      */
     cmatrix(const std::vector<std::vector<T>> &m);
+    /**
+     * @brief Construct a new cmatrix object by moving the cells of a vector matrix.
+     * The cells are moved in the buffer of the matrix and the vector is cleared.
+     *
+     * @param m The vector matrix.
+     * @throw std::invalid_argument If the vector is not a matrix.
+     * @throw std::invalid_argument If the type is bool.
+     *
+     * @code
+     * $ std::vector<std::vector<std::string>> v = {{"a", "b"}, {"c", "d"}};
+     * $ cmatrix<std::string> m(std::move(v));
+     * > [[a, b], [c, d]]
+     * @endcode
+     */
+    cmatrix(std::vector<std::vector<T>> &&m);
     /**
      * @brief Construct a new cmatrix object.
      *
@@ -313,11 +787,41 @@ public:
      * @endcode
      */
     cmatrix(const size_t &height, const size_t &width, const T &val);
+    /**
+     * @brief Copy a matrix.
+     *
+     * @param m The matrix to copy.
+     */
+    cmatrix(const cmatrix<T, Layout> &m);
+    /**
+     * @brief Move a matrix. The buffer is taken from the matrix, which becomes empty.
+     *
+     * @param m The matrix to move.
+     */
+    cmatrix(cmatrix<T, Layout> &&m) noexcept;
+    /**
+     * @brief Copy a matrix stored in another layout.
+     * The cells are copied by square tiles, so the reads and the writes stay in the cache.
+     *
+     * @param m The matrix to copy.
+     * @tparam M The layout of the matrix to copy.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ cmatrix<int, cmatrix_layout::col_major> n(m);
+     * > n = [[1, 2], [3, 4]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    template <class M>
+    cmatrix(const cmatrix<T, M> &m);
     /**
      * @brief Cast a matrix to another type.
      *
      * @param m The matrix to copy.
      * @tparam U The type of the matrix to copy.
+     * @tparam M The layout of the matrix to copy.
      * @throw std::invalid_argument If the type is bool.
      *
      * @code
@@ -326,8 +830,25 @@ public:
      * > n = [[1.0, 2.0], [3.0, 4.0]]
      * @endcode
      */
-    template <class U>
-    cmatrix(const cmatrix<U> &m);
+    template <class U, class M>
+    cmatrix(const cmatrix<U, M> &m);
+    /**
+     * @brief Construct a new cmatrix object from an arithmetic expression.
+     * The expression is evaluated in a single pass, without temporary matrix. (see CMatrixExpr.hpp)
+     *
+     * @tparam E The type of the expression.
+     * @param e The expression to evaluate.
+     *
+     * @code
+     * $ cmatrix<int> a = {{1, 2}, {3, 4}};
+     * $ cmatrix<int> m = a * 2 - 1;
+     * > m = [[1, 3], [5, 7]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    template <class E>
+    cmatrix(const cmatrix_expr::expr<E, T> &e);
     /**
      * @brief Destroy the cmatrix object.
      */
@@ -366,7 +887,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> get(const cmatrix<cbool> &m) const;
+    cmatrix<T, Layout> get(const cmatrix<cbool> &m) const;
 
     /**
      * @brief Get a row of the matrix.
@@ -416,7 +937,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> rows(const size_t &ids) const;
+    cmatrix<T, Layout> rows(const size_t &ids) const;
     /**
      * @brief Get the rows of the matrix.
      *
@@ -432,7 +953,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> rows(const std::initializer_list<size_t> &ids) const;
+    cmatrix<T, Layout> rows(const std::initializer_list<size_t> &ids) const;
     /**
      * @brief Get the rows of the matrix.
      *
@@ -448,7 +969,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> rows(const std::vector<size_t> &ids) const;
+    cmatrix<T, Layout> rows(const std::vector<size_t> &ids) const;
     /**
      * @brief Get the columns of the matrix.
      *
@@ -464,7 +985,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> columns(const size_t &ids) const;
+    cmatrix<T, Layout> columns(const size_t &ids) const;
     /**
      * @brief Get the columns of the matrix.
      *
@@ -480,7 +1001,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> columns(const std::initializer_list<size_t> &ids) const;
+    cmatrix<T, Layout> columns(const std::initializer_list<size_t> &ids) const;
     /**
      * @brief Get the columns of the matrix.
      *
@@ -496,7 +1017,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> columns(const std::vector<size_t> &ids) const;
+    cmatrix<T, Layout> columns(const std::vector<size_t> &ids) const;
     /**
      * @brief Get the cells of the matrix.
      *
@@ -513,7 +1034,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> cells(const size_t &row, const size_t &col) const;
+    cmatrix<T, Layout> cells(const size_t &row, const size_t &col) const;
     /**
      * @brief Get the cells of the matrix.
      *
@@ -529,7 +1050,7 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> cells(const std::initializer_list<std::pair<size_t, size_t>> &ids) const;
+    cmatrix<T, Layout> cells(const std::initializer_list<std::pair<size_t, size_t>> &ids) const;
     /**
      * @brief Get the cells of the matrix.
      *
@@ -545,13 +1066,13 @@ public:
      *
      * @ingroup getter
      */
-    cmatrix<T> cells(const std::vector<std::pair<size_t, size_t>> &ids) const;
+    cmatrix<T, Layout> cells(const std::vector<std::pair<size_t, size_t>> &ids) const;
     /**
      * @brief Get the reference to a cell of the matrix.
      *
      * @param row The row of the cell to get.
      * @param col The column of the cell to get.
-     * @return T The cell.
+     * @return storage_type::reference The reference to the cell. A proxy on the bit for the cbool matrices.
      * @throw std::out_of_range If the index is out of range.
      *
      * @code
@@ -560,46 +1081,226 @@ public:
      * > [[5, 2], [3, 4]]
      * @endcode
      *
+     * @note The matrix stops sharing its buffer: its next copies get their own, so a write through
+     *       the reference never changes them. Use set_cell to keep the copies in O(1).
+     * @ingroup getter
+     */
+    typename storage_type::reference cell(const size_t &row, const size_t &col);
+    /**
+     * @brief Get a cell of the matrix.
+     *
+     * @param row The row of the cell to get.
+     * @param col The column of the cell to get.
+     * @return T The cell.
+     * @throw std::out_of_range If the index is out of range.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.cell(0, 0);
+     * > 1
+     * @endcode
+     *
+     * @ingroup getter
+     */
+    T cell(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Get the reference to a cell of the matrix without checking the indexes.
+     * The fast path of cell, for the loops whose indexes are already valid.
+     *
+     * @param row The row of the cell to get.
+     * @param col The column of the cell to get.
+     * @return storage_type::reference The reference to the cell. A proxy on the bit for the cbool matrices.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.at_unchecked(1, 0) = 5;
+     * > [[1, 2], [5, 4]]
+     * @endcode
+     *
+     * @note The indexes are only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @note As with cell, the next copies of the matrix get their own buffer.
+     * @ingroup getter
+     */
+    typename storage_type::reference at_unchecked(const size_t &row, const size_t &col);
+    /**
+     * @brief Get a cell of the matrix without checking the indexes.
+     * The fast path of cell, for the loops whose indexes are already valid.
+     *
+     * @param row The row of the cell to get.
+     * @param col The column of the cell to get.
+     * @return storage_type::const_reference The cell.
+     *
+     * @note The indexes are only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @ingroup getter
+     */
+    typename storage_type::const_reference at_unchecked(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Get the pointer to the contiguous buffer of the matrix.
+     * The cells are stored row by row, the row `r` starting at `data() + r * stride()`.
+     * With the column-major layout, they are stored column by column, the column `c` starting at `data() + c * stride()`.
+     *
+     * @return T* The pointer to the first cell. The write access copies the buffer if it is shared with a copy.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.data()[3];
+     * > 4
+     * @endcode
+     *
+     * @note The next copies of the matrix get their own buffer, so the writes through the pointer don't change them.
+     * @note Not available for the cbool matrices, whose cells are bit-packed.
+     * @note The pointer is invalidated when the matrix is destroyed or its dimensions change.
+     * @ingroup getter
+     */
+    T *data();
+    /**
+     * @brief Get the pointer to the contiguous buffer of the matrix.
+     * The cells are stored row by row, the row `r` starting at `data() + r * stride()`.
+     * With the column-major layout, they are stored column by column, the column `c` starting at `data() + c * stride()`.
+     *
+     * @return const T* The pointer to the first cell.
+     *
+     * @note Not available for the cbool matrices, whose cells are bit-packed.
+     * @note The pointer is invalidated when the matrix is destroyed or its dimensions change.
+     * @ingroup getter
+     */
+    const T *data() const;
+    /**
+     * @brief Get the pointer to the first cell of a row. The `width()` cells of the row are contiguous.
+     * Only available for the row-major matrices.
+     *
+     * @param row The row.
+     * @return T* The pointer to the row. The write access copies the buffer if it is shared with a copy.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.row_data(1)[0] = 5;
+     * > [[1, 2], [5, 4]]
+     * @endcode
+     *
+     * @note The next copies of the matrix get their own buffer, as with data().
+     * @note The index is only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @note Not available for the cbool matrices, whose cells are bit-packed.
+     * @ingroup getter
+     */
+    T *row_data(const size_t &row);
+    /**
+     * @brief Get the pointer to the first cell of a row. The `width()` cells of the row are contiguous.
+     * Only available for the row-major matrices.
+     *
+     * @param row The row.
+     * @return const T* The pointer to the row.
+     *
+     * @note The index is only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @note Not available for the cbool matrices, whose cells are bit-packed.
+     * @ingroup getter
+     */
+    const T *row_data(const size_t &row) const;
+    /**
+     * @brief Get the pointer to the first cell of a column. The `height()` cells of the column are contiguous.
+     * Only available for the column-major matrices.
+     *
+     * @param col The column.
+     * @return T* The pointer to the column. The write access copies the buffer if it is shared with a copy.
+     *
+     * @code
+     * $ cmatrix<int, cmatrix_layout::col_major> m = {{1, 2}, {3, 4}};
+     * $ m.col_data(1)[0] = 5;
+     * > [[1, 5], [3, 4]]
+     * @endcode
+     *
+     * @note The next copies of the matrix get their own buffer, as with data().
+     * @note The index is only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @ingroup getter
+     */
+    T *col_data(const size_t &col);
+    /**
+     * @brief Get the pointer to the first cell of a column. The `height()` cells of the column are contiguous.
+     * Only available for the column-major matrices.
+     *
+     * @param col The column.
+     * @return const T* The pointer to the column.
+     *
+     * @note The index is only checked if CMATRIX_BOUNDS_CHECK is 1. (default: debug builds)
+     * @ingroup getter
+     */
+    const T *col_data(const size_t &col) const;
+    /**
+     * @brief Get a read-only view on the whole matrix, without copy.
+     *
+     * @return cmatrix_view<T> The view on the matrix.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.view().transpose();
+     * > [[1, 3], [2, 4]]
+     * @endcode
+     *
+     * @note The view is invalidated when the matrix is destroyed or its dimensions change.
+     * @ingroup getter
+     */
+    cmatrix_view<T> view() const;
+    /**
+     * @brief Get a view on the rows between two indexes, without copy.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @return slice_type The view on the rows between two indexes. Assign it to a cmatrix to get a copy.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}, {5, 6}};
+     * $ m.slice_rows(0, 1);
+     * > [[1, 2], [3, 4]]
+     * @endcode
+     *
+     * @note The view is invalidated when the matrix is destroyed or its dimensions change.
+     * @note The cells of a cbool matrix are copied: the slice is a cmatrix<cbool>.
      * @ingroup getter
      */
-    T &cell(const size_t &row, const size_t &col);
+    slice_type slice_rows(const size_t &start, const size_t &end) const &;
     /**
-     * @brief Get a cell of the matrix.
+     * @brief Get a copy of the rows of a temporary matrix between two indexes.
+     * A view would outlive the temporary matrix, so the cells are copied.
      *
-     * @param row The row of the cell to get.
-     * @param col The column of the cell to get.
-     * @return T The cell.
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @return cmatrix<T> The rows between two indexes.
      * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
      *
      * @code
-     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
-     * $ m.cell(0, 0);
-     * > 1
+     * $ cmatrix<int>({{1, 2}, {3, 4}, {5, 6}}).slice_rows(0, 1);
+     * > [[1, 2], [3, 4]]
      * @endcode
      *
      * @ingroup getter
      */
-    T cell(const size_t &row, const size_t &col) const;
+    cmatrix<T, Layout> slice_rows(const size_t &start, const size_t &end) &&;
     /**
-     * @brief Get the rows between two indexes.
+     * @brief Get a view on the columns between two indexes, without copy.
      *
      * @param start The start index inclusive.
      * @param end The end index inclusive.
-     * @return cmatrix<T> The rows between two indexes.
+     * @return slice_type The view on the columns between two indexes. Assign it to a cmatrix to get a copy.
      * @throw std::out_of_range If the index is out of range.
      * @throw std::invalid_argument If the start index is greater than the end index.
      *
      * @code
-     * $ cmatrix<int> m = {{1, 2}, {3, 4}, {5, 6}};
-     * $ m.slice_rows(0, 1);
-     * > [[1, 2], [3, 4]]
+     * $ cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+     * $ m.slice_columns(0, 1);
+     * > [[1, 2], [4, 5]]
      * @endcode
      *
+     * @note The view is invalidated when the matrix is destroyed or its dimensions change.
+     * @note The cells of a cbool matrix are copied: the slice is a cmatrix<cbool>.
      * @ingroup getter
      */
-    cmatrix<T> slice_rows(const size_t &start, const size_t &end) const;
+    slice_type slice_columns(const size_t &start, const size_t &end) const &;
     /**
-     * @brief Get the columns between two indexes.
+     * @brief Get a copy of the columns of a temporary matrix between two indexes.
+     * A view would outlive the temporary matrix, so the cells are copied.
      *
      * @param start The start index inclusive.
      * @param end The end index inclusive.
@@ -608,14 +1309,13 @@ public:
      * @throw std::invalid_argument If the start index is greater than the end index.
      *
      * @code
-     * $ cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
-     * $ m.slice_columns(0, 1);
+     * $ cmatrix<int>({{1, 2, 3}, {4, 5, 6}}).slice_columns(0, 1);
      * > [[1, 2], [4, 5]]
      * @endcode
      *
      * @ingroup getter
      */
-    cmatrix<T> slice_columns(const size_t &start, const size_t &end) const;
+    cmatrix<T, Layout> slice_columns(const size_t &start, const size_t &end) &&;
 
     /**
      * @brief The number of columns of the matrix.
@@ -631,6 +1331,23 @@ public:
      * @ingroup getter
      */
     size_t width() const;
+    /**
+     * @brief The number of cells between the beginning of two rows in the buffer of the matrix,
+     * or of two columns with the column-major layout. It is the width, or the height, unless
+     * CMATRIX_ALIGNED_ROWS pads the lines of the float and double matrices to a multiple of 64 bytes.
+     * The padding cells are not part of the matrix.
+     *
+     * @return size_t The number of cells between two rows, or two columns.
+     *
+     * @code
+     * $ cmatrix<float> m(2, 3);
+     * $ m.stride(); // With CMATRIX_ALIGNED_ROWS
+     * > 16
+     * @endcode
+     *
+     * @ingroup getter
+     */
+    size_t stride() const;
     /**
      * @brief The number of rows of the matrix.
      *
@@ -693,9 +1410,13 @@ public:
     U height_t() const;
 
     /**
-     * @brief Get the transpose of the matrix.
+     * @brief Get the transpose of the matrix, in O(1).
+     * The transpose is the matrix in the other layout, sharing its buffer until one of them is modified:
+     * the rows stored one after the other are the columns of the transpose. So the cells are not moved,
+     * and the products of a transpose (`a.transpose().matmul(b)`) read the buffer of the matrix.
+     * Assigning it to a matrix of the same layout copies the cells.
      *
-     * @return cmatrix<T> The transpose of the matrix.
+     * @return transpose_type The transpose of the matrix.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -703,10 +1424,29 @@ public:
      * > [[1, 3], [2, 4]]
      * @endcode
      *
+     * @note The cells of a cbool matrix are copied: its transpose is row-major.
+     * @ingroup getter
+     */
+    transpose_type transpose() const;
+    /**
+     * @brief Write the transpose of the matrix in another matrix, without allocating it.
+     *
+     * @param out The matrix receiving the transpose. Its dimensions must be the dimensions of the transpose.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the transpose.
+     * @throw std::invalid_argument If the matrix `out` is the matrix itself.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}, {5, 6}};
+     * $ cmatrix<int> t(2, 3);
+     * $ m.transpose_into(t);
+     * $ t
+     * > [[1, 3, 5], [2, 4, 6]]
+     * @endcode
+     *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup getter
      */
-    cmatrix<T> transpose() const;
+    void transpose_into(cmatrix<T, Layout> &out) const;
     /**
      * @brief Get the diagonal of the matrix.
      *
@@ -975,9 +1715,23 @@ public:
      * @endcode
      *
      * @note The empty matrix always return (-1, -1).
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup manipulation
      */
     std::pair<int, int> find(const std::function<bool(T)> &f) const;
+    /**
+     * @brief Find the first cell matching the condition.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @return std::pair<int, int> The first index (row, column) of the cell. (-1, -1) if not found.
+     *
+     * @note The empty matrix always return (-1, -1).
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<std::pair<int, int>, F, T> find(F &&f) const;
     /**
      * @brief Find the first cell matching the given cell.
      *
@@ -1058,9 +1812,23 @@ public:
      * @endcode
      *
      * @note The empty matrix always return an empty vector.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup manipulation
      */
     std::vector<std::pair<size_t, size_t>> find_all(const std::function<bool(T)> &f) const;
+    /**
+     * @brief Find all cells matching the condition.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @return std::vector<std::pair<size_t, size_t>> The indexes (row, column) of the cells.
+     *
+     * @note The empty matrix always return an empty vector.
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<std::vector<std::pair<size_t, size_t>>, F, T> find_all(F &&f) const;
     /**
      * @brief Create a mask of the matrix matching the condition.
      *
@@ -1073,9 +1841,42 @@ public:
      * > [[true, false], [false, false]]
      * @endcode
      *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup manipulation
      */
     cmatrix<cbool> mask(const std::function<bool(T)> &f) const;
+    /**
+     * @brief Create a mask of the matrix matching the condition.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @return cmatrix<cbool> The mask of the matrix.
+     *
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T> mask(F &&f) const;
+    /**
+     * @brief Write the mask of the matrix matching the condition in another matrix, without allocating it.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param out The mask receiving the result. Its dimensions must be the dimensions of the matrix.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the matrix.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ cmatrix<cbool> out(2, 2);
+     * $ m.mask_into(out, [](int value) { return value > 2; });
+     * $ out
+     * > [[false, false], [true, true]]
+     * @endcode
+     *
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<void, F, T> mask_into(cmatrix<cbool> &out, F &&f) const;
     /**
      * @brief Create a mask of the matrix matching the mask of another matrix.
      *
@@ -1092,9 +1893,82 @@ public:
      * > [[true, false], [false, true]]
      * @endcode
      *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> mask(const std::function<bool(T, T)> &f, const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Create a mask of the matrix matching the mask of another matrix.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value, T value) -> bool
+     * @param m The mask of the matrix.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     *
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T, T> mask(F &&f, const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Write the mask of the matrix matching the mask of another matrix in a third matrix, without allocating it.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param out The mask receiving the result. Its dimensions must be the dimensions of the matrix.
+     * @param f The condition to satisfy. f(T value, T value) -> bool
+     * @param m The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     *
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<void, F, T, T> mask_into(cmatrix<cbool> &out, F &&f, const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Create a mask of the matrix matching the cells of a view, without copying the view.
+     *
+     * @param f The condition to satisfy. f(T value, T value) -> bool
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view are not equals.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {2, 4}};
+     * $ m.mask([](int a, int b) { return a == b; }, m.view().transpose());
+     * > [[true, true], [true, true]]
+     * @endcode
+     *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> mask(const std::function<bool(T, T)> &f, const cmatrix_view<T> &m) const;
+    /**
+     * @brief Create a mask of the matrix matching the cells of a view, without copying the view.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value, T value) -> bool
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view are not equals.
+     *
+     * @ingroup manipulation
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T, T> mask(F &&f, const cmatrix_view<T> &m) const;
+    /**
+     * @brief Write the mask of the matrix matching the cells of a view in a third matrix, without allocating it.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param out The mask receiving the result. Its dimensions must be the dimensions of the matrix.
+     * @param f The condition to satisfy. f(T value, T value) -> bool
+     * @param m The view to compare.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view are not equals.
+     *
      * @ingroup manipulation
      */
-    cmatrix<cbool> mask(const std::function<bool(T, T)> &f, const cmatrix<T> &m) const;
+    template <class F>
+    cmatrix_fn::if_callable_t<void, F, T, T> mask_into(cmatrix<cbool> &out, F &&f, const cmatrix_view<T> &m) const;
     /**
      * @brief Negate the mask of the matrix.
      *
@@ -1115,7 +1989,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1123,9 +1997,27 @@ public:
      * > [[true, true], [false, true]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> eq(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are equals to the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.eq(m.view().transpose());
+     * > [[true, false], [false, true]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
      * @ingroup manipulation
      */
-    cmatrix<cbool> eq(const cmatrix<T> &m) const;
+    cmatrix<cbool> eq(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are equals to a value.
      *
@@ -1146,7 +2038,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1154,9 +2046,27 @@ public:
      * > [[false, false], [true, false]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> neq(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are not equals to the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.neq(m.view().transpose());
+     * > [[false, true], [true, false]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
      * @ingroup manipulation
      */
-    cmatrix<cbool> neq(const cmatrix<T> &m) const;
+    cmatrix<cbool> neq(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are not equals to a value.
      *
@@ -1177,7 +2087,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1185,9 +2095,27 @@ public:
      * > [[true, true], [true, true]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> leq(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are less or equals to the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.leq(m.view().transpose());
+     * > [[true, true], [false, true]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
      * @ingroup manipulation
      */
-    cmatrix<cbool> leq(const cmatrix<T> &m) const;
+    cmatrix<cbool> leq(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are less or equals to a value.
      *
@@ -1208,7 +2136,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1216,9 +2144,27 @@ public:
      * > [[true, true], [true, true]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
      * @ingroup manipulation
      */
-    cmatrix<cbool> geq(const cmatrix<T> &m) const;
+    cmatrix<cbool> geq(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are greater or equals to the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.geq(m.view().transpose());
+     * > [[true, false], [true, true]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> geq(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are greater or equals to a value.
      *
@@ -1239,7 +2185,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1247,9 +2193,27 @@ public:
      * > [[false, false], [false, false]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> lt(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are less than the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.lt(m.view().transpose());
+     * > [[false, true], [false, false]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
      * @ingroup manipulation
      */
-    cmatrix<cbool> lt(const cmatrix<T> &m) const;
+    cmatrix<cbool> lt(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are less than a value.
      *
@@ -1270,7 +2234,7 @@ public:
      *
      * @param m The matrix to compare.
      * @return cmatrix<cbool> The mask of the matrix.
-     * @throw std::invalid_argument If the dimensions of the matrices are not equals.
+     * @throw std::invalid_argument If the dimensions of the matrices can't be broadcast together.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
@@ -1278,9 +2242,27 @@ public:
      * > [[false, false], [true, false]]
      * @endcode
      *
+     * @note A matrix with a single row or column is broadcast to the dimensions of the other one.
+     * @ingroup manipulation
+     */
+    cmatrix<cbool> gt(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Check if each cell of the matrix are greater than the cells of a view, without copying the view.
+     *
+     * @param m The view to compare.
+     * @return cmatrix<cbool> The mask of the matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix and the view can't be broadcast together.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.gt(m.view().transpose());
+     * > [[false, false], [true, false]]
+     * @endcode
+     *
+     * @note A single row or column is broadcast to the dimensions of the other operand.
      * @ingroup manipulation
      */
-    cmatrix<cbool> gt(const cmatrix<T> &m) const;
+    cmatrix<cbool> gt(const cmatrix_view<T> &m) const;
     /**
      * @brief Check if each cell of the matrix are greater than a value.
      *
@@ -1345,7 +2327,25 @@ public:
      *
      * @ingroup manipulation
      */
-    void concatenate(const cmatrix<T> &m, const unsigned int &axis = 0);
+    void concatenate(const cmatrix<T, Layout> &m, const unsigned int &axis = 0);
+    /**
+     * @brief Transpose the square matrix in place, without allocating.
+     * The tiles above the diagonal are swapped with the tiles below it, each one transposed in the vector
+     * registers. Unlike transpose(), the matrix keeps its layout.
+     *
+     * @throw std::invalid_argument If the matrix is not square.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.transpose_inplace();
+     * > [[1, 3], [2, 4]]
+     * @endcode
+     *
+     * @note The matrix is copied before being transposed if it shares its buffer with another matrix.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup manipulation
+     */
+    void transpose_inplace();
 
     // CHECK METHODS
     /**
@@ -1503,9 +2503,24 @@ public:
      * @endcode
      *
      * @note The empty matrix always return true.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup check
      */
     bool all(const std::function<bool(T)> &f) const;
+    /**
+     * @brief Check if all the cells of the matrix satisfy a condition.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @return true If all the cells satisfy the condition.
+     * @return false If at least one cell does not satisfy the condition.
+     *
+     * @note The empty matrix always return true.
+     * @ingroup check
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<bool, F, T> all(F &&f) const;
     /**
      * @brief Check if all the cells of the matrix are equal to a value.
      *
@@ -1537,9 +2552,24 @@ public:
      * @endcode
      *
      * @note The empty matrix always return false.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup check
      */
     bool any(const std::function<bool(T)> &f) const;
+    /**
+     * @brief Check if at least one cell of the matrix satisfies a condition.
+     * The condition is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the condition: a lambda, a function object or a function pointer.
+     * @param f The condition to satisfy. f(T value) -> bool
+     * @return true If at least one cell satisfies the condition.
+     * @return false If all the cells do not satisfy the condition.
+     *
+     * @note The empty matrix always return false.
+     * @ingroup check
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<bool, F, T> any(F &&f) const;
     /**
      * @brief Check if at least one cell of the matrix is equal to a value.
      *
@@ -1582,7 +2612,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<T> min(const unsigned int &axis = 0) const;
+    cmatrix<T, Layout> min(const unsigned int &axis = 0) const;
     /**
      * @brief Get the minimum value of all the elements of the matrix.
      *
@@ -1622,7 +2652,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<T> max(const unsigned int &axis = 0) const;
+    cmatrix<T, Layout> max(const unsigned int &axis = 0) const;
     /**
      * @brief Get the maximum value of all the elements of the matrix.
      *
@@ -1662,7 +2692,28 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<T> sum(const unsigned int &axis = 0, const T &zero = T()) const;
+    cmatrix<T, Layout> sum(const unsigned int &axis = 0, const T &zero = T()) const;
+    /**
+     * @brief Write the sum of each row (axis: 0) or column (axis: 1) of the matrix in another matrix, without allocating it.
+     *
+     * @param out The matrix receiving the sums: a column for the rows, a row for the columns.
+     * @param axis The axis to sum. 0 for the rows, 1 for the columns. (default: 0)
+     * @param zero The zero value of the sum. (default: the value of the default constructor of the type T)
+     * @throw std::invalid_argument If the axis is not 0 or 1.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the result.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ cmatrix<int> out(1, 2);
+     * $ m.sum_into(out, 1);
+     * $ out
+     * > [[4, 6]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup statistic
+     */
+    void sum_into(cmatrix<T, Layout> &out, const unsigned int &axis = 0, const T &zero = T()) const;
     /**
      * @brief Get the sum of all the elements of the matrix.
      *
@@ -1675,33 +2726,56 @@ public:
      * > 10
      * @endcode
      *
+     * @note The sum of a cbool matrix counts its true cells in the value of the cbool, as cbool::operator+= does.
+     *       The count is computed with a population count of each word, and wraps around like the char of the cbool.
      * @ingroup statistic
      */
     T sum_all(const T &zero = T()) const;
     /**
-     * @brief Get the mean value for each row (axis: 0) or column (axis: 1) of the matrix.
+     * @brief Get the mean value for each row (axis: 0) or column (axis: 1) of the matrix.
+     *
+     * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns. (default: 0)
+     * @return cmatrix<float> The mean value for each row or column of the matrix.
+     * @throw std::invalid_argument If the axis is not 0 or 1.
+     * @throw std::invalid_argument If the matrix is not arithmetic.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.mean(0);
+     * > [[1.5], [3.5]]
+     * @endcode
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.mean(1);
+     * > [[2, 3]]
+     * @endcode
+     *
+     * @note The matrix must be of arithmetic type.
+     * @ingroup statistic
+     */
+    cmatrix<float, Layout> mean(const unsigned int &axis = 0) const;
+    /**
+     * @brief Write the mean value for each row (axis: 0) or column (axis: 1) of the matrix in another matrix, without allocating it.
      *
+     * @param out The matrix receiving the mean values: a column for the rows, a row for the columns.
      * @param axis The axis to get the mean value. 0 for the rows, 1 for the columns. (default: 0)
-     * @return cmatrix<float> The mean value for each row or column of the matrix.
      * @throw std::invalid_argument If the axis is not 0 or 1.
      * @throw std::invalid_argument If the matrix is not arithmetic.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the result.
      *
      * @code
      * $ cmatrix<int> m = {{1, 2}, {3, 4}};
-     * $ m.mean(0);
+     * $ cmatrix<float> out(2, 1);
+     * $ m.mean_into(out, 0);
+     * $ out
      * > [[1.5], [3.5]]
      * @endcode
      *
-     * @code
-     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
-     * $ m.mean(1);
-     * > [[2, 3]]
-     * @endcode
-     *
-     * @note The matrix must be of arithmetic type.
+     * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<float> mean(const unsigned int &axis = 0) const;
+    void mean_into(cmatrix<float, Layout> &out, const unsigned int &axis = 0) const;
     /**
      * @brief Get the standard deviation value for each row (axis: 0) or column (axis: 1) of the matrix.
      *
@@ -1727,7 +2801,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<float> std(const unsigned int &axis = 0) const;
+    cmatrix<float, Layout> std(const unsigned int &axis = 0) const;
     /**
      * @brief Get the median value for each row (axis: 0) or column (axis: 1) of the matrix.
      *
@@ -1752,7 +2826,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup statistic
      */
-    cmatrix<T> median(const unsigned int &axis = 0) const;
+    cmatrix<T, Layout> median(const unsigned int &axis = 0) const;
 
     // MATH METHODS
     /**
@@ -1771,7 +2845,7 @@ public:
      *
      * @ingroup math
      */
-    bool near(const cmatrix<T> &val, const T &tolerance = 1e-5) const;
+    bool near(const cmatrix<T, Layout> &val, const T &tolerance = 1e-5) const;
     /**
      * @brief Test if the matrix is near a value.
      *
@@ -1805,7 +2879,7 @@ public:
      *
      * @ingroup math
      */
-    bool nearq(const cmatrix<T> &val, const T &tolerance = 1e-5) const;
+    bool nearq(const cmatrix<T, Layout> &val, const T &tolerance = 1e-5) const;
     /**
      * @brief Test if the matrix is not near a value.
      *
@@ -1836,12 +2910,102 @@ public:
      * > [[19, 22], [43, 50]]
      * @endcode
      *
+     * @note The product is computed by the cache blocked engine of CMatrixGemm.tpp.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup math
+     */
+    cmatrix<T, Layout> matmul(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Get the product with a matrix of the other layout, without copying it.
+     * The transpose of a matrix is in the other layout, so `a.matmul(b.transpose())` reads the buffer of `b`.
+     *
+     * @param m The matrix to multiply.
+     * @tparam M The layout of the matrix `m`.
+     * @return cmatrix<T> The result of the product, in the layout of the matrix.
+     * @throw std::invalid_argument If the number of columns of the matrix is not equal to the number of rows of the matrix `m`.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.matmul(m.transpose());
+     * > [[5, 11], [11, 25]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup math
+     */
+    template <class M>
+    cmatrix<T, Layout> matmul(const cmatrix<T, M> &m) const;
+    /**
+     * @brief Get the product with a view, without copying it.
+     *
+     * @param m The view to multiply.
+     * @return cmatrix<T> The result of the product.
+     * @throw std::invalid_argument If the number of columns of the matrix is not equal to the number of rows of the view `m`.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.matmul(m.view().transpose());
+     * > [[5, 11], [11, 25]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup math
+     */
+    cmatrix<T, Layout> matmul(const cmatrix_view<T> &m) const;
+    /**
+     * @brief Write the product with another matrix in a third matrix, without allocating it.
+     * Computing the products of a loop in the same matrix avoids an allocation per product.
+     *
+     * @param out The matrix receiving the product. Its dimensions must be the dimensions of the product.
+     * @param m The matrix to multiply.
+     * @throw std::invalid_argument If the number of columns of the matrix is not equal to the number of rows of the matrix `m`.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the product.
+     * @throw std::invalid_argument If the matrix `out` shares its cells with an operand.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ cmatrix<int> out(2, 2);
+     * $ m.matmul_into(out, {{5, 6}, {7, 8}});
+     * $ out
+     * > [[19, 22], [43, 50]]
+     * @endcode
+     *
+     * @note The matrix `out` is copied before being written if it shares its buffer with another matrix.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup math
+     */
+    void matmul_into(cmatrix<T, Layout> &out, const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Write the product with a matrix of the other layout in a third matrix, without copying it.
+     *
+     * @param out The matrix receiving the product. Its dimensions must be the dimensions of the product.
+     * @param m The matrix to multiply.
+     * @tparam M The layout of the matrix `m`.
+     * @throw std::invalid_argument If the number of columns of the matrix is not equal to the number of rows of the matrix `m`.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the product.
+     * @throw std::invalid_argument If the matrix `out` shares its cells with an operand.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup math
+     */
+    template <class M>
+    void matmul_into(cmatrix<T, Layout> &out, const cmatrix<T, M> &m) const;
+    /**
+     * @brief Write the product with a view in a matrix, without allocating it.
+     *
+     * @param out The matrix receiving the product. Its dimensions must be the dimensions of the product.
+     * @param m The view to multiply.
+     * @throw std::invalid_argument If the number of columns of the matrix is not equal to the number of rows of the view `m`.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the product.
+     * @throw std::invalid_argument If the matrix `out` shares its cells with an operand.
+     *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> matmul(const cmatrix<T> &m) const;
+    void matmul_into(cmatrix<T, Layout> &out, const cmatrix_view<T> &m) const;
     /**
      * @brief Get the power of the matrix.
+     * Computed by squaring, in O(log n) products written in three buffers allocated once.
      *
      * @param n The power.
      * @return cmatrix<T> The result of the power.
@@ -1856,7 +3020,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> matpow(const unsigned int &n) const;
+    cmatrix<T, Layout> matpow(const unsigned int &n) const;
     /**
      * @brief Get the natural logarithm of the matrix.
      *
@@ -1871,7 +3035,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> log() const;
+    cmatrix<T, Layout> log() const;
     /**
      * @brief Get the log2 of the matrix.
      *
@@ -1886,7 +3050,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> log2() const;
+    cmatrix<T, Layout> log2() const;
     /**
      * @brief Get the log10 of the matrix.
      *
@@ -1901,7 +3065,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> log10() const;
+    cmatrix<T, Layout> log10() const;
     /**
      * @brief Get the exponential of the matrix.
      *
@@ -1916,7 +3080,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> exp() const;
+    cmatrix<T, Layout> exp() const;
     /**
      * @brief Get the square root of the matrix.
      *
@@ -1931,7 +3095,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> sqrt() const;
+    cmatrix<T, Layout> sqrt() const;
     /**
      * @brief Get the absolute value of the matrix.
      *
@@ -1946,7 +3110,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup math
      */
-    cmatrix<T> abs() const;
+    cmatrix<T, Layout> abs() const;
 
     // OTHER METHODS
     /**
@@ -1975,6 +3139,7 @@ public:
     void clear();
     /**
      * @brief Copy the matrix.
+     * The copy shares the buffer of the matrix until one of them is modified, so it costs O(1).
      *
      * @return cmatrix<T> The copied matrix.
      *
@@ -1988,7 +3153,7 @@ public:
      *
      * @ingroup general
      */
-    cmatrix<T> copy() const;
+    cmatrix<T, Layout> copy() const;
     /**
      * @brief Apply a function to each cell of the matrix.
      *
@@ -2000,9 +3165,21 @@ public:
      * > [[2, 3], [4, 5]]
      * @endcode
      *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
     void apply(const std::function<T(T, size_t, size_t)> &f);
+    /**
+     * @brief Apply a callable to each cell of the matrix.
+     * The callable is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value, size_t id_row, size_t id_col) -> T
+     *
+     * @ingroup general
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<void, F, T, size_t, size_t> apply(F &&f);
     /**
      * @brief Apply a function to each cell of the matrix.
      *
@@ -2015,9 +3192,22 @@ public:
      * @endcode
      *
      * @note PARALLELIZED METHOD with OpenMP.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
     void apply(const std::function<T(T)> &f);
+    /**
+     * @brief Apply a callable to each cell of the matrix.
+     * The callable is a template parameter, so it is inlined in the loop and can be vectorized.
+     *
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value) -> T
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup general
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<void, F, T> apply(F &&f);
     /**
      * @brief Apply a function to each cell of the matrix and return the result.
      *
@@ -2030,9 +3220,10 @@ public:
      * > [[2, 3], [4, 5]]
      * @endcode
      *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
-    cmatrix<T> map(const std::function<T(T, size_t, size_t)> &f) const;
+    cmatrix<T, Layout> map(const std::function<T(T, size_t, size_t)> &f) const;
     /**
      * @brief Apply a function to each cell of the matrix and return the result.
      *
@@ -2046,10 +3237,50 @@ public:
      * > [[1.5, 2.5], [3.5, 4.5]]
      * @endcode
      *
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
     template <class U>
-    cmatrix<U> map(const std::function<U(T, size_t, size_t)> &f) const;
+    cmatrix<U, Layout> map(const std::function<U(T, size_t, size_t)> &f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and return the result.
+     * The callable is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value, size_t id_row, size_t id_col) -> T
+     * @return cmatrix<T> The result of the function.
+     *
+     * @ingroup general
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<cmatrix<T, Layout>, F, T, size_t, size_t> map(F &&f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and return the result.
+     * The callable is a template parameter, so it is inlined in the loop.
+     *
+     * @tparam U The type of the matrix.
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value, size_t id_row, size_t id_col) -> U
+     * @return cmatrix<U> The result of the function.
+     *
+     * @ingroup general
+     */
+    template <class U, class F>
+    cmatrix_fn::if_callable_t<cmatrix<U, Layout>, F, T, size_t, size_t> map(F &&f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and write the result in another matrix, without allocating it.
+     *
+     * @tparam U The type of the output matrix.
+     * @tparam F The type of the callable: a lambda, a function object, a function pointer or a std::function.
+     * @param out The matrix receiving the result. Its dimensions must be the dimensions of the matrix.
+     * @param f The function to apply. f(T value, size_t id_row, size_t id_col) -> U
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the matrix.
+     *
+     * @note The matrix `out` can be the matrix itself.
+     * @ingroup general
+     */
+    template <class U, class F>
+    cmatrix_fn::if_callable_t<void, F, T, size_t, size_t> map_into(cmatrix<U, Layout> &out, F &&f) const;
     /**
      * @brief Apply a function to each cell of the matrix and return the result.
      *
@@ -2063,9 +3294,10 @@ public:
      * @endcode
      *
      * @note PARALLELIZED METHOD with OpenMP.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
-    cmatrix<T> map(const std::function<T(T)> &f) const;
+    cmatrix<T, Layout> map(const std::function<T(T)> &f) const;
     /**
      * @brief Apply a function to each cell of the matrix and return the result.
      *
@@ -2080,10 +3312,67 @@ public:
      * @endcode
      *
      * @note PARALLELIZED METHOD with OpenMP.
+     * @note Kept for the std::function arguments. The other callables use the template overload.
      * @ingroup general
      */
     template <class U>
-    cmatrix<U> map(const std::function<U(T)> &f) const;
+    cmatrix<U, Layout> map(const std::function<U(T)> &f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and return the result.
+     * The callable is a template parameter, so it is inlined in the loop and can be vectorized.
+     *
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value) -> T
+     * @return cmatrix<T> The result of the function.
+     *
+     * @code
+     * $ cmatrix<float> m = {{1, 2}, {3, 4}};
+     * $ m.map([](float x) { return x * x; });
+     * > [[1, 4], [9, 16]]
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup general
+     */
+    template <class F>
+    cmatrix_fn::if_callable_t<cmatrix<T, Layout>, F, T> map(F &&f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and return the result.
+     * The callable is a template parameter, so it is inlined in the loop and can be vectorized.
+     *
+     * @tparam U The type of the matrix.
+     * @tparam F The type of the callable: a lambda, a function object or a function pointer.
+     * @param f The function to apply. f(T value) -> U
+     * @return cmatrix<U> The result of the function.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup general
+     */
+    template <class U, class F>
+    cmatrix_fn::if_callable_t<cmatrix<U, Layout>, F, T> map(F &&f) const;
+    /**
+     * @brief Apply a callable to each cell of the matrix and write the result in another matrix, without allocating it.
+     *
+     * @tparam U The type of the output matrix.
+     * @tparam F The type of the callable: a lambda, a function object, a function pointer or a std::function.
+     * @param out The matrix receiving the result. Its dimensions must be the dimensions of the matrix.
+     * @param f The function to apply. f(T value) -> U
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the matrix.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ cmatrix<float> out(2, 2);
+     * $ m.map_into(out, [](int value) { return value + 0.5; });
+     * $ out
+     * > [[1.5, 2.5], [3.5, 4.5]]
+     * @endcode
+     *
+     * @note The matrix `out` can be the matrix itself.
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup general
+     */
+    template <class U, class F>
+    cmatrix_fn::if_callable_t<void, F, T> map_into(cmatrix<U, Layout> &out, F &&f) const;
     /**
      * @brief Fill the matrix with a value.
      *
@@ -2128,7 +3417,7 @@ public:
      * @ingroup general
      */
     template <class U>
-    cmatrix<U> cast() const;
+    cmatrix<U, Layout> cast() const;
     /**
      * @brief Convert the matrix to a matrix of integers.
      *
@@ -2145,7 +3434,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup general
      */
-    cmatrix<int> to_int() const;
+    cmatrix<int, Layout> to_int() const;
     /**
      * @brief Convert the matrix to a matrix of floats.
      *
@@ -2162,7 +3451,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup general
      */
-    cmatrix<float> to_float() const;
+    cmatrix<float, Layout> to_float() const;
     /**
      * @brief Convert the matrix to a matrix of strings.
      *
@@ -2178,7 +3467,7 @@ public:
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup general
      */
-    cmatrix<std::string> to_string() const;
+    cmatrix<std::string, Layout> to_string() const;
 
     // STATIC METHODS
     /**
@@ -2295,7 +3584,7 @@ public:
      *
      * @ingroup static
      */
-    static cmatrix<T> merge(const cmatrix<T> &m1, const cmatrix<T> &m2, const unsigned int &axis = 0);
+    static cmatrix<T, Layout> merge(const cmatrix<T, Layout> &m1, const cmatrix<T, Layout> &m2, const unsigned int &axis = 0);
 
     // OPERATOR METHODS
     /**
@@ -2307,7 +3596,7 @@ public:
      * @note The matrix must be of the same type of the matrix.
      * @ingroup operator
      */
-    cmatrix<T> &operator=(const std::initializer_list<std::initializer_list<T>> &m);
+    cmatrix<T, Layout> &operator=(const std::initializer_list<std::initializer_list<T>> &m);
     /**
      * @brief The assignment operator.
      *
@@ -2317,7 +3606,30 @@ public:
      * @note The matrix must be of the same type of the matrix.
      * @ingroup operator
      */
-    cmatrix<T> &operator=(const cmatrix<T> &m);
+    cmatrix<T, Layout> &operator=(const cmatrix<T, Layout> &m);
+    /**
+     * @brief The move assignment operator. The buffer is taken from the matrix, which becomes empty.
+     * A buffer of an arena closing before the one the matrix was created in is copied. (see CMatrixArena.hpp)
+     *
+     * @param m The matrix to move.
+     * @return cmatrix<T>& The moved matrix.
+     *
+     * @ingroup operator
+     */
+    cmatrix<T, Layout> &operator=(cmatrix<T, Layout> &&m);
+    /**
+     * @brief The assignment operator from an arithmetic expression.
+     * The expression is evaluated in a single pass, without temporary matrix. (see CMatrixExpr.hpp)
+     *
+     * @tparam E The type of the expression.
+     * @param e The expression to evaluate. Can reference the matrix itself.
+     * @return cmatrix<T>& The result of the expression.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     * @ingroup operator
+     */
+    template <class E>
+    cmatrix<T, Layout> &operator=(const cmatrix_expr::expr<E, T> &e);
     /**
      * @brief The equality operator.
      *
@@ -2328,7 +3640,19 @@ public:
      * @note The matrix must be of the same type of the matrix.
      * @ingroup operator
      */
-    bool operator==(const cmatrix<T> &m) const;
+    bool operator==(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief The equality operator with a matrix of the other layout, without copying it.
+     *
+     * @param m The matrix to compare.
+     * @tparam M The layout of the matrix `m`.
+     * @return true If the matrices are equal.
+     * @return false If the matrices are not equal.
+     *
+     * @ingroup operator
+     */
+    template <class M>
+    bool operator==(const cmatrix<T, M> &m) const;
     /**
      * @brief The inequality operator.
      *
@@ -2339,7 +3663,19 @@ public:
      * @note The matrix must be of the same type of the matrix.
      * @ingroup operator
      */
-    bool operator!=(const cmatrix<T> &m) const;
+    bool operator!=(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief The inequality operator with a matrix of the other layout, without copying it.
+     *
+     * @param m The matrix to compare.
+     * @tparam M The layout of the matrix `m`.
+     * @return true If the matrices are not equal.
+     * @return false If the matrices are equal.
+     *
+     * @ingroup operator
+     */
+    template <class M>
+    bool operator!=(const cmatrix<T, M> &m) const;
     /**
      * @brief The equality operator comparing the matrix with a value.
      *
@@ -2366,7 +3702,7 @@ public:
      *
      * @ingroup operator
      */
-    cmatrix<cbool> operator<(const cmatrix<T> &m) const;
+    cmatrix<cbool> operator<(const cmatrix<T, Layout> &m) const;
     /**
      * @brief The strictly less than operator comparing the matrix with a value.
      *
@@ -2384,7 +3720,7 @@ public:
      *
      * @ingroup operator
      */
-    cmatrix<cbool> operator<=(const cmatrix<T> &m) const;
+    cmatrix<cbool> operator<=(const cmatrix<T, Layout> &m) const;
     /**
      * @brief The less than operator comparing the matrix with a value.
      *
@@ -2402,7 +3738,7 @@ public:
      *
      * @ingroup operator
      */
-    cmatrix<cbool> operator>(const cmatrix<T> &m) const;
+    cmatrix<cbool> operator>(const cmatrix<T, Layout> &m) const;
     /**
      * @brief The strictly greater than operator comparing the matrix with a value.
      *
@@ -2420,7 +3756,7 @@ public:
      *
      * @ingroup operator
      */
-    cmatrix<cbool> operator>=(const cmatrix<T> &m) const;
+    cmatrix<cbool> operator>=(const cmatrix<T, Layout> &m) const;
     /**
      * @brief The greater than operator comparing the matrix with a value.
      *
@@ -2440,8 +3776,8 @@ public:
      *
      * @ingroup operator
      */
-    template <class U>
-    friend std::ostream &operator<<(std::ostream &out, const cmatrix<U> &m);
+    template <class U, class M>
+    friend std::ostream &operator<<(std::ostream &out, const cmatrix<U, M> &m);
     /**
      * @brief The not operator.
      *
@@ -2449,218 +3785,172 @@ public:
      *
      * @ingroup operator
      */
-    cmatrix<T> operator!() const;
+    cmatrix<T, Layout> operator!() const;
     /**
-     * @brief The addition operator.
+     * @brief The power operator element-wise.
      *
-     * @param m The matrix to add.
-     * @return cmatrix<T> The sum of the matrices.
+     * @param m The power. Must be a positive integer.
+     * @return cmatrix<T> The powered matrix.
+     * @throw std::invalid_argument If the matrix is not a square matrix.
      *
-     * @note The matrix must be of the same type of the matrix.
-     * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> operator+(const cmatrix<T> &m) const;
+    cmatrix<T, Layout> operator^(const unsigned int &m) const;
     /**
-     * @brief The addition operator.
+     * @brief The addition assignment operator.
      *
-     * @param n The value to add.
-     * @return cmatrix<T> The sum of the matrices.
+     * @param m The matrix to add.
+     * @throw std::invalid_argument If the matrix can't be broadcast to the dimensions of the matrix.
+     * @return cmatrix<T>& The sum of the matrices.
      *
+     * @note The matrix must be of the same type of the matrix. A single row or column is broadcast to each row or column.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> operator+(const T &n) const;
+    cmatrix<T, Layout> &operator+=(const cmatrix<T, Layout> &m);
     /**
-     * @brief The addition operator.
+     * @brief The addition assignment operator.
      *
      * @param n The value to add.
-     * @param m The matrix to add.
-     * @return cmatrix<T> The sum of the matrices.
+     * @return cmatrix<T>& The sum of the matrices.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    template <class U>
-    friend cmatrix<U> operator+(const U &n, const cmatrix<U> &m);
+    cmatrix<T, Layout> &operator+=(const T &n);
     /**
-     * @brief The subtraction operator.
+     * @brief The addition assignment operator with an arithmetic expression.
+     * The expression is evaluated in the matrix, in a single pass.
      *
-     * @param m The matrix to subtract.
-     * @return cmatrix<T> The difference of the matrices.
+     * @tparam E The type of the expression.
+     * @param e The expression to add.
+     * @return cmatrix<T>& The result of the operator.
+     * @throw std::invalid_argument If the expression can't be broadcast to the dimensions of the matrix.
      *
      * @note PARALLELIZED METHOD with OpenMP.
-     * @note The matrix must be of the same type of the matrix.
      * @ingroup operator
      */
-    cmatrix<T> operator-(const cmatrix<T> &m) const;
+    template <class E>
+    cmatrix<T, Layout> &operator+=(const cmatrix_expr::expr<E, T> &e);
     /**
-     * @brief The subtraction operator.
+     * @brief The subtraction assignment operator.
      *
-     * @param val The value to subtract.
-     * @return cmatrix<T> The difference of the matrices.
+     * @param m The matrix to subtract.
+     * @throw std::invalid_argument If the matrix can't be broadcast to the dimensions of the matrix.
+     * @return cmatrix<T>& The difference of the matrices.
      *
+     * @note The matrix must be of the same type of the matrix. A single row or column is broadcast to each row or column.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> operator-(const T &val) const;
+    cmatrix<T, Layout> &operator-=(const cmatrix<T, Layout> &m);
     /**
-     * @brief The subtraction operator.
+     * @brief The subtraction assignment operator.
      *
      * @param n The value to subtract.
-     * @param m The matrix to subtract.
-     * @return cmatrix<T> The difference of the matrices.
+     * @return cmatrix<T>& The difference of the matrices.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    template <class U>
-    friend cmatrix<U> operator-(const U &n, const cmatrix<U> &m);
+    cmatrix<T, Layout> &operator-=(const T &n);
     /**
-     * @brief The negation operator.
+     * @brief The subtraction assignment operator with an arithmetic expression.
+     * The expression is evaluated in the matrix, in a single pass.
      *
-     * @param m The matrix to negate.
-     * @return cmatrix<T> The negated matrix.
+     * @tparam E The type of the expression.
+     * @param e The expression to subtract.
+     * @return cmatrix<T>& The result of the operator.
+     * @throw std::invalid_argument If the expression can't be broadcast to the dimensions of the matrix.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    template <class U>
-    friend cmatrix<U> operator-(const cmatrix<U> &m);
+    template <class E>
+    cmatrix<T, Layout> &operator-=(const cmatrix_expr::expr<E, T> &e);
     /**
-     * @brief The multiplication operator element-wise.
+     * @brief The multiplication assignment operator.
      *
      * @param m The matrix to multiply.
-     * @return cmatrix<T> The product of the matrices.
+     * @throw std::invalid_argument If the matrix can't be broadcast to the dimensions of the matrix.
+     * @return cmatrix<T>& The product of the matrices.
      *
-     * @note The matrix must be of the same type of the matrix.
+     * @note The matrix must be of the same type of the matrix. A single row or column is broadcast to each row or column.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> operator*(const cmatrix<T> &m) const;
-    /**
-     * @brief The multiplication operator.
-     *
-     * @param n The value to multiply.
-     * @return cmatrix<T> The product of the matrices.
-     *
-     * @ingroup operator
-     */
-    cmatrix<T> operator*(const T &n) const;
+    cmatrix<T, Layout> &operator*=(const cmatrix<T, Layout> &m);
     /**
-     * @brief The multiplication operator.
+     * @brief The multiplication assignment operator.
      *
      * @param n The value to multiply.
-     * @param m The matrix to multiply.
-     * @return cmatrix<T> The product of the matrices.
-     *
-     * @ingroup operator
-     */
-    template <class U>
-    friend cmatrix<U> operator*(const U &n, const cmatrix<U> &m);
-    /**
-     * @brief The division operator.
-     *
-     * @param n The value to divide.
-     * @return cmatrix<T> The quotient of the matrices.
-     *
-     * @note PARALLELIZED METHOD with OpenMP.
-     * @ingroup operator
-     */
-    cmatrix<T> operator/(const T &n) const;
-    /**
-     * @brief The power operator element-wise.
-     *
-     * @param m The power. Must be a positive integer.
-     * @return cmatrix<T> The powered matrix.
-     * @throw std::invalid_argument If the matrix is not a square matrix.
-     *
-     * @ingroup operator
-     */
-    cmatrix<T> operator^(const unsigned int &m) const;
-    /**
-     * @brief The addition assignment operator.
-     *
-     * @param m The matrix to add.
-     * @return cmatrix<T>& The sum of the matrices.
-     *
-     * @note The matrix must be of the same type of the matrix.
-     * @note PARALLELIZED METHOD with OpenMP.
-     * @ingroup operator
-     */
-    cmatrix<T> &operator+=(const cmatrix<T> &m);
-    /**
-     * @brief The addition assignment operator.
-     *
-     * @param n The value to add.
-     * @return cmatrix<T>& The sum of the matrices.
-     *
-     * @note PARALLELIZED METHOD with OpenMP.
-     * @ingroup operator
-     */
-    cmatrix<T> &operator+=(const T &n);
-    /**
-     * @brief The subtraction assignment operator.
-     *
-     * @param m The matrix to subtract.
-     * @return cmatrix<T>& The difference of the matrices.
+     * @return cmatrix<T>& The product of the matrices.
      *
-     * @note The matrix must be of the same type of the matrix.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator-=(const cmatrix<T> &m);
+    cmatrix<T, Layout> &operator*=(const T &n);
     /**
-     * @brief The subtraction assignment operator.
+     * @brief The multiplication assignment operator with an arithmetic expression.
+     * The expression is evaluated in the matrix, in a single pass.
      *
-     * @param n The value to subtract.
-     * @return cmatrix<T>& The difference of the matrices.
+     * @tparam E The type of the expression.
+     * @param e The expression to multiply.
+     * @return cmatrix<T>& The result of the operator.
+     * @throw std::invalid_argument If the expression can't be broadcast to the dimensions of the matrix.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator-=(const T &n);
+    template <class E>
+    cmatrix<T, Layout> &operator*=(const cmatrix_expr::expr<E, T> &e);
     /**
-     * @brief The multiplication assignment operator.
+     * @brief The division assignment operator.
      *
-     * @param m The matrix to multiply.
-     * @return cmatrix<T>& The product of the matrices.
+     * @param n The value to divide.
+     * @return cmatrix<T>& The quotient of the matrices.
      *
-     * @note The matrix must be of the same type of the matrix.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator*=(const cmatrix<T> &m);
+    cmatrix<T, Layout> &operator/=(const T &n);
     /**
-     * @brief The multiplication assignment operator.
+     * @brief The division assignment operator element-wise.
      *
-     * @param n The value to multiply.
-     * @return cmatrix<T>& The product of the matrices.
+     * @param m The matrix to divide by.
+     * @return cmatrix<T>& The quotient of the matrices.
+     * @throw std::invalid_argument If the matrix can't be broadcast to the dimensions of the matrix.
      *
+     * @note The matrix must be of the same type of the matrix. A single row or column is broadcast to each row or column.
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator*=(const T &n);
+    cmatrix<T, Layout> &operator/=(const cmatrix<T, Layout> &m);
     /**
-     * @brief The division assignment operator.
+     * @brief The division assignment operator with an arithmetic expression.
+     * The expression is evaluated in the matrix, in a single pass.
      *
-     * @param n The value to divide.
-     * @return cmatrix<T>& The quotient of the matrices.
+     * @tparam E The type of the expression.
+     * @param e The expression to divide by.
+     * @return cmatrix<T>& The result of the operator.
+     * @throw std::invalid_argument If the expression can't be broadcast to the dimensions of the matrix.
      *
      * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator/=(const T &n);
+    template <class E>
+    cmatrix<T, Layout> &operator/=(const cmatrix_expr::expr<E, T> &e);
     /**
      * @brief The power assignment operator.
+     * Raise each cell to the power, in the buffer of the matrix.
      *
      * @param m The power. Must be a positive integer.
      * @return cmatrix<T>& The powered matrix.
-     * @throw std::invalid_argument If the matrix is not a square matrix.
      *
+     * @note PARALLELIZED METHOD with OpenMP.
      * @ingroup operator
      */
-    cmatrix<T> &operator^=(const unsigned int &m);
+    cmatrix<T, Layout> &operator^=(const unsigned int &m);
 };
 
 #endif // CMATRIX_H
@@ -2668,10 +3958,15 @@ public:
 #include "../src/CMatrix.tpp"
 #include "../src/CMatrixCheck.tpp"
 #include "../src/CMatrixConstructor.tpp"
+#include "../src/CMatrixFixed.tpp"
+#include "../src/CMatrixGemm.tpp"
+#include "../src/CMatrixTranspose.tpp"
 #include "../src/CMatrixGetter.tpp"
 #include "../src/CMatrixManipulation.tpp"
 #include "../src/CMatrixMath.tpp"
 #include "../src/CMatrixOperator.tpp"
 #include "../src/CMatrixSetter.tpp"
 #include "../src/CMatrixStatic.tpp"
+#include "../src/CMatrixSparse.tpp"
 #include "../src/CMatrixStatistics.tpp"
+#include "../src/CMatrixView.tpp"
@@ -0,0 +1,418 @@
+/**
+ * @file CMatrixArena.hpp
+ * @brief This file contains the allocator of the buffers of the matrices, and the scoped arena it draws from.
+ *
+ * @details The buffers of the matrices are allocated by cmatrix_alloc::allocator. Outside of an arena, it
+ *          allocates from the resource set by cmatrix_alloc::set_resource, operator new by default. Inside the
+ *          scope of a cmatrix_arena, the matrices created by the thread draw their buffers from the blocks of
+ *          the arena, and the blocks are released at once at the end of the scope. So the temporary matrices
+ *          of a computation neither fragment the heap nor contend on its lock. The arenas are local to each thread.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_ARENA_HPP
+#define CMATRIX_ARENA_HPP
+
+// INCLUDES
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+/**
+ * @brief If not 0, the buffers are aligned on 64 bytes and the rows of the float and double matrices are
+ * padded to a multiple of 64 bytes, so each row starts on a cache line. Define it before including
+ * CMatrix.hpp to enable it.
+ */
+#ifndef CMATRIX_ALIGNED_ROWS
+#define CMATRIX_ALIGNED_ROWS 0
+#endif
+
+/**
+ * @brief A scope in which the buffers of the matrices created by the thread are drawn from blocks of memory,
+ * released at once when the scope ends. The scopes can be nested: the innermost one is used.
+ * The matrices created before the scope keep allocating from the heap, and a buffer of the arena given to
+ * one of them is copied in the heap.
+ *
+ * @warning A matrix created in the scope must not outlive it, nor grow after it. The buffers freed in
+ *          the scope are not reused before its end.
+ *
+ * @code
+ * $ {
+ * $     cmatrix_arena scope;
+ * $     cmatrix<float> m = a.matmul(b) + c; // The temporaries are drawn from the arena
+ * $     result = m.sum_all();
+ * $ } // The blocks are released
+ * @endcode
+ */
+class cmatrix_arena
+{
+private:
+    // ATTRIBUTES
+    std::vector<char *> m_blocks;
+    char *m_ptr = nullptr;
+    char *m_end = nullptr;
+    size_t m_block_size;
+    size_t m_used = 0;
+    cmatrix_arena *m_previous;
+
+    /**
+     * @brief The innermost arena of the thread.
+     */
+    static cmatrix_arena *&__current()
+    {
+        static thread_local cmatrix_arena *current = nullptr;
+        return current;
+    }
+
+    /**
+     * @brief Get the first address aligned on `align` from `p`.
+     */
+    static char *__align(char *p, const size_t &align)
+    {
+        return reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(p) + align - 1) & ~(std::uintptr_t(align) - 1));
+    }
+
+public:
+    // CONSTRUCTORS
+    /**
+     * @brief Open a scope. The matrices created by the thread until its end draw from this arena.
+     *
+     * @param block_size The size in bytes of the blocks of memory. The bigger buffers get their own block. (default: 1 MiB)
+     */
+    explicit cmatrix_arena(const size_t &block_size = size_t(1) << 20)
+        : m_block_size(block_size), m_previous(__current())
+    {
+        __current() = this;
+    }
+
+    cmatrix_arena(const cmatrix_arena &) = delete;
+    cmatrix_arena &operator=(const cmatrix_arena &) = delete;
+
+    /**
+     * @brief Close the scope and release all the blocks.
+     */
+    ~cmatrix_arena()
+    {
+        __current() = m_previous;
+
+        for (char *block : m_blocks)
+            ::operator delete(block);
+    }
+
+    /**
+     * @brief Get the innermost arena of the calling thread.
+     *
+     * @return cmatrix_arena* The arena, or nullptr outside of any arena.
+     */
+    static cmatrix_arena *current() { return __current(); }
+
+    /**
+     * @brief Check if the memory of an arena lives as long as the scope of another arena.
+     *
+     * @param a The arena, or nullptr for the heap.
+     * @param b The arena, or nullptr for the heap.
+     * @return bool True if a is the heap, b itself, or an arena enclosing b.
+     */
+    static bool outlives(const cmatrix_arena *a, const cmatrix_arena *b)
+    {
+        for (; b != nullptr; b = b->m_previous)
+            if (b == a)
+                return true;
+
+        return a == nullptr;
+    }
+
+    /**
+     * @brief Get the number of bytes drawn from the arena.
+     *
+     * @return size_t The number of bytes.
+     */
+    size_t used() const { return m_used; }
+
+    /**
+     * @brief Get the number of blocks allocated by the arena.
+     *
+     * @return size_t The number of blocks.
+     */
+    size_t blocks() const { return m_blocks.size(); }
+
+    /**
+     * @brief Draw memory from the current block, or from a new block if it is full.
+     *
+     * @param bytes The number of bytes.
+     * @param align The alignment, a power of 2.
+     * @return void* The memory, valid until the end of the scope.
+     */
+    void *allocate(const size_t &bytes, const size_t &align)
+    {
+        char *p = __align(m_ptr, align);
+
+        if (m_ptr == nullptr or p + bytes > m_end)
+        {
+            // A bigger buffer gets its own block, so the current block stays in use
+            if (bytes + align > m_block_size)
+            {
+                m_blocks.push_back(static_cast<char *>(::operator new(bytes + align)));
+                m_used += bytes;
+                return __align(m_blocks.back(), align);
+            }
+
+            m_blocks.push_back(static_cast<char *>(::operator new(m_block_size)));
+            m_ptr = m_blocks.back();
+            m_end = m_ptr + m_block_size;
+            p = __align(m_ptr, align);
+        }
+
+        m_ptr = p + bytes;
+        m_used += bytes;
+
+        return p;
+    }
+};
+
+namespace cmatrix_alloc
+{
+    /**
+     * @brief The alignment of the buffers: a cache line with CMATRIX_ALIGNED_ROWS.
+     */
+    const size_t ALIGNMENT = CMATRIX_ALIGNED_ROWS ? 64 : alignof(std::max_align_t);
+
+    /**
+     * @brief The memory of the buffers allocated outside of an arena.
+     * Derive from it to allocate the buffers of the matrices with the allocator of an application.
+     * The threads of the parallel loops allocate too, so the resource must be thread-safe.
+     *
+     * @code
+     * $ struct counting : cmatrix_alloc::resource
+     * $ {
+     * $     std::atomic<size_t> bytes{0};
+     * $     void *allocate(const size_t &n) { bytes += n; return ::operator new(n); }
+     * $     void deallocate(void *p, const size_t &n) { bytes -= n; ::operator delete(p); }
+     * $ };
+     * @endcode
+     */
+    class resource
+    {
+    public:
+        virtual ~resource() {}
+
+        /**
+         * @brief Allocate memory aligned like operator new does.
+         *
+         * @param bytes The number of bytes.
+         * @return void* The memory.
+         * @throw std::bad_alloc If the memory can't be allocated.
+         */
+        virtual void *allocate(const size_t &bytes) = 0;
+
+        /**
+         * @brief Release memory returned by allocate().
+         *
+         * @param p The memory.
+         * @param bytes The number of bytes given to allocate().
+         */
+        virtual void deallocate(void *p, const size_t &bytes) = 0;
+    };
+
+    /**
+     * @brief The default resource: operator new and operator delete.
+     */
+    class new_resource : public resource
+    {
+    public:
+        void *allocate(const size_t &bytes) { return ::operator new(bytes); }
+        void deallocate(void *p, const size_t &) { ::operator delete(p); }
+    };
+
+    /**
+     * @brief The resource used when the program sets none.
+     */
+    inline resource *__heap()
+    {
+        static new_resource heap;
+        return &heap;
+    }
+
+    /**
+     * @brief The resource of the program, read by the threads allocating outside of an arena.
+     */
+    inline std::atomic<resource *> &__resource()
+    {
+        static std::atomic<resource *> current{__heap()};
+        return current;
+    }
+
+    /**
+     * @brief Get the resource the buffers are allocated from outside of an arena.
+     *
+     * @return resource* The resource.
+     */
+    inline resource *get_resource() { return __resource().load(); }
+
+    /**
+     * @brief Set the resource the buffers are allocated from outside of an arena, for the whole program.
+     * Each buffer is released by the resource that allocated it, so the resource must outlive its buffers.
+     *
+     * @param r The resource, or nullptr for operator new.
+     * @return resource* The previous resource.
+     *
+     * @code
+     * $ counting memory;
+     * $ cmatrix_alloc::set_resource(&memory);
+     * @endcode
+     */
+    inline resource *set_resource(resource *r)
+    {
+        return __resource().exchange(r ? r : __heap());
+    }
+
+    /**
+     * @brief Stored before each buffer: where the buffer comes from.
+     */
+    struct header
+    {
+        void *raw;
+        cmatrix_arena *arena;
+        resource *source;
+    };
+
+    /**
+     * @brief The distance between the header and the buffer, keeping the buffer aligned.
+     */
+    const size_t OFFSET = (sizeof(header) + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+
+    /**
+     * @brief Direct the allocations of the thread to the arena in which a matrix was created, while the
+     * matrix writes its buffer. So a matrix created before a scope keeps allocating from the heap in it.
+     * The arena is used only while it is open in the thread, and the heap otherwise.
+     */
+    class target
+    {
+    private:
+        // ATTRIBUTES
+        bool m_previous_active;
+        cmatrix_arena *m_previous;
+
+        static bool &__active()
+        {
+            static thread_local bool active = false;
+            return active;
+        }
+
+        static cmatrix_arena *&__arena()
+        {
+            static thread_local cmatrix_arena *arena = nullptr;
+            return arena;
+        }
+
+    public:
+        /**
+         * @brief Direct the allocations to an arena until the end of the scope.
+         *
+         * @param arena The arena in which the matrix was created, or nullptr for the heap.
+         */
+        explicit target(cmatrix_arena *arena)
+            : m_previous_active(__active()), m_previous(__arena())
+        {
+            __active() = true;
+            __arena() = cmatrix_arena::outlives(arena, cmatrix_arena::current()) ? arena : nullptr;
+        }
+
+        target(const target &) = delete;
+        target &operator=(const target &) = delete;
+
+        ~target()
+        {
+            __active() = m_previous_active;
+            __arena() = m_previous;
+        }
+
+        /**
+         * @brief Get the arena the allocator draws from.
+         *
+         * @return cmatrix_arena* The arena of the matrix writing its buffer, else the innermost arena of the thread.
+         */
+        static cmatrix_arena *arena() { return __active() ? __arena() : cmatrix_arena::current(); }
+    };
+
+    /**
+     * @brief The allocator of the buffers of the matrices.
+     * Draws from the arena given by cmatrix_alloc::target if any, and from the resource of the program otherwise.
+     * The buffers drawn from an arena are released with it, so their deallocation does nothing.
+     *
+     * @tparam T The type of the cells.
+     */
+    template <class T>
+    struct allocator
+    {
+        typedef T value_type;
+
+        allocator() noexcept {}
+
+        template <class U>
+        allocator(const allocator<U> &) noexcept {}
+
+        T *allocate(const size_t &n)
+        {
+            const size_t bytes = n * sizeof(T) + OFFSET;
+            cmatrix_arena *arena = target::arena();
+            resource *source = nullptr;
+            char *raw, *base;
+
+            if (arena)
+                raw = base = static_cast<char *>(arena->allocate(bytes, ALIGNMENT));
+
+            // The resources only align on std::max_align_t: take some more bytes to align the buffer
+            else
+            {
+                source = get_resource();
+                raw = static_cast<char *>(source->allocate(bytes + __extra()));
+                base = reinterpret_cast<char *>((reinterpret_cast<std::uintptr_t>(raw) + ALIGNMENT - 1) & ~(std::uintptr_t(ALIGNMENT) - 1));
+            }
+
+            // The header is just before the buffer
+            reinterpret_cast<header *>(base + OFFSET - sizeof(header))->raw = raw;
+            reinterpret_cast<header *>(base + OFFSET - sizeof(header))->arena = arena;
+            reinterpret_cast<header *>(base + OFFSET - sizeof(header))->source = source;
+
+            return reinterpret_cast<T *>(base + OFFSET);
+        }
+
+        void deallocate(T *p, const size_t &n)
+        {
+            const header *h = reinterpret_cast<const header *>(reinterpret_cast<char *>(p) - sizeof(header));
+
+            // The buffer goes back to the resource that allocated it, even if another one was set since
+            if (h->arena == nullptr)
+                h->source->deallocate(h->raw, n * sizeof(T) + OFFSET + __extra());
+        }
+
+    private:
+        /**
+         * @brief The bytes taken in addition to the buffer, to align it on ALIGNMENT.
+         */
+        static size_t __extra() { return ALIGNMENT > alignof(std::max_align_t) ? ALIGNMENT : 0; }
+    };
+
+    template <class T, class U>
+    bool operator==(const allocator<T> &, const allocator<U> &) { return true; }
+
+    template <class T, class U>
+    bool operator!=(const allocator<T> &, const allocator<U> &) { return false; }
+
+    /**
+     * @brief The std::vector allocating with the allocator of the matrices.
+     */
+    template <class T>
+    struct vector
+    {
+        typedef std::vector<T, allocator<T>> type;
+    };
+}
+
+#endif // CMATRIX_ARENA_HPP
@@ -0,0 +1,394 @@
+/**
+ * @file CMatrixBits.hpp
+ * @brief This file contains the bit-packed buffer of the boolean matrices.
+ *
+ * @details A cmatrix<cbool> stores 64 cells per word instead of a byte per cell. The cells are read
+ *          and written through a proxy, like std::vector<bool>, and the masks operations process
+ *          the buffer a word at a time.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_BITS_HPP
+#define CMATRIX_BITS_HPP
+
+// INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "CBool.hpp"
+#include "CMatrixArena.hpp"
+#include "CMatrixSimd.hpp"
+
+namespace cmatrix_bits
+{
+    /**
+     * @brief The number of cells stored in a word.
+     */
+    static const size_t WORD = 64;
+
+    /**
+     * @brief Get the number of words needed to store cells.
+     *
+     * @param n The number of cells.
+     * @return size_t The number of words.
+     */
+    inline size_t word_count(const size_t &n)
+    {
+        return (n + WORD - 1) / WORD;
+    }
+
+    /**
+     * @brief Get the mask of the cells stored in the last word.
+     *
+     * @param n The number of cells.
+     * @return std::uint64_t The mask of the used bits of the last word.
+     */
+    inline std::uint64_t tail_mask(const size_t &n)
+    {
+        return n % WORD == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (n % WORD)) - 1;
+    }
+
+    // ==================================================
+    // WORD OPERATORS
+
+    /**
+     * @brief The arithmetic operators of cbool applied to 64 cells at once.
+     * The sum is a logical or, the product a logical and, and the difference is true when the cells differ.
+     *
+     * @tparam O The operator.
+     */
+    template <cmatrix_simd::op O>
+    struct word_op;
+
+    template <>
+    struct word_op<cmatrix_simd::ADD>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a | b; }
+    };
+
+    template <>
+    struct word_op<cmatrix_simd::SUB>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a ^ b; }
+    };
+
+    template <>
+    struct word_op<cmatrix_simd::MUL>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a & b; }
+    };
+
+    /**
+     * @brief The comparisons of cbool applied to 64 cells at once.
+     * The bits beyond the last cell must be cleared by the caller.
+     *
+     * @tparam C The comparison.
+     */
+    template <cmatrix_simd::cmp C>
+    struct word_cmp;
+
+    template <>
+    struct word_cmp<cmatrix_simd::EQ>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return ~(a ^ b); }
+    };
+
+    template <>
+    struct word_cmp<cmatrix_simd::NEQ>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a ^ b; }
+    };
+
+    template <>
+    struct word_cmp<cmatrix_simd::LT>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return ~a & b; }
+    };
+
+    template <>
+    struct word_cmp<cmatrix_simd::LEQ>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return ~a | b; }
+    };
+
+    template <>
+    struct word_cmp<cmatrix_simd::GT>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a & ~b; }
+    };
+
+    template <>
+    struct word_cmp<cmatrix_simd::GEQ>
+    {
+        static std::uint64_t apply(const std::uint64_t &a, const std::uint64_t &b) { return a | ~b; }
+    };
+
+    // ==================================================
+    // REFERENCE AND ITERATORS
+
+    /**
+     * @brief A reference to a cell of a bit-packed buffer.
+     *
+     * @note The bit is written with an atomic operation, so the threads of a parallel loop can write
+     *       the cells of the same word.
+     */
+    class reference
+    {
+    private:
+        std::uint64_t *m_word;
+        std::uint64_t m_bit;
+
+    public:
+        reference(std::uint64_t *word, const std::uint64_t &bit) : m_word(word), m_bit(bit) {}
+
+        operator bool() const { return __atomic_load_n(m_word, __ATOMIC_RELAXED) & m_bit; }
+
+        reference &operator=(const cbool &val)
+        {
+            if (val)
+                __atomic_fetch_or(m_word, m_bit, __ATOMIC_RELAXED);
+            else
+                __atomic_fetch_and(m_word, ~m_bit, __ATOMIC_RELAXED);
+
+            return *this;
+        }
+
+        reference &operator=(const reference &r) { return *this = cbool(bool(r)); }
+    };
+
+    /**
+     * @brief A random access iterator on the cells of a bit-packed buffer.
+     *
+     * @tparam Const True to iterate on a constant buffer. The cells are then returned by value.
+     */
+    template <bool Const>
+    class basic_iterator
+    {
+    private:
+        typedef typename std::conditional<Const, const std::uint64_t, std::uint64_t>::type word_type;
+
+        word_type *m_words;
+        size_t m_pos;
+
+        cbool __deref(std::true_type) const { return cbool((m_words[m_pos / WORD] >> (m_pos % WORD)) & 1); }
+        cmatrix_bits::reference __deref(std::false_type) const { return cmatrix_bits::reference(m_words + m_pos / WORD, std::uint64_t(1) << (m_pos % WORD)); }
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef cbool value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef void pointer;
+        typedef typename std::conditional<Const, cbool, cmatrix_bits::reference>::type reference;
+
+        basic_iterator() : m_words(nullptr), m_pos(0) {}
+        basic_iterator(word_type *words, const size_t &pos) : m_words(words), m_pos(pos) {}
+
+        size_t pos() const { return m_pos; }
+
+        reference operator*() const { return __deref(std::integral_constant<bool, Const>()); }
+        reference operator[](const difference_type &n) const { return *(*this + n); }
+
+        basic_iterator &operator++() { m_pos++; return *this; }
+        basic_iterator &operator--() { m_pos--; return *this; }
+        basic_iterator operator++(int) { basic_iterator it = *this; m_pos++; return it; }
+        basic_iterator operator--(int) { basic_iterator it = *this; m_pos--; return it; }
+        basic_iterator &operator+=(const difference_type &n) { m_pos += n; return *this; }
+        basic_iterator &operator-=(const difference_type &n) { m_pos -= n; return *this; }
+        basic_iterator operator+(const difference_type &n) const { return basic_iterator(m_words, m_pos + n); }
+        basic_iterator operator-(const difference_type &n) const { return basic_iterator(m_words, m_pos - n); }
+        difference_type operator-(const basic_iterator &it) const { return difference_type(m_pos) - difference_type(it.m_pos); }
+
+        bool operator==(const basic_iterator &it) const { return m_pos == it.m_pos; }
+        bool operator!=(const basic_iterator &it) const { return m_pos != it.m_pos; }
+        bool operator<(const basic_iterator &it) const { return m_pos < it.m_pos; }
+        bool operator<=(const basic_iterator &it) const { return m_pos <= it.m_pos; }
+        bool operator>(const basic_iterator &it) const { return m_pos > it.m_pos; }
+        bool operator>=(const basic_iterator &it) const { return m_pos >= it.m_pos; }
+    };
+
+    // ==================================================
+    // BUFFER
+
+    /**
+     * @brief A buffer of cbool storing 64 cells per word.
+     * Provides the part of the std::vector interface used by cmatrix, and the access to the words.
+     *
+     * @note The bits beyond the last cell are always cleared, so the words can be counted and compared directly.
+     */
+    class buffer
+    {
+    private:
+        cmatrix_alloc::vector<std::uint64_t>::type m_words;
+        size_t m_size = 0;
+
+        /**
+         * @brief Resize the buffer, keeping the first cells.
+         *
+         * @param n The new number of cells.
+         */
+        void __resize(const size_t &n)
+        {
+            m_words.resize(word_count(n), 0);
+            m_size = n;
+            clear_tail();
+        }
+
+        bool __get(const size_t &i) const { return (m_words[i / WORD] >> (i % WORD)) & 1; }
+
+        void __set(const size_t &i, const bool &val)
+        {
+            const std::uint64_t bit = std::uint64_t(1) << (i % WORD);
+            m_words[i / WORD] = val ? m_words[i / WORD] | bit : m_words[i / WORD] & ~bit;
+        }
+
+    public:
+        typedef cbool value_type;
+        typedef cmatrix_bits::reference reference;
+        typedef cbool const_reference;
+        typedef basic_iterator<false> iterator;
+        typedef basic_iterator<true> const_iterator;
+
+        size_t size() const { return m_size; }
+
+        /**
+         * @brief Replace the content of the buffer.
+         *
+         * @param n The number of cells.
+         * @param val The value of the cells.
+         */
+        void assign(const size_t &n, const cbool &val)
+        {
+            m_words.assign(word_count(n), val ? ~std::uint64_t(0) : 0);
+            m_size = n;
+            clear_tail();
+        }
+
+        reference operator[](const size_t &i) { return reference(m_words.data() + i / WORD, std::uint64_t(1) << (i % WORD)); }
+        const_reference operator[](const size_t &i) const { return cbool(__get(i)); }
+
+        iterator begin() { return iterator(m_words.data(), 0); }
+        iterator end() { return iterator(m_words.data(), m_size); }
+        const_iterator begin() const { return const_iterator(m_words.data(), 0); }
+        const_iterator end() const { return const_iterator(m_words.data(), m_size); }
+
+        /**
+         * @brief Insert cells before a position, shifting the following cells.
+         *
+         * @param pos The position of the first inserted cell.
+         * @param first The first cell to insert.
+         * @param last The end of the cells to insert.
+         */
+        template <class InputIt>
+        void insert(const iterator &pos, InputIt first, InputIt last)
+        {
+            const size_t at = pos.pos();
+            const size_t n = std::distance(first, last);
+            const size_t old_size = m_size;
+
+            __resize(m_size + n);
+
+            // Shift the following cells from the end, then copy the new ones
+            for (size_t i = old_size; i > at; i--)
+                __set(i - 1 + n, __get(i - 1));
+
+            for (size_t i = at; first != last; ++first, i++)
+                __set(i, bool(*first));
+        }
+
+        /**
+         * @brief Remove cells, shifting the following cells.
+         *
+         * @param first The first cell to remove.
+         * @param last The end of the cells to remove.
+         */
+        void erase(const iterator &first, const iterator &last)
+        {
+            const size_t from = first.pos();
+            const size_t n = last.pos() - from;
+
+            for (size_t i = from; i + n < m_size; i++)
+                __set(i, __get(i + n));
+
+            __resize(m_size - n);
+        }
+
+        /**
+         * @brief Get the words of the buffer. The cell i is the bit i % 64 of the word i / 64.
+         *
+         * @return std::uint64_t* The words.
+         */
+        std::uint64_t *words() { return m_words.data(); }
+        const std::uint64_t *words() const { return m_words.data(); }
+
+        /**
+         * @brief Get the number of words of the buffer.
+         *
+         * @return size_t The number of words.
+         */
+        size_t nwords() const { return m_words.size(); }
+
+        /**
+         * @brief Clear the bits beyond the last cell. To call after writing the words directly.
+         */
+        void clear_tail()
+        {
+            if (not m_words.empty())
+                m_words.back() &= tail_mask(m_size);
+        }
+
+        /**
+         * @brief Count the true cells with a population count of each word.
+         *
+         * @return size_t The number of true cells.
+         */
+        size_t count() const
+        {
+            size_t n = 0;
+
+            for (size_t w = 0; w < m_words.size(); w++)
+                n += __builtin_popcountll(m_words[w]);
+
+            return n;
+        }
+
+        /**
+         * @brief Call a function with the position of each true cell, in increasing order.
+         * The false cells are skipped a word at a time.
+         *
+         * @param f The function to call. f(size_t pos)
+         */
+        template <class F>
+        void for_each_set(F f) const
+        {
+            for (size_t w = 0; w < m_words.size(); w++)
+                for (std::uint64_t bits = m_words[w]; bits != 0; bits &= bits - 1)
+                    f(w * WORD + __builtin_ctzll(bits));
+        }
+    };
+
+    /**
+     * @brief The buffer of a matrix. The cbool matrices are bit-packed, the others use a std::vector.
+     * Both allocate with the allocator of the matrices. (see CMatrixArena.hpp)
+     *
+     * @tparam T The type of the cells.
+     */
+    template <class T>
+    struct storage
+    {
+        typedef typename cmatrix_alloc::vector<T>::type type;
+    };
+
+    template <>
+    struct storage<cbool>
+    {
+        typedef buffer type;
+    };
+}
+
+#endif // CMATRIX_BITS_HPP
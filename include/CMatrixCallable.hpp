@@ -0,0 +1,38 @@
+/**
+ * @file CMatrixCallable.hpp
+ * @brief This file contains the traits of the callables taken by the methods of the matrices.
+ *
+ * @details The methods applying a function to each cell (map, apply, mask, find, ...) take any callable
+ *          as a template parameter, so the call is inlined in the loop instead of going through the
+ *          indirect call of a std::function. These traits select the overload matching the arguments
+ *          the callable accepts.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_CALLABLE_HPP
+#define CMATRIX_CALLABLE_HPP
+
+// INCLUDES
+#include <type_traits>
+#include <utility>
+
+namespace cmatrix_fn
+{
+    /**
+     * @brief The type returned by a callable of type F called with arguments of types Args.
+     * Not defined if F can't be called with these arguments, so the overload using it is discarded.
+     */
+    template <class F, class... Args>
+    using result_t = decltype(std::declval<F &>()(std::declval<Args>()...));
+
+    /**
+     * @brief The type R, only defined if a callable of type F can be called with arguments of types Args.
+     */
+    template <class R, class F, class... Args>
+    using if_callable_t = typename std::conditional<true, R, result_t<F, Args...>>::type;
+}
+
+#endif // CMATRIX_CALLABLE_HPP
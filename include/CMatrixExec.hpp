@@ -0,0 +1,407 @@
+/**
+ * @file CMatrixExec.hpp
+ * @brief This file contains the execution backends of the parallel loops: serial, OpenMP or a thread pool.
+ *
+ * @details Every parallel loop of the library goes through cmatrix_exec::for_each, which asks the cost
+ *          model of CMatrixParallel.hpp for a number of threads, and runs the loop with the backend in use:
+ *          - cmatrix_exec::serial runs it on the calling thread.
+ *          - cmatrix_exec::openmp forks a team of OpenMP threads. The default with OpenMP.
+ *          - cmatrix_exec::thread_pool submits it to a pool of the application, so the library shares the
+ *            threads of the application instead of adding its own ones.
+ *          The backend can be set for the whole program, or for the calls made in a scope by a thread.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_EXEC_HPP
+#define CMATRIX_EXEC_HPP
+
+// INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CMatrixParallel.hpp"
+
+namespace cmatrix_exec
+{
+    /**
+     * @brief A pool of threads running the tasks of the parallel loops.
+     * Derive from it to submit the tasks to the thread pool or task scheduler of an application.
+     *
+     * @code
+     * $ struct tbb_pool : cmatrix_exec::pool
+     * $ {
+     * $     size_t size() const { return tbb::this_task_arena::max_concurrency(); }
+     * $     void run(const size_t &tasks, const std::function<void(size_t)> &task) { tbb::parallel_for(size_t(0), tasks, task); }
+     * $ };
+     * @endcode
+     */
+    class pool
+    {
+    public:
+        virtual ~pool() {}
+
+        /**
+         * @brief Get the number of threads of the pool: the number of tasks a loop is divided in.
+         *
+         * @return size_t The number of threads.
+         */
+        virtual size_t size() const = 0;
+
+        /**
+         * @brief Call task(0), task(1), ..., task(tasks - 1) on the threads of the pool, and return once
+         * they are all done. The calls of a task of the library never call run() again.
+         *
+         * @param tasks The number of tasks.
+         * @param task The task.
+         * @throw The first exception thrown by the tasks.
+         */
+        virtual void run(const size_t &tasks, const std::function<void(size_t)> &task) = 0;
+    };
+
+    /**
+     * @brief A pool of std::thread. The calling thread runs tasks too, so a pool of n threads starts n - 1 threads.
+     * The loops submitted by several threads run one after the other.
+     */
+    class worker_pool : public pool
+    {
+    private:
+        // ATTRIBUTES
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::mutex m_batch;
+        std::condition_variable m_wake;
+        std::condition_variable m_done;
+        const std::function<void(size_t)> *m_task = nullptr;
+        size_t m_tasks = 0;
+        size_t m_next = 0;
+        size_t m_pending = 0;
+        std::exception_ptr m_error;
+        bool m_stop = false;
+
+        /**
+         * @brief Run the tasks not taken yet, one by one. Called with the lock held.
+         */
+        void __take(std::unique_lock<std::mutex> &lock)
+        {
+            while (m_next < m_tasks)
+            {
+                const size_t i = m_next++;
+                const std::function<void(size_t)> &task = *m_task;
+                lock.unlock();
+
+                try
+                {
+                    task(i);
+                    lock.lock();
+                }
+                catch (...)
+                {
+                    lock.lock();
+
+                    if (not m_error)
+                        m_error = std::current_exception();
+                }
+
+                if (--m_pending == 0)
+                    m_done.notify_all();
+            }
+        }
+
+        /**
+         * @brief The loop of a thread of the pool: wait for tasks until the pool is destroyed.
+         */
+        void __work()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            while (true)
+            {
+                m_wake.wait(lock, [this]
+                            { return m_stop or m_next < m_tasks; });
+
+                if (m_stop)
+                    return;
+
+                __take(lock);
+            }
+        }
+
+    public:
+        /**
+         * @brief Start the threads of the pool.
+         *
+         * @param threads The number of threads, counting the calling thread. (default: the number of cores)
+         */
+        explicit worker_pool(const size_t &threads = std::max(std::thread::hardware_concurrency(), 1u))
+        {
+            for (size_t i = 1; i < threads; i++)
+                m_workers.emplace_back(&worker_pool::__work, this);
+        }
+
+        worker_pool(const worker_pool &) = delete;
+        worker_pool &operator=(const worker_pool &) = delete;
+
+        /**
+         * @brief Stop and join the threads of the pool.
+         */
+        ~worker_pool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+
+            m_wake.notify_all();
+
+            for (std::thread &worker : m_workers)
+                worker.join();
+        }
+
+        size_t size() const { return m_workers.size() + 1; }
+
+        void run(const size_t &tasks, const std::function<void(size_t)> &task)
+        {
+            std::lock_guard<std::mutex> batch(m_batch);
+            std::unique_lock<std::mutex> lock(m_mutex);
+
+            m_task = &task;
+            m_tasks = tasks;
+            m_next = 0;
+            m_pending = tasks;
+            m_error = nullptr;
+            m_wake.notify_all();
+
+            // The calling thread takes tasks too, then waits for the tasks taken by the pool
+            __take(lock);
+            m_done.wait(lock, [this]
+                        { return m_pending == 0; });
+
+            m_task = nullptr;
+            m_tasks = m_next = 0;
+            const std::exception_ptr error = m_error;
+            lock.unlock();
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+    // ==================================================
+    // POLICIES
+
+    /**
+     * @brief The backends of the parallel loops.
+     */
+    enum backend
+    {
+        SERIAL,
+        OPENMP,
+        THREAD_POOL
+    };
+
+    /**
+     * @brief The execution policy of the parallel loops: a backend, and the pool of the THREAD_POOL backend.
+     */
+    struct policy
+    {
+        backend type;
+        pool *workers;
+
+        policy(const backend &type, pool *workers) : type(type), workers(workers) {}
+    };
+
+    /**
+     * @brief Run the loops on the calling thread.
+     */
+    inline policy serial() { return policy(SERIAL, nullptr); }
+
+    /**
+     * @brief Run the loops on a team of OpenMP threads. Without OpenMP, the loops run on the calling thread.
+     */
+    inline policy openmp() { return policy(OPENMP, nullptr); }
+
+    /**
+     * @brief Run the loops on the threads of a pool. The pool must outlive the use of the policy.
+     *
+     * @param p The pool.
+     */
+    inline policy thread_pool(pool &p) { return policy(THREAD_POOL, &p); }
+
+    /**
+     * @brief The policy of the program, read by the threads outside of any scope.
+     */
+    struct global_policy
+    {
+#ifdef _OPENMP
+        std::atomic<backend> type{OPENMP};
+#else
+        std::atomic<backend> type{SERIAL};
+#endif
+        std::atomic<pool *> workers{nullptr};
+    };
+
+    inline global_policy &__global()
+    {
+        static global_policy global;
+        return global;
+    }
+
+    /**
+     * @brief The policy of the innermost scope of the thread, or nullptr outside of any scope.
+     */
+    inline const policy *&__current()
+    {
+        static thread_local const policy *current = nullptr;
+        return current;
+    }
+
+    /**
+     * @brief Get the execution policy of the parallel loops called by the thread.
+     *
+     * @return policy The policy.
+     */
+    inline policy current()
+    {
+        if (__current())
+            return *__current();
+
+        return policy(__global().type.load(), __global().workers.load());
+    }
+
+    /**
+     * @brief Set the execution policy of the parallel loops for the whole program.
+     * The scopes opened before keep their policy.
+     *
+     * @param p The policy.
+     *
+     * @code
+     * $ cmatrix_exec::worker_pool workers(4);
+     * $ cmatrix_exec::set_policy(cmatrix_exec::thread_pool(workers));
+     * @endcode
+     */
+    inline void set_policy(const policy &p)
+    {
+        // The pool is stored first, so a thread reading the backend finds its pool
+        __global().workers.store(p.workers);
+        __global().type.store(p.type);
+    }
+
+    /**
+     * @brief A scope in which the parallel loops called by the thread use their own execution policy.
+     * The scopes can be nested: the innermost one is used.
+     *
+     * @code
+     * $ {
+     * $     cmatrix_exec::scope exec(cmatrix_exec::thread_pool(app_pool));
+     * $     c = a.matmul(b); // Runs on the threads of app_pool
+     * $ }
+     * @endcode
+     */
+    class scope
+    {
+    private:
+        // ATTRIBUTES
+        policy m_policy;
+        const policy *m_previous;
+
+    public:
+        /**
+         * @brief Open a scope.
+         *
+         * @param p The policy of the parallel loops of the scope.
+         */
+        explicit scope(const policy &p) : m_policy(p), m_previous(__current())
+        {
+            __current() = &m_policy;
+        }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+        /**
+         * @brief Close the scope: the thread uses the policy of the enclosing scope again.
+         */
+        ~scope() { __current() = m_previous; }
+    };
+
+    // ==================================================
+    // LOOPS
+
+    /**
+     * @brief Mark the thread as running a task of a parallel loop, so the loops it calls run on it.
+     */
+    struct task_guard
+    {
+        bool m_previous;
+
+        task_guard() : m_previous(cmatrix_parallel::__in_task()) { cmatrix_parallel::__in_task() = true; }
+        ~task_guard() { cmatrix_parallel::__in_task() = m_previous; }
+    };
+
+    /**
+     * @brief Call f(0), f(1), ..., f(n - 1) with the execution policy of the thread, on as many threads as
+     * the cost model gives to the work. The calls must be independent.
+     *
+     * @param k The kind of the operation.
+     * @param work The estimated work of the loop, in units of work of the kind. (see CMatrixParallel.hpp)
+     * @param n The number of iterations.
+     * @param f The body of the loop, called with the index of the iteration.
+     * @param balanced If true, the iterations have unequal costs: the threads take them by small batches.
+     *
+     * @code
+     * $ cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, cells, rows, [&](size_t r) { ... });
+     * @endcode
+     */
+    template <class F>
+    void for_each(const cmatrix_parallel::kind &k, const size_t &work, const size_t &n, const F &f, const bool &balanced = false)
+    {
+        const policy p = current();
+        const int max = p.type == SERIAL ? 1 : p.type == THREAD_POOL ? cmatrix_parallel::threads(p.workers->size()) : cmatrix_parallel::threads();
+        const int team = n > 1 ? cmatrix_parallel::team(k, work, max) : 1;
+
+        if (team <= 1)
+        {
+            for (size_t i = 0; i < n; i++)
+                f(i);
+        }
+
+        // Each task runs a range of iterations
+        else if (p.type == THREAD_POOL)
+        {
+            const size_t tasks = std::min(n, size_t(team) * (balanced ? 4 : 1));
+
+            p.workers->run(tasks, [&](size_t t)
+                           {
+                               task_guard guard;
+
+                               for (size_t i = n * t / tasks; i < n * (t + 1) / tasks; i++)
+                                   f(i); });
+        }
+
+        else if (balanced)
+        {
+            #pragma omp parallel for schedule(dynamic) num_threads(team)
+            for (size_t i = 0; i < n; i++)
+                f(i);
+        }
+
+        else
+        {
+            #pragma omp parallel for num_threads(team)
+            for (size_t i = 0; i < n; i++)
+                f(i);
+        }
+    }
+}
+
+#endif // CMATRIX_EXEC_HPP
@@ -0,0 +1,983 @@
+/**
+ * @file CMatrixExpr.hpp
+ * @brief This file contains the expression templates of the elementwise arithmetic operators.
+ *
+ * @details The operators +, -, * and / don't compute a matrix. They return a lightweight node which
+ *          references its operands. The whole expression is evaluated in a single pass when it is assigned
+ *          to a cmatrix, or reduced by sum_all, min_all or max_all. So `m += (a * 2) - 1` reads each
+ *          operand once and doesn't allocate any temporary matrix.
+ *
+ *          The operands are broadcast like in NumPy: along each axis, their dimensions must be equal or
+ *          one of them must be 1. So `m - m.mean(1)` subtracts the mean of each column from each row. The
+ *          single row or column is read in place, with a step of 0, without being copied.
+ *
+ * @warning A node references the matrices of the expression. Don't keep it after the end of the
+ *          statement if one of these matrices is a temporary. Use `eval()` or assign it to a cmatrix.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_EXPR_HPP
+#define CMATRIX_EXPR_HPP
+
+// INCLUDES
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "CBool.hpp"
+#include "CMatrixLayout.hpp"
+#include "CMatrixSimd.hpp"
+
+namespace cmatrix_expr
+{
+    /**
+     * @brief Check if two operands have the same dimensions.
+     *
+     * @throw std::invalid_argument If the dimensions are not the same.
+     */
+    inline void check_size(const size_t &height, const size_t &width, const size_t &other_height, const size_t &other_width)
+    {
+        if (height != other_height or width != other_width)
+            throw std::invalid_argument("The matrices must have the same dimension. Expected: " +
+                                        std::to_string(height) +
+                                        "x" +
+                                        std::to_string(width) +
+                                        ". Actual: " +
+                                        std::to_string(other_height) +
+                                        "x" +
+                                        std::to_string(other_width));
+    }
+
+    /**
+     * @brief Get the dimensions of the result of an operator between two operands, broadcasting their single rows or columns.
+     * Along each axis, the dimensions must be equal or one of them must be 1.
+     *
+     * @return std::pair<size_t, size_t> The height and the width of the result.
+     * @throw std::invalid_argument If the dimensions can't be broadcast together.
+     */
+    inline std::pair<size_t, size_t> broadcast_size(const size_t &height, const size_t &width, const size_t &other_height, const size_t &other_width)
+    {
+        if ((height != other_height and height != 1 and other_height != 1) or
+            (width != other_width and width != 1 and other_width != 1))
+            throw std::invalid_argument("The matrices must have the same dimension, or a single row or column to broadcast. Expected: " +
+                                        std::to_string(height) +
+                                        "x" +
+                                        std::to_string(width) +
+                                        ". Actual: " +
+                                        std::to_string(other_height) +
+                                        "x" +
+                                        std::to_string(other_width));
+
+        return std::pair<size_t, size_t>(height == 1 ? other_height : height, width == 1 ? other_width : width);
+    }
+
+    // ==================================================
+    // NODES
+
+    /**
+     * @brief The base class of the nodes of an expression.
+     * Each node E defines height(), width(), the value of a cell with operator()(row, col), and overlaps(begin, end)
+     * telling if the expression can't be evaluated in a buffer because it reads it.
+     *
+     * @tparam E The type of the node.
+     * @tparam T The type of the cells.
+     */
+    template <class E, class T>
+    struct expr
+    {
+        typedef T value_type;
+
+        /** A value is broadcast to every cell of the other operand. */
+        static const bool broadcast = false;
+
+        const E &self() const { return static_cast<const E &>(*this); }
+
+        /**
+         * @brief Evaluate the expression in a new matrix.
+         *
+         * @return cmatrix<T> The result of the expression.
+         */
+        cmatrix<T> eval() const { return cmatrix<T>(*this); }
+
+        /**
+         * @brief Compute the sum of the cells of the expression, without evaluating it in a matrix.
+         *
+         * @param zero The zero value of the type. (default: T())
+         * @return T The sum of the cells.
+         */
+        T sum_all(const T &zero = T()) const
+        {
+            T sum = zero;
+
+            for (size_t r = 0; r < self().height(); r++)
+                for (size_t c = 0; c < self().width(); c++)
+                    sum += self()(r, c);
+
+            return sum;
+        }
+
+        /**
+         * @brief Get the minimum cell of the expression, without evaluating it in a matrix.
+         *
+         * @return T The minimum cell.
+         * @throw std::invalid_argument If the expression has no cell.
+         */
+        T min_all() const
+        {
+            if (self().height() == 0 or self().width() == 0)
+                throw std::invalid_argument("The matrix must have at least one element.");
+
+            T min = self()(0, 0);
+
+            for (size_t r = 0; r < self().height(); r++)
+                for (size_t c = 0; c < self().width(); c++)
+                {
+                    const T val = self()(r, c);
+
+                    if (val < min)
+                        min = val;
+                }
+
+            return min;
+        }
+
+        /**
+         * @brief Get the maximum cell of the expression, without evaluating it in a matrix.
+         *
+         * @return T The maximum cell.
+         * @throw std::invalid_argument If the expression has no cell.
+         */
+        T max_all() const
+        {
+            if (self().height() == 0 or self().width() == 0)
+                throw std::invalid_argument("The matrix must have at least one element.");
+
+            T max = self()(0, 0);
+
+            for (size_t r = 0; r < self().height(); r++)
+                for (size_t c = 0; c < self().width(); c++)
+                {
+                    const T val = self()(r, c);
+
+                    if (val > max)
+                        max = val;
+                }
+
+            return max;
+        }
+
+        /**
+         * @brief Check if the result of the expression is equal to a matrix.
+         */
+        bool operator==(const cmatrix<T> &m) const { return eval() == m; }
+        bool operator!=(const cmatrix<T> &m) const { return eval() != m; }
+
+        template <class Layout>
+        bool operator==(const cmatrix<T, Layout> &m) const { return eval() == m; }
+        template <class Layout>
+        bool operator!=(const cmatrix<T, Layout> &m) const { return eval() != m; }
+    };
+
+    template <class E, class T>
+    const bool expr<E, T>::broadcast;
+
+    /**
+     * @brief A matrix operand. References the buffer of the matrix.
+     * A broadcast row has a stride of 0, and a broadcast column a step of 0.
+     *
+     * @tparam T The type of the cells.
+     */
+    template <class T>
+    struct leaf : expr<leaf<T>, T>
+    {
+        const T *m_data;
+        size_t m_height;
+        size_t m_width;
+        size_t m_stride;
+        size_t m_step;
+
+        template <class Layout>
+        explicit leaf(const cmatrix<T, Layout> &m)
+            : m_data(m.matrix.data()), m_height(m.m_height), m_width(m.m_width),
+              m_stride(Layout::row_step(m.m_stride)), m_step(Layout::col_step(m.m_stride)) {}
+
+        size_t height() const { return m_height; }
+        size_t width() const { return m_width; }
+        const T &operator()(const size_t &row, const size_t &col) const { return m_data[row * m_stride + col * m_step]; }
+
+        /**
+         * @brief Repeat the single row or column of the operand to the dimensions of the result.
+         */
+        void broadcast_to(const size_t &height, const size_t &width)
+        {
+            if (m_height != height)
+                m_stride = 0;
+
+            if (m_width != width)
+                m_step = 0;
+
+            m_height = height;
+            m_width = width;
+        }
+
+        /**
+         * @brief Check if the buffer is read in the order of the buffer of the result, padding included.
+         * Otherwise, the operand is broadcast or stored in another layout.
+         *
+         * @param stride The distance between two rows of the result.
+         * @param step The distance between two columns of the result.
+         */
+        bool contiguous(const size_t &stride, const size_t &step) const { return m_step == step and m_stride == stride; }
+
+        /**
+         * @brief Check if the operand reads cells of a buffer, so the expression can't be evaluated in this buffer.
+         * A matrix operand is the result itself, read at the cell being computed, or has its own buffer:
+         * a buffer shared with the result is copied before the result is written. (see CMatrixShared.hpp)
+         */
+        bool overlaps(const T *, const T *) const { return false; }
+    };
+
+    /**
+     * @brief A boolean matrix operand. References the words of the bit-packed buffer.
+     * The constructor is defined in CMatrixOperator.tpp, once the matrix is defined.
+     */
+    template <>
+    struct leaf<cbool> : expr<leaf<cbool>, cbool>
+    {
+        const std::uint64_t *m_words;
+        size_t m_height;
+        size_t m_width;
+        size_t m_stride;
+        size_t m_step;
+
+        explicit leaf(const cmatrix<cbool> &m);
+
+        size_t height() const { return m_height; }
+        size_t width() const { return m_width; }
+
+        cbool operator()(const size_t &row, const size_t &col) const
+        {
+            const size_t i = row * m_stride + col * m_step;
+            return cbool((m_words[i / 64] >> (i % 64)) & 1);
+        }
+
+        void broadcast_to(const size_t &height, const size_t &width)
+        {
+            if (m_height != height)
+                m_stride = 0;
+
+            if (m_width != width)
+                m_step = 0;
+
+            m_height = height;
+            m_width = width;
+        }
+
+        bool contiguous(const size_t &stride, const size_t &step) const { return m_step == step and m_stride == stride; }
+        bool overlaps(const cbool *, const cbool *) const { return false; }
+    };
+
+    /**
+     * @brief A value operand, broadcast to every cell of the other operand.
+     *
+     * @tparam T The type of the value.
+     */
+    template <class T>
+    struct scalar : expr<scalar<T>, T>
+    {
+        static const bool broadcast = true;
+        T m_value;
+
+        explicit scalar(const T &value) : m_value(value) {}
+
+        size_t height() const { return 0; }
+        size_t width() const { return 0; }
+        const T &operator()(const size_t &, const size_t &) const { return m_value; }
+        void broadcast_to(const size_t &, const size_t &) {}
+        bool overlaps(const T *, const T *) const { return false; }
+    };
+
+    template <class T>
+    const bool scalar<T>::broadcast;
+
+    /**
+     * @brief An arithmetic operator between two operands.
+     * The dimensions are checked when the node is created, so the errors are raised by the operator.
+     * An operand with a single row or column is broadcast to the dimensions of the other one.
+     *
+     * @tparam O The operator.
+     * @tparam L The left operand.
+     * @tparam R The right operand.
+     */
+    template <cmatrix_simd::op O, class L, class R>
+    struct binary : expr<binary<O, L, R>, typename L::value_type>
+    {
+        typedef typename L::value_type value_type;
+
+        L m_lhs;
+        R m_rhs;
+        size_t m_height;
+        size_t m_width;
+
+        binary(const L &lhs, const R &rhs) : m_lhs(lhs), m_rhs(rhs)
+        {
+            if (not L::broadcast and not R::broadcast)
+            {
+                const std::pair<size_t, size_t> size = broadcast_size(lhs.height(), lhs.width(), rhs.height(), rhs.width());
+                broadcast_to(size.first, size.second);
+            }
+
+            else
+            {
+                m_height = L::broadcast ? rhs.height() : lhs.height();
+                m_width = L::broadcast ? rhs.width() : lhs.width();
+            }
+        }
+
+        size_t height() const { return m_height; }
+        size_t width() const { return m_width; }
+
+        void broadcast_to(const size_t &height, const size_t &width)
+        {
+            m_lhs.broadcast_to(height, width);
+            m_rhs.broadcast_to(height, width);
+            m_height = height;
+            m_width = width;
+        }
+        const L &lhs() const { return m_lhs; }
+        const R &rhs() const { return m_rhs; }
+
+        /**
+         * @brief Check if an operand reads cells of a buffer, so the expression can't be evaluated in this buffer.
+         */
+        bool overlaps(const value_type *begin, const value_type *end) const { return m_lhs.overlaps(begin, end) or m_rhs.overlaps(begin, end); }
+
+        value_type operator()(const size_t &row, const size_t &col) const
+        {
+            return cmatrix_simd::scalar_op<O>::apply(m_lhs(row, col), m_rhs(row, col));
+        }
+    };
+
+    // ==================================================
+    // OPERANDS
+
+    /**
+     * @brief Convert the operands of an operator to a node.
+     * Only defined for the matrices and the nodes, so the operators don't match the other types.
+     *
+     * @tparam A The type of the operand.
+     */
+    template <class A>
+    struct operand
+    {
+        static const bool value = false;
+    };
+
+    template <class T, class Layout>
+    struct operand<cmatrix<T, Layout>>
+    {
+        static const bool value = true;
+        typedef T value_type;
+        typedef leaf<T> type;
+        static type wrap(const cmatrix<T, Layout> &m) { return type(m); }
+    };
+
+    template <class T>
+    struct operand<leaf<T>>
+    {
+        static const bool value = true;
+        typedef T value_type;
+        typedef leaf<T> type;
+        static const type &wrap(const type &e) { return e; }
+    };
+
+    template <cmatrix_simd::op O, class L, class R>
+    struct operand<binary<O, L, R>>
+    {
+        static const bool value = true;
+        typedef typename L::value_type value_type;
+        typedef binary<O, L, R> type;
+        static const type &wrap(const type &e) { return e; }
+    };
+
+    /**
+     * @brief The node of an operator between two operands of the same type.
+     */
+    template <cmatrix_simd::op O, class A, class B, bool = operand<A>::value and operand<B>::value>
+    struct binary_of
+    {
+    };
+
+    template <cmatrix_simd::op O, class A, class B>
+    struct binary_of<O, A, B, true>
+        : std::enable_if<std::is_same<typename operand<A>::value_type, typename operand<B>::value_type>::value,
+                         binary<O, typename operand<A>::type, typename operand<B>::type>>
+    {
+    };
+
+    /**
+     * @brief The node of an operator between an operand and a value.
+     */
+    template <cmatrix_simd::op O, class A, bool = operand<A>::value>
+    struct scalar_of
+    {
+    };
+
+    template <cmatrix_simd::op O, class A>
+    struct scalar_of<O, A, true>
+    {
+        typedef binary<O, typename operand<A>::type, scalar<typename operand<A>::value_type>> type;
+    };
+
+    /**
+     * @brief The type of the cells of a matrix, in a context where it is not deduced.
+     */
+    template <class T>
+    using value_t = typename operand<cmatrix<T>>::value_type;
+
+    /**
+     * @brief The result of an operator between an expiring matrix and an operand of the same type.
+     */
+    template <class T, class Layout, class B, bool = operand<B>::value>
+    struct reuse_of
+    {
+    };
+
+    template <class T, class Layout, class B>
+    struct reuse_of<T, Layout, B, true>
+        : std::enable_if<std::is_same<T, typename operand<B>::value_type>::value, cmatrix<T, Layout>>
+    {
+    };
+
+    template <class E, class T>
+    std::ostream &operator<<(std::ostream &out, const expr<E, T> &e)
+    {
+        return out << e.eval();
+    }
+}
+
+// ==================================================
+// ARITHMETIC OPERATORS
+
+/**
+ * @brief The addition operator element-wise.
+ *
+ * @param a The matrix or the expression to add.
+ * @param b The matrix or the expression to add.
+ * @return The node of the sum, evaluated when assigned to a cmatrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @note The operands must be of the same type.
+ * @ingroup operator
+ */
+template <class A, class B>
+typename cmatrix_expr::binary_of<cmatrix_simd::ADD, A, B>::type operator+(const A &a, const B &b)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::operand<B>::wrap(b)};
+}
+
+/**
+ * @brief The addition operator.
+ *
+ * @param a The matrix or the expression.
+ * @param n The value to add to each cell.
+ * @return The node of the sum, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::ADD, A>::type operator+(const A &a, const typename cmatrix_expr::operand<A>::value_type &n)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>(n)};
+}
+
+/**
+ * @brief The addition operator.
+ *
+ * @param n The value to add to each cell.
+ * @param a The matrix or the expression.
+ * @return The node of the sum, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::ADD, A>::type operator+(const typename cmatrix_expr::operand<A>::value_type &n, const A &a)
+{
+    return a + n;
+}
+
+/**
+ * @brief The subtraction operator element-wise.
+ *
+ * @param a The matrix or the expression.
+ * @param b The matrix or the expression to subtract.
+ * @return The node of the difference, evaluated when assigned to a cmatrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @note The operands must be of the same type.
+ * @ingroup operator
+ */
+template <class A, class B>
+typename cmatrix_expr::binary_of<cmatrix_simd::SUB, A, B>::type operator-(const A &a, const B &b)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::operand<B>::wrap(b)};
+}
+
+/**
+ * @brief The subtraction operator.
+ *
+ * @param a The matrix or the expression.
+ * @param n The value to subtract from each cell.
+ * @return The node of the difference, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::SUB, A>::type operator-(const A &a, const typename cmatrix_expr::operand<A>::value_type &n)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>(n)};
+}
+
+/**
+ * @brief The subtraction operator.
+ *
+ * @param n The value.
+ * @param a The matrix or the expression to subtract from the value.
+ * @return The node of the difference, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+cmatrix_expr::binary<cmatrix_simd::SUB, cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>, typename cmatrix_expr::operand<A>::type>
+operator-(const typename cmatrix_expr::operand<A>::value_type &n, const A &a)
+{
+    return {cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>(n), cmatrix_expr::operand<A>::wrap(a)};
+}
+
+/**
+ * @brief The negation operator.
+ *
+ * @param a The matrix or the expression to negate.
+ * @return The node of the negation, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::MUL, A>::type operator-(const A &a)
+{
+    return a * typename cmatrix_expr::operand<A>::value_type(-1);
+}
+
+/**
+ * @brief The multiplication operator element-wise.
+ *
+ * @param a The matrix or the expression to multiply.
+ * @param b The matrix or the expression to multiply.
+ * @return The node of the product, evaluated when assigned to a cmatrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @note The operands must be of the same type.
+ * @ingroup operator
+ */
+template <class A, class B>
+typename cmatrix_expr::binary_of<cmatrix_simd::MUL, A, B>::type operator*(const A &a, const B &b)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::operand<B>::wrap(b)};
+}
+
+/**
+ * @brief The multiplication operator.
+ *
+ * @param a The matrix or the expression.
+ * @param n The value to multiply each cell by.
+ * @return The node of the product, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::MUL, A>::type operator*(const A &a, const typename cmatrix_expr::operand<A>::value_type &n)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>(n)};
+}
+
+/**
+ * @brief The multiplication operator.
+ *
+ * @param n The value to multiply each cell by.
+ * @param a The matrix or the expression.
+ * @return The node of the product, evaluated when assigned to a cmatrix.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::MUL, A>::type operator*(const typename cmatrix_expr::operand<A>::value_type &n, const A &a)
+{
+    return a * n;
+}
+
+/**
+ * @brief The division operator.
+ *
+ * @param a The matrix or the expression.
+ * @param n The value to divide each cell by.
+ * @return The node of the quotient, evaluated when assigned to a cmatrix.
+ * @throw std::invalid_argument If the value is 0.
+ *
+ * @ingroup operator
+ */
+template <class A>
+typename cmatrix_expr::scalar_of<cmatrix_simd::DIV, A>::type operator/(const A &a, const typename cmatrix_expr::operand<A>::value_type &n)
+{
+    if (n == 0)
+        throw std::invalid_argument("The value must be different from 0.");
+
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::scalar<typename cmatrix_expr::operand<A>::value_type>(n)};
+}
+
+/**
+ * @brief The division operator element-wise.
+ *
+ * @param a The matrix or the expression.
+ * @param b The matrix or the expression to divide by.
+ * @return The node of the quotient, evaluated when assigned to a cmatrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @code
+ * $ cmatrix<double> m = {{2, 4}, {6, 8}};
+ * $ m / m.max(1);
+ * > [[0.33, 0.5], [1, 1]]
+ * @endcode
+ *
+ * @note The operands must be of the same type. The cells of b are not checked: dividing by 0 follows the rules of the type.
+ * @ingroup operator
+ */
+template <class A, class B>
+typename cmatrix_expr::binary_of<cmatrix_simd::DIV, A, B>::type operator/(const A &a, const B &b)
+{
+    return {cmatrix_expr::operand<A>::wrap(a), cmatrix_expr::operand<B>::wrap(b)};
+}
+
+// ==================================================
+// EXPIRING MATRIX OPERATORS
+// When an operand is a temporary matrix, the result is computed in its buffer
+// and the matrix is returned, instead of building a node referencing it.
+// If the temporary matrix is broadcast to larger dimensions, the result is computed in a new buffer.
+
+/**
+ * @brief The addition operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param b The matrix or the expression to add.
+ * @return cmatrix<T, Layout> The sum, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator+(cmatrix<T, Layout> &&a, const B &b)
+{
+    a = a + b;
+    return std::move(a);
+}
+
+/**
+ * @brief The addition operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param b The matrix or the expression to add.
+ * @param a The expiring matrix.
+ * @return cmatrix<T, Layout> The sum, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator+(const B &b, cmatrix<T, Layout> &&a)
+{
+    a = b + a;
+    return std::move(a);
+}
+
+/**
+ * @brief The addition operator with two expiring matrices. The result is computed in the buffer of the first one.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class M>
+cmatrix<T, Layout> operator+(cmatrix<T, Layout> &&a, cmatrix<T, M> &&b)
+{
+    a = a + b;
+    return std::move(a);
+}
+
+/**
+ * @brief The addition operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param n The value to add to each cell.
+ * @return cmatrix<T, Layout> The sum, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator+(cmatrix<T, Layout> &&a, const cmatrix_expr::value_t<T> &n)
+{
+    a += n;
+    return std::move(a);
+}
+
+/**
+ * @brief The addition operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param n The value to add to each cell.
+ * @param a The expiring matrix.
+ * @return cmatrix<T, Layout> The sum, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator+(const cmatrix_expr::value_t<T> &n, cmatrix<T, Layout> &&a)
+{
+    a = n + a;
+    return std::move(a);
+}
+
+/**
+ * @brief The subtraction operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param b The matrix or the expression to subtract.
+ * @return cmatrix<T, Layout> The difference, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator-(cmatrix<T, Layout> &&a, const B &b)
+{
+    a = a - b;
+    return std::move(a);
+}
+
+/**
+ * @brief The subtraction operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param b The matrix or the expression.
+ * @param a The expiring matrix to subtract.
+ * @return cmatrix<T, Layout> The difference, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator-(const B &b, cmatrix<T, Layout> &&a)
+{
+    a = b - a;
+    return std::move(a);
+}
+
+/**
+ * @brief The subtraction operator with two expiring matrices. The result is computed in the buffer of the first one.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class M>
+cmatrix<T, Layout> operator-(cmatrix<T, Layout> &&a, cmatrix<T, M> &&b)
+{
+    a = a - b;
+    return std::move(a);
+}
+
+/**
+ * @brief The subtraction operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param n The value to subtract from each cell.
+ * @return cmatrix<T, Layout> The difference, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator-(cmatrix<T, Layout> &&a, const cmatrix_expr::value_t<T> &n)
+{
+    a -= n;
+    return std::move(a);
+}
+
+/**
+ * @brief The subtraction operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param n The value.
+ * @param a The expiring matrix to subtract from the value.
+ * @return cmatrix<T, Layout> The difference, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator-(const cmatrix_expr::value_t<T> &n, cmatrix<T, Layout> &&a)
+{
+    a = n - a;
+    return std::move(a);
+}
+
+/**
+ * @brief The negation operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix to negate.
+ * @return cmatrix<T, Layout> The negated matrix, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator-(cmatrix<T, Layout> &&a)
+{
+    a *= T(-1);
+    return std::move(a);
+}
+
+/**
+ * @brief The multiplication operator element-wise with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param b The matrix or the expression to multiply.
+ * @return cmatrix<T, Layout> The product, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator*(cmatrix<T, Layout> &&a, const B &b)
+{
+    a = a * b;
+    return std::move(a);
+}
+
+/**
+ * @brief The multiplication operator element-wise with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param b The matrix or the expression to multiply.
+ * @param a The expiring matrix.
+ * @return cmatrix<T, Layout> The product, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator*(const B &b, cmatrix<T, Layout> &&a)
+{
+    a = b * a;
+    return std::move(a);
+}
+
+/**
+ * @brief The multiplication operator element-wise with two expiring matrices. The result is computed in the buffer of the first one.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class M>
+cmatrix<T, Layout> operator*(cmatrix<T, Layout> &&a, cmatrix<T, M> &&b)
+{
+    a = a * b;
+    return std::move(a);
+}
+
+/**
+ * @brief The multiplication operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param n The value to multiply each cell by.
+ * @return cmatrix<T, Layout> The product, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator*(cmatrix<T, Layout> &&a, const cmatrix_expr::value_t<T> &n)
+{
+    a *= n;
+    return std::move(a);
+}
+
+/**
+ * @brief The multiplication operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param n The value to multiply each cell by.
+ * @param a The expiring matrix.
+ * @return cmatrix<T, Layout> The product, in the buffer of the expiring matrix.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator*(const cmatrix_expr::value_t<T> &n, cmatrix<T, Layout> &&a)
+{
+    a = n * a;
+    return std::move(a);
+}
+
+/**
+ * @brief The division operator with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param n The value to divide each cell by.
+ * @return cmatrix<T, Layout> The quotient, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the value is 0.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout>
+cmatrix<T, Layout> operator/(cmatrix<T, Layout> &&a, const cmatrix_expr::value_t<T> &n)
+{
+    a /= n;
+    return std::move(a);
+}
+
+/**
+ * @brief The division operator element-wise with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param a The expiring matrix.
+ * @param b The matrix or the expression to divide by.
+ * @return cmatrix<T, Layout> The quotient, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator/(cmatrix<T, Layout> &&a, const B &b)
+{
+    a = a / b;
+    return std::move(a);
+}
+
+/**
+ * @brief The division operator element-wise with an expiring matrix. The result is computed in its buffer.
+ *
+ * @param b The matrix or the expression.
+ * @param a The expiring matrix to divide by.
+ * @return cmatrix<T, Layout> The quotient, in the buffer of the expiring matrix.
+ * @throw std::invalid_argument If the dimensions of the operands can't be broadcast together.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class B>
+typename cmatrix_expr::reuse_of<T, Layout, B>::type operator/(const B &b, cmatrix<T, Layout> &&a)
+{
+    a = b / a;
+    return std::move(a);
+}
+
+/**
+ * @brief The division operator element-wise with two expiring matrices. The result is computed in the buffer of the first one.
+ *
+ * @ingroup operator
+ */
+template <class T, class Layout, class M>
+cmatrix<T, Layout> operator/(cmatrix<T, Layout> &&a, cmatrix<T, M> &&b)
+{
+    a = a / b;
+    return std::move(a);
+}
+
+#endif // CMATRIX_EXPR_HPP
@@ -0,0 +1,433 @@
+/**
+ * @file CMatrixFixed.hpp
+ * @brief This file contains the definition of the cmatrix_fixed class.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_FIXED_HPP
+#define CMATRIX_FIXED_HPP
+
+// INCLUDES
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "CMatrixLayout.hpp"
+
+namespace cmatrix_unroll
+{
+    /**
+     * @brief Above this number of iterations, the loops are not unrolled.
+     */
+    const size_t MAX_UNROLL = 64;
+
+    /**
+     * @brief Call f(I), f(I + 1), ..., f(N - 1), one call after the other without a loop.
+     */
+    template <size_t I, size_t N>
+    struct step
+    {
+        template <class F>
+        static void run(const F &f)
+        {
+            f(I);
+            step<I + 1, N>::run(f);
+        }
+    };
+
+    template <size_t N>
+    struct step<N, N>
+    {
+        template <class F>
+        static void run(const F &) {}
+    };
+
+    /**
+     * @brief Call f(0), f(1), ..., f(N - 1). The calls are unrolled at compile time if N is small.
+     *
+     * @tparam N The number of iterations.
+     */
+    template <size_t N, bool Unroll = (N <= MAX_UNROLL)>
+    struct loop
+    {
+        template <class F>
+        static void run(const F &f)
+        {
+            for (size_t i = 0; i < N; i++)
+                f(i);
+        }
+    };
+
+    template <size_t N>
+    struct loop<N, true>
+    {
+        template <class F>
+        static void run(const F &f) { step<0, N>::run(f); }
+    };
+}
+
+/**
+ * @brief A matrix whose dimensions are known at compile time.
+ *
+ * @details The cells are stored in the object, so creating or copying a small matrix doesn't allocate,
+ *          and the loops on its cells have a constant number of iterations, unrolled at compile time.
+ *          The methods have the names of the methods of cmatrix, so a generic code works with both.
+ *
+ * @tparam T The type of elements in the matrix.
+ * @tparam R The number of rows.
+ * @tparam C The number of columns.
+ */
+template <class T, size_t R, size_t C>
+class cmatrix_fixed
+{
+    static_assert(R > 0 and C > 0, "The dimensions of a fixed-size matrix must be positive.");
+
+private:
+    // ATTRIBUTES
+    T m_data[R * C];
+
+    // The products read the cells of the matrices of other dimensions
+    template <class U, size_t H, size_t W>
+    friend class cmatrix_fixed;
+
+    // CHECK METHODS
+    /**
+     * @brief Check if the index is a valid row index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid row index.
+     */
+    static void __check_valid_row_id(const size_t &n);
+    /**
+     * @brief Check if the index is a valid column index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid column index.
+     */
+    static void __check_valid_col_id(const size_t &n);
+
+public:
+    // CONSTRUCTORS
+    /**
+     * @brief Construct a matrix filled with the value of the default constructor of the type T.
+     */
+    constexpr cmatrix_fixed() : m_data() {}
+    /**
+     * @brief Construct a matrix filled with a value.
+     *
+     * @param val The value of the cells.
+     */
+    explicit cmatrix_fixed(const T &val);
+    /**
+     * @brief Construct a matrix from a list of rows.
+     *
+     * @param m The rows of the matrix.
+     * @throw std::invalid_argument If the dimensions of the list are not R x C.
+     *
+     * @code
+     * $ cmatrix_fixed<int, 2, 2> m = {{1, 2}, {3, 4}};
+     * @endcode
+     */
+    cmatrix_fixed(const std::initializer_list<std::initializer_list<T>> &m);
+    /**
+     * @brief Construct a matrix from the cells of a dynamic matrix.
+     *
+     * @param m The dynamic matrix.
+     * @throw std::invalid_argument If the dimensions of the matrix `m` are not R x C.
+     */
+    explicit cmatrix_fixed(const cmatrix<T> &m);
+    /**
+     * @brief Get the identity matrix.
+     *
+     * @return cmatrix_fixed<T, R, C> The identity matrix.
+     * @note The matrix must be square.
+     */
+    static cmatrix_fixed<T, R, C> identity();
+
+    // GETTERS
+    /**
+     * @brief Get the number of rows of the matrix.
+     *
+     * @return size_t The number of rows.
+     */
+    static constexpr size_t height() { return R; }
+    /**
+     * @brief Get the number of columns of the matrix.
+     *
+     * @return size_t The number of columns.
+     */
+    static constexpr size_t width() { return C; }
+    /**
+     * @brief Get the dimensions of the matrix.
+     *
+     * @return std::pair<size_t, size_t> The number of rows and the number of columns.
+     */
+    static std::pair<size_t, size_t> size() { return std::pair<size_t, size_t>(R, C); }
+    /**
+     * @brief Check if the matrix has no cell. A fixed-size matrix always has cells.
+     *
+     * @return bool False.
+     */
+    static constexpr bool is_empty() { return false; }
+    /**
+     * @brief Check if the matrix is square.
+     *
+     * @return bool True if the matrix has as many rows as columns.
+     */
+    static constexpr bool is_square() { return R == C; }
+    /**
+     * @brief Get a reference to a cell of the matrix.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return T& The cell.
+     * @throw std::out_of_range If the index is out of range.
+     */
+    T &cell(const size_t &row, const size_t &col);
+    /**
+     * @brief Get a cell of the matrix. Evaluated at compile time when the matrix is a constant.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return T The cell.
+     * @throw std::out_of_range If the index is out of range.
+     */
+    constexpr T cell(const size_t &row, const size_t &col) const
+    {
+        return row < R and col < C ? m_data[row * C + col]
+                                   : (throw std::out_of_range("Invalid index. Expected: (" + std::to_string(row) + ", " + std::to_string(col) +
+                                                              ") < (" + std::to_string(R) + ", " + std::to_string(C) + ")"),
+                                      m_data[0]);
+    }
+    /**
+     * @brief Get a reference to a cell, without checking the indexes unless CMATRIX_BOUNDS_CHECK is 1.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return T& The cell.
+     */
+    T &at_unchecked(const size_t &row, const size_t &col);
+    /**
+     * @brief Get a cell, without checking the indexes unless CMATRIX_BOUNDS_CHECK is 1.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return const T& The cell.
+     */
+    const T &at_unchecked(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Get the first cell of the matrix. The rows are stored one after the other.
+     *
+     * @return T* The first cell.
+     */
+    T *data() { return m_data; }
+    /**
+     * @brief Get the first cell of the matrix. The rows are stored one after the other.
+     *
+     * @return const T* The first cell.
+     */
+    constexpr const T *data() const { return m_data; }
+    /**
+     * @brief Get the transpose of the matrix.
+     *
+     * @return cmatrix_fixed<T, C, R> The transpose of the matrix.
+     *
+     * @code
+     * $ cmatrix_fixed<int, 2, 3> m = {{1, 2, 3}, {4, 5, 6}};
+     * $ m.transpose();
+     * > [[1, 4], [2, 5], [3, 6]]
+     * @endcode
+     */
+    cmatrix_fixed<T, C, R> transpose() const;
+
+    // SETTERS
+    /**
+     * @brief Fill the matrix with a value.
+     *
+     * @param val The value of the cells.
+     */
+    void fill(const T &val);
+
+    // CONVERSION METHODS
+    /**
+     * @brief Convert the matrix to a dynamic matrix.
+     *
+     * @return cmatrix<T> The dynamic matrix.
+     */
+    cmatrix<T> to_cmatrix() const;
+
+    // MATH METHODS
+    /**
+     * @brief Get the product with another matrix. The product is unrolled at compile time.
+     *
+     * @tparam K The number of columns of the matrix `m`.
+     * @param m The matrix to multiply. Its number of rows is checked at compile time.
+     * @return cmatrix_fixed<T, R, K> The result of the product.
+     *
+     * @code
+     * $ cmatrix_fixed<int, 2, 2> m = {{1, 2}, {3, 4}};
+     * $ m.matmul(cmatrix_fixed<int, 2, 2>({{5, 6}, {7, 8}}));
+     * > [[19, 22], [43, 50]]
+     * @endcode
+     */
+    template <size_t K>
+    cmatrix_fixed<T, R, K> matmul(const cmatrix_fixed<T, C, K> &m) const;
+    /**
+     * @brief Get the determinant of the matrix.
+     * Computed by a closed formula up to 4x4, and by a Gaussian elimination with partial pivoting above.
+     * The elimination of the integer matrices is fraction-free (Bareiss), so their determinant is exact.
+     *
+     * @return T The determinant.
+     *
+     * @code
+     * $ cmatrix_fixed<int, 2, 2> m = {{1, 2}, {3, 4}};
+     * $ m.det();
+     * > -2
+     * @endcode
+     *
+     * @note The matrix must be square.
+     */
+    T det() const;
+    /**
+     * @brief Get the inverse of the matrix.
+     * Computed by the adjugate matrix up to 4x4, and by a Gauss-Jordan elimination with partial pivoting above.
+     *
+     * @return cmatrix_fixed<T, R, C> The inverse.
+     * @throw std::invalid_argument If the matrix is singular.
+     *
+     * @code
+     * $ cmatrix_fixed<float, 2, 2> m = {{4, 7}, {2, 6}};
+     * $ m.inverse();
+     * > [[0.6, -0.7], [-0.2, 0.4]]
+     * @endcode
+     *
+     * @note The matrix must be square and the type T must not be an integer type: the cells of the inverse
+     *       would be truncated. Convert the matrix to a floating point type first.
+     */
+    cmatrix_fixed<T, R, C> inverse() const;
+    /**
+     * @brief Get the sum of all the elements of the matrix.
+     *
+     * @param zero The zero value of the sum. (default: the value of the default constructor of the type T)
+     * @return T The sum of all the elements.
+     */
+    T sum_all(const T &zero = T()) const;
+    /**
+     * @brief Test if the matrix is near another matrix.
+     *
+     * @param m The matrix to compare.
+     * @param tolerance The tolerance. (default: 1e-5)
+     * @return bool True if each cell differs from the cell of `m` by at most the tolerance.
+     */
+    bool near(const cmatrix_fixed<T, R, C> &m, const T &tolerance = 1e-5) const;
+
+    // OPERATORS
+    /**
+     * @brief Check if two matrices are equal.
+     *
+     * @param m The matrix to compare.
+     * @return bool True if the cells are equal.
+     */
+    bool operator==(const cmatrix_fixed<T, R, C> &m) const;
+    /**
+     * @brief Check if two matrices are different.
+     *
+     * @param m The matrix to compare.
+     * @return bool True if a cell is different.
+     */
+    bool operator!=(const cmatrix_fixed<T, R, C> &m) const;
+    /**
+     * @brief Get the sum of two matrices, cell by cell.
+     *
+     * @param m The matrix to add.
+     * @return cmatrix_fixed<T, R, C> The sum.
+     */
+    cmatrix_fixed<T, R, C> operator+(const cmatrix_fixed<T, R, C> &m) const;
+    /**
+     * @brief Get the difference of two matrices, cell by cell.
+     *
+     * @param m The matrix to subtract.
+     * @return cmatrix_fixed<T, R, C> The difference.
+     */
+    cmatrix_fixed<T, R, C> operator-(const cmatrix_fixed<T, R, C> &m) const;
+    /**
+     * @brief Get the product of two matrices, cell by cell. Use matmul for the matrix product.
+     *
+     * @param m The matrix to multiply.
+     * @return cmatrix_fixed<T, R, C> The product.
+     */
+    cmatrix_fixed<T, R, C> operator*(const cmatrix_fixed<T, R, C> &m) const;
+    /**
+     * @brief Get the opposite of the matrix.
+     *
+     * @return cmatrix_fixed<T, R, C> The opposite.
+     */
+    cmatrix_fixed<T, R, C> operator-() const;
+    /**
+     * @brief Add a value to each cell.
+     *
+     * @param n The value.
+     * @return cmatrix_fixed<T, R, C> The sum.
+     */
+    cmatrix_fixed<T, R, C> operator+(const T &n) const;
+    /**
+     * @brief Subtract a value from each cell.
+     *
+     * @param n The value.
+     * @return cmatrix_fixed<T, R, C> The difference.
+     */
+    cmatrix_fixed<T, R, C> operator-(const T &n) const;
+    /**
+     * @brief Multiply each cell by a value.
+     *
+     * @param n The value.
+     * @return cmatrix_fixed<T, R, C> The product.
+     */
+    cmatrix_fixed<T, R, C> operator*(const T &n) const;
+    /**
+     * @brief Divide each cell by a value.
+     *
+     * @param n The value.
+     * @return cmatrix_fixed<T, R, C> The quotient.
+     * @throw std::invalid_argument If the value is 0.
+     */
+    cmatrix_fixed<T, R, C> operator/(const T &n) const;
+    /**
+     * @brief Add another matrix, cell by cell.
+     *
+     * @param m The matrix to add.
+     * @return cmatrix_fixed<T, R, C>& The matrix.
+     */
+    cmatrix_fixed<T, R, C> &operator+=(const cmatrix_fixed<T, R, C> &m);
+    /**
+     * @brief Subtract another matrix, cell by cell.
+     *
+     * @param m The matrix to subtract.
+     * @return cmatrix_fixed<T, R, C>& The matrix.
+     */
+    cmatrix_fixed<T, R, C> &operator-=(const cmatrix_fixed<T, R, C> &m);
+    /**
+     * @brief Multiply each cell by a value.
+     *
+     * @param n The value.
+     * @return cmatrix_fixed<T, R, C>& The matrix.
+     */
+    cmatrix_fixed<T, R, C> &operator*=(const T &n);
+    /**
+     * @brief Print the matrix in an output stream.
+     *
+     * @param out The output stream.
+     * @param m The matrix to print.
+     * @return std::ostream& The output stream.
+     */
+    template <class U, size_t H, size_t W>
+    friend std::ostream &operator<<(std::ostream &out, const cmatrix_fixed<U, H, W> &m);
+};
+
+#endif // CMATRIX_FIXED_HPP
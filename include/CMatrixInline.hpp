@@ -0,0 +1,268 @@
+/**
+ * @file CMatrixInline.hpp
+ * @brief This file contains the buffer storing the cells of the small matrices in the matrix itself.
+ *
+ * @details Up to CMATRIX_INLINE_SIZE cells, the cells of a matrix of arithmetic type are stored in the
+ *          matrix object, so creating it doesn't allocate. It is the case of many results: the sums and
+ *          extrema of a row or a column, the small matrices of coordinates, ... The bigger matrices use
+ *          the copy-on-write buffer of CMatrixShared.hpp. A matrix moves from one storage to the other
+ *          when its number of cells crosses the limit.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_INLINE_HPP
+#define CMATRIX_INLINE_HPP
+
+// INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "CMatrixBits.hpp"
+#include "CMatrixShared.hpp"
+
+/**
+ * @brief The maximal number of cells stored in the matrix object. 0 disables the inline storage.
+ * Define it before including CMatrix.hpp to override it.
+ */
+#ifndef CMATRIX_INLINE_SIZE
+#define CMATRIX_INLINE_SIZE 16
+#endif
+
+namespace cmatrix_inline
+{
+    /**
+     * @brief A buffer storing up to N cells in the object, and the bigger ones in a copy-on-write buffer.
+     * Provides the interface of cmatrix_cow::shared. The iterators are pointers.
+     *
+     * @warning The copies of a buffer stored inline don't share its cells: a reference to a cell is not valid
+     *          in the copy, and moving the matrix moves its cells.
+     *
+     * @tparam T The type of the cells.
+     * @tparam N The maximal number of cells stored in the object.
+     */
+    template <class T, size_t N>
+    class buffer
+    {
+    private:
+        // ATTRIBUTES
+        typedef cmatrix_cow::shared<typename cmatrix_alloc::vector<T>::type> heap_type;
+
+        T m_cells[N];
+        size_t m_size = 0;
+        bool m_inline = true;
+        heap_type m_heap;
+
+        /**
+         * @brief Move the cells in the heap buffer, before the number of cells exceeds N.
+         */
+        void __to_heap()
+        {
+            m_heap.assign(0, T());
+            m_heap.insert(m_heap.begin(), m_cells, m_cells + m_size);
+            m_inline = false;
+        }
+
+        /**
+         * @brief Move the cells back in the object, once they fit in it.
+         */
+        void __to_inline()
+        {
+            m_size = m_heap.size();
+            std::copy(m_heap.cbegin(), m_heap.cend(), m_cells);
+            m_heap.reset();
+            m_inline = true;
+        }
+
+    public:
+        typedef T value_type;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef T *iterator;
+        typedef const T *const_iterator;
+
+        buffer() {}
+
+        buffer(const buffer &b) : m_size(b.m_size), m_inline(b.m_inline), m_heap(b.m_heap)
+        {
+            if (m_inline)
+                std::copy(b.m_cells, b.m_cells + m_size, m_cells);
+        }
+
+        buffer(buffer &&b) noexcept : m_size(b.m_size), m_inline(b.m_inline), m_heap(std::move(b.m_heap))
+        {
+            if (m_inline)
+                std::copy(b.m_cells, b.m_cells + m_size, m_cells);
+
+            b.m_size = 0;
+            b.m_inline = true;
+        }
+
+        buffer &operator=(const buffer &b)
+        {
+            if (this != &b)
+            {
+                m_size = b.m_size;
+                m_inline = b.m_inline;
+                m_heap = b.m_heap;
+
+                if (m_inline)
+                    std::copy(b.m_cells, b.m_cells + m_size, m_cells);
+            }
+
+            return *this;
+        }
+
+        buffer &operator=(buffer &&b)
+        {
+            if (this != &b)
+            {
+                m_size = b.m_size;
+                m_inline = b.m_inline;
+                m_heap = std::move(b.m_heap);
+
+                if (m_inline)
+                    std::copy(b.m_cells, b.m_cells + m_size, m_cells);
+
+                b.m_size = 0;
+                b.m_inline = true;
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Check if the buffer is shared with another matrix. The cells stored inline are never shared.
+         *
+         * @return bool True if the buffer is shared.
+         */
+        bool is_shared() const { return not m_inline and m_heap.is_shared(); }
+
+        /**
+         * @brief Take a copy of the buffer if it is shared. To call before writing the cells in a parallel loop.
+         */
+        void detach()
+        {
+            if (not m_inline)
+                m_heap.detach();
+        }
+
+        /**
+         * @brief Take a copy of the buffer if it is shared, and never share it again. The cells stored inline
+         * are always copied, so only the heap buffer is leaked.
+         */
+        void leak()
+        {
+            if (not m_inline)
+                m_heap.leak();
+        }
+
+        /**
+         * @brief Check if the cells are stored in the object.
+         *
+         * @return bool True if the cells are stored inline.
+         */
+        bool is_inline() const { return m_inline; }
+
+        size_t size() const { return m_inline ? m_size : m_heap.size(); }
+
+        const_reference operator[](const size_t &i) const { return m_inline ? m_cells[i] : m_heap[i]; }
+        reference operator[](const size_t &i) { return m_inline ? m_cells[i] : m_heap[i]; }
+
+        const T *data() const { return m_inline ? m_cells : m_heap.data(); }
+        T *data() { return m_inline ? m_cells : m_heap.data(); }
+
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + size(); }
+        const_iterator cbegin() const { return data(); }
+        const_iterator cend() const { return data() + size(); }
+        iterator begin() { return data(); }
+        iterator end() { return data() + size(); }
+
+        /**
+         * @brief Replace the content of the buffer. A shared buffer is replaced without being copied.
+         *
+         * @param n The number of cells.
+         * @param val The value of the cells.
+         */
+        void assign(const size_t &n, const value_type &val)
+        {
+            if (n <= N)
+            {
+                std::fill(m_cells, m_cells + n, val);
+                m_size = n;
+                m_inline = true;
+                m_heap.reset();
+            }
+            else
+            {
+                m_heap.assign(n, val);
+                m_inline = false;
+            }
+        }
+
+        template <class InputIt>
+        void insert(const iterator &pos, InputIt first, InputIt last)
+        {
+            const size_t offset = pos - begin();
+            const size_t n = std::distance(first, last);
+
+            // The cells still fit in the object: shift the next cells and copy the new ones
+            if (m_inline and m_size + n <= N)
+            {
+                std::move_backward(m_cells + offset, m_cells + m_size, m_cells + m_size + n);
+                std::copy(first, last, m_cells + offset);
+                m_size += n;
+                return;
+            }
+
+            if (m_inline)
+                __to_heap();
+
+            m_heap.insert(m_heap.begin() + offset, first, last);
+        }
+
+        void erase(const iterator &first, const iterator &last)
+        {
+            const size_t from = first - begin();
+            const size_t to = last - begin();
+
+            if (m_inline)
+            {
+                std::move(m_cells + to, m_cells + m_size, m_cells + from);
+                m_size -= to - from;
+                return;
+            }
+
+            m_heap.erase(m_heap.begin() + from, m_heap.begin() + to);
+
+            if (m_heap.size() <= N)
+                __to_inline();
+        }
+    };
+
+    /**
+     * @brief The buffer of a matrix: inline up to CMATRIX_INLINE_SIZE cells for the arithmetic types,
+     * and the copy-on-write buffer otherwise. The bool type is excluded: its std::vector is bit-packed.
+     * With CMATRIX_ALIGNED_ROWS, the floating point types are excluded too: their rows must be aligned.
+     *
+     * @tparam T The type of the cells.
+     */
+    template <class T, bool Inline = (CMATRIX_INLINE_SIZE > 0 and std::is_arithmetic<T>::value and not std::is_same<T, bool>::value and not (CMATRIX_ALIGNED_ROWS and std::is_floating_point<T>::value))>
+    struct storage
+    {
+        typedef cmatrix_cow::shared<typename cmatrix_bits::storage<T>::type> type;
+    };
+
+    template <class T>
+    struct storage<T, true>
+    {
+        typedef buffer<T, CMATRIX_INLINE_SIZE> type;
+    };
+}
+
+#endif // CMATRIX_INLINE_HPP
@@ -0,0 +1,98 @@
+/**
+ * @file CMatrixLayout.hpp
+ * @brief This file contains the layouts of the buffer of a matrix, chosen by its second template parameter.
+ *
+ * @details The buffer stores the cells in lines of contiguous cells, each line starting `stride` cells after
+ *          the previous one. The lines are the rows with cmatrix_layout::row_major, the default layout, and
+ *          the columns with cmatrix_layout::col_major. So the operations along the columns of a column-major
+ *          matrix (sum(1), min(1), columns_vec, set_column, ...) read contiguous cells.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_LAYOUT_HPP
+#define CMATRIX_LAYOUT_HPP
+
+// INCLUDES
+#include <cstddef>
+#include <type_traits>
+
+namespace cmatrix_layout
+{
+    /**
+     * @brief The side of the square tiles copied at once between two layouts.
+     * A tile of doubles is 8 KiB, so the lines read and the lines written by a tile stay in the cache.
+     */
+    const size_t BLOCK = 32;
+
+    /**
+     * @brief The cells are stored row by row.
+     */
+    struct row_major
+    {
+        /**
+         * @brief Get the number of lines of a matrix.
+         */
+        static size_t lines(const size_t &height, const size_t &) { return height; }
+
+        /**
+         * @brief Get the number of cells of the lines of a matrix.
+         */
+        static size_t length(const size_t &, const size_t &width) { return width; }
+
+        /**
+         * @brief Get the position of a cell in the buffer.
+         */
+        static size_t index(const size_t &row, const size_t &col, const size_t &stride) { return row * stride + col; }
+
+        /**
+         * @brief Get the distance between two cells of a column, and between two cells of a row.
+         */
+        static size_t row_step(const size_t &stride) { return stride; }
+        static size_t col_step(const size_t &) { return 1; }
+    };
+
+    /**
+     * @brief The cells are stored column by column.
+     */
+    struct col_major
+    {
+        static size_t lines(const size_t &, const size_t &width) { return width; }
+        static size_t length(const size_t &height, const size_t &) { return height; }
+        static size_t index(const size_t &row, const size_t &col, const size_t &stride) { return col * stride + row; }
+        static size_t row_step(const size_t &) { return 1; }
+        static size_t col_step(const size_t &stride) { return stride; }
+    };
+
+    /**
+     * @brief The layout of the transpose of a matrix: the rows stored one after the other are its columns.
+     * So a matrix and its transpose in the other layout have the same buffer.
+     */
+    template <class Layout>
+    struct transposed;
+
+    template <>
+    struct transposed<row_major>
+    {
+        typedef col_major type;
+    };
+
+    template <>
+    struct transposed<col_major>
+    {
+        typedef row_major type;
+    };
+
+    /**
+     * @brief Check if a layout stores the cells row by row.
+     */
+    template <class Layout>
+    using is_row_major = std::is_same<Layout, row_major>;
+}
+
+template <class T, class Layout = cmatrix_layout::row_major>
+class cmatrix;
+
+#endif // CMATRIX_LAYOUT_HPP
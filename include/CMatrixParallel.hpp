@@ -0,0 +1,281 @@
+/**
+ * @file CMatrixParallel.hpp
+ * @brief This file contains the cost model deciding when an operation runs on several threads, and on how many.
+ *
+ * @details Forking a team of threads costs a few microseconds: more than adding two small matrices.
+ *          So each parallel loop of the library estimates its work, in units proper to its kind of
+ *          operation (cells, multiply-adds, ...), and only forks a team if the work reaches the threshold
+ *          of its kind. Each thread then gets at least a threshold of work. The loops called from a
+ *          parallel region always run on the calling thread. The thresholds and the number of threads
+ *          can be set for the whole program, or for the calls made in a scope by a thread.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_PARALLEL_HPP
+#define CMATRIX_PARALLEL_HPP
+
+// INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace cmatrix_parallel
+{
+    /**
+     * @brief The kinds of operations, each one with its own threshold.
+     */
+    enum kind
+    {
+        ELEMENTWISE = 0, // The arithmetic operators and comparisons, the copies. Work: the cells.
+        CALLABLE = 1,    // The calls of a function per cell (apply, map, ...) and the sorts. Work: the cells.
+        REDUCTION = 2,   // The sums, extrema, means, ... of the rows or columns. Work: the cells read.
+        TRANSPOSE = 3,   // The transpositions and the conversions between layouts. Work: the cells.
+        PRODUCT = 4,     // The matrix products. Work: the multiply-adds.
+        KINDS = 5
+    };
+
+    /**
+     * @brief The default thresholds, in units of work of each kind: under them, the fork of the team is
+     * expected to cost more than it saves. They are estimates, to tune with set_threshold for a given machine.
+     */
+    const size_t DEFAULT_THRESHOLDS[KINDS] = {
+        1 << 15, // ELEMENTWISE
+        1 << 12, // CALLABLE
+        1 << 15, // REDUCTION
+        1 << 16, // TRANSPOSE
+        1 << 18  // PRODUCT
+    };
+
+    /**
+     * @brief The thresholds and the number of threads of the parallel loops.
+     */
+    struct settings
+    {
+        size_t thresholds[KINDS];
+        int threads;
+    };
+
+    /**
+     * @brief The settings of the program, read by the threads outside of any scope.
+     */
+    struct global_settings
+    {
+        std::atomic<size_t> thresholds[KINDS];
+        std::atomic<int> threads;
+
+        global_settings() : threads(0)
+        {
+            for (size_t i = 0; i < KINDS; i++)
+                thresholds[i] = DEFAULT_THRESHOLDS[i];
+        }
+    };
+
+    inline global_settings &__global()
+    {
+        static global_settings global;
+        return global;
+    }
+
+    /**
+     * @brief The settings of the innermost scope of the thread, or nullptr outside of any scope.
+     */
+    inline settings *&__current()
+    {
+        static thread_local settings *current = nullptr;
+        return current;
+    }
+
+    // ==================================================
+    // SETTINGS
+
+    /**
+     * @brief Get the threshold of a kind of operations: the work under which they run on a single thread.
+     *
+     * @param k The kind of operations.
+     * @return size_t The threshold, in units of work of the kind.
+     */
+    inline size_t threshold(const kind &k)
+    {
+        return __current() ? __current()->thresholds[k] : __global().thresholds[k].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Set the threshold of a kind of operations for the whole program.
+     * The scopes opened before keep their threshold.
+     *
+     * @param k The kind of operations.
+     * @param work The threshold, in units of work of the kind. 0 parallelizes all the operations of the kind.
+     */
+    inline void set_threshold(const kind &k, const size_t &work)
+    {
+        __global().thresholds[k].store(work, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Restore the default thresholds for the whole program.
+     */
+    inline void reset_thresholds()
+    {
+        for (size_t i = 0; i < KINDS; i++)
+            set_threshold(kind(i), DEFAULT_THRESHOLDS[i]);
+    }
+
+    /**
+     * @brief Get the maximal number of threads of the parallel loops, if set.
+     *
+     * @param fallback The number of threads if none is set.
+     * @return int The number of threads.
+     */
+    inline int threads(const int &fallback)
+    {
+        const int n = __current() ? __current()->threads : __global().threads.load(std::memory_order_relaxed);
+        return n > 0 ? n : fallback;
+    }
+
+    /**
+     * @brief Get the maximal number of threads of the parallel loops.
+     *
+     * @return int The number of threads: the OpenMP default (OMP_NUM_THREADS) unless set. 1 without OpenMP.
+     */
+    inline int threads()
+    {
+#ifdef _OPENMP
+        return threads(omp_get_max_threads());
+#else
+        return threads(1);
+#endif
+    }
+
+    /**
+     * @brief Set the maximal number of threads of the parallel loops for the whole program.
+     * Unlike omp_set_num_threads, it applies to all the threads calling the library.
+     *
+     * @param n The number of threads. 0 restores the OpenMP default.
+     */
+    inline void set_threads(const int &n)
+    {
+        __global().threads.store(std::max(n, 0), std::memory_order_relaxed);
+    }
+
+    // ==================================================
+    // COST MODEL
+
+    /**
+     * @brief Check if the thread runs a task of a parallel loop of the library.
+     */
+    inline bool &__in_task()
+    {
+        static thread_local bool in_task = false;
+        return in_task;
+    }
+
+    /**
+     * @brief Get the number of threads of a parallel loop: as many as the work gives a threshold to,
+     * up to `max`. A loop called from a parallel region, or from a task of a parallel loop of the library,
+     * runs on the calling thread.
+     *
+     * @param k The kind of the operation.
+     * @param work The estimated work of the operation, in units of work of the kind.
+     * @param max The maximal number of threads.
+     * @return int The number of threads. 1 runs the loop on the calling thread.
+     */
+    inline int team(const kind &k, const size_t &work, const int &max)
+    {
+#ifdef _OPENMP
+        if (omp_in_parallel())
+            return 1;
+#endif
+
+        const size_t n = std::max(max, 1);
+        const size_t min = threshold(k);
+
+        if (__in_task() or n <= 1 or work == 0 or work < min)
+            return 1;
+
+        return int(min == 0 ? n : std::min(n, work / min));
+    }
+
+    /**
+     * @brief Get the number of threads of a parallel loop, up to threads().
+     *
+     * @param k The kind of the operation.
+     * @param work The estimated work of the operation, in units of work of the kind.
+     * @return int The number of threads. 1 runs the loop on the calling thread.
+     */
+    inline int team(const kind &k, const size_t &work)
+    {
+        return team(k, work, threads());
+    }
+
+    /**
+     * @brief A scope in which the operations called by the thread use their own thresholds and number of
+     * threads. It starts from the settings in use when it is opened. The scopes can be nested: the innermost
+     * one is used.
+     *
+     * @code
+     * $ {
+     * $     cmatrix_parallel::scope serial(1);
+     * $     c = a + b; // Runs on the calling thread, whatever its size
+     * $ }
+     * $ {
+     * $     cmatrix_parallel::scope wide(8);
+     * $     wide.set_threshold(cmatrix_parallel::PRODUCT, 1 << 16);
+     * $     c = a.matmul(b); // Up to 8 threads, from 64K multiply-adds per thread
+     * $ }
+     * @endcode
+     */
+    class scope
+    {
+    private:
+        // ATTRIBUTES
+        settings m_settings;
+        settings *m_previous;
+
+    public:
+        /**
+         * @brief Open a scope.
+         *
+         * @param n The maximal number of threads of the operations of the scope. 0 keeps the current one.
+         */
+        explicit scope(const int &n = 0) : m_previous(__current())
+        {
+            for (size_t i = 0; i < KINDS; i++)
+                m_settings.thresholds[i] = threshold(kind(i));
+
+            m_settings.threads = n > 0 ? n : (m_previous ? m_previous->threads : __global().threads.load(std::memory_order_relaxed));
+            __current() = &m_settings;
+        }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+        /**
+         * @brief Close the scope: the thread uses the settings of the enclosing scope again.
+         */
+        ~scope() { __current() = m_previous; }
+
+        /**
+         * @brief Set the threshold of a kind of operations in the scope.
+         *
+         * @param k The kind of operations.
+         * @param work The threshold, in units of work of the kind. 0 parallelizes all the operations of the kind.
+         */
+        void set_threshold(const kind &k, const size_t &work) { m_settings.thresholds[k] = work; }
+
+        /**
+         * @brief Set the maximal number of threads in the scope.
+         *
+         * @param n The number of threads. 0 uses the OpenMP default.
+         */
+        void set_threads(const int &n) { m_settings.threads = std::max(n, 0); }
+    };
+}
+
+#endif // CMATRIX_PARALLEL_HPP
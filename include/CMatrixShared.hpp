@@ -0,0 +1,255 @@
+/**
+ * @file CMatrixShared.hpp
+ * @brief This file contains the copy-on-write buffer of the matrices.
+ *
+ * @details The copies of a matrix share its buffer, so copying a matrix or passing it by value costs O(1).
+ *          The buffer is copied the first time a matrix sharing it is modified. The read-only methods
+ *          access the buffer through its const members and never copy it. Once a reference or a pointer
+ *          to a cell is given to the user, the buffer is never shared again, like the strings of libstdc++. A matrix allocates from the arena
+ *          it was created in, and copies a buffer of an arena closing before its own. (see CMatrixArena.hpp)
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_SHARED_HPP
+#define CMATRIX_SHARED_HPP
+
+// INCLUDES
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "CMatrixArena.hpp"
+
+namespace cmatrix_cow
+{
+    /**
+     * @brief A reference counted buffer, copied before the first write when it is shared.
+     * Provides the interface of the underlying buffer used by cmatrix. The non-const members
+     * give a write access, so they copy the buffer if another matrix shares it.
+     *
+     * A buffer leaked by leak() is not shared anymore: the next copies copy it, so a reference to a cell
+     * obtained before the copy doesn't write in the copy.
+     *
+     * @tparam S The type of the buffer: std::vector or cmatrix_bits::buffer.
+     */
+    template <class S>
+    class shared
+    {
+    private:
+        // ATTRIBUTES
+        std::shared_ptr<S> m_ptr;
+        cmatrix_arena *m_arena = cmatrix_arena::current();
+        cmatrix_arena *m_from = nullptr;
+        bool m_leaked = false;
+
+        /**
+         * @brief The buffer of the matrices without buffer.
+         */
+        static const S &__empty()
+        {
+            static const S empty;
+            return empty;
+        }
+
+        const S &__get() const
+        {
+            return m_ptr ? *m_ptr : __empty();
+        }
+
+        /**
+         * @brief Record that the buffer may hold memory of the arena the allocator drew from.
+         * The buffer lives as long as the youngest of its arenas.
+         */
+        void __drawn()
+        {
+            if (cmatrix_arena::outlives(m_from, cmatrix_alloc::target::arena()))
+                m_from = cmatrix_alloc::target::arena();
+        }
+
+        S &__mut()
+        {
+            if (not m_ptr or m_ptr.use_count() > 1)
+            {
+                cmatrix_alloc::target to(m_arena);
+
+                // Another matrix shares the buffer: take a copy before writing
+                m_ptr = m_ptr ? std::allocate_shared<S>(cmatrix_alloc::allocator<S>(), *m_ptr)
+                              : std::allocate_shared<S>(cmatrix_alloc::allocator<S>());
+                m_from = cmatrix_alloc::target::arena();
+                m_leaked = false;
+            }
+
+            return *m_ptr;
+        }
+
+        /**
+         * @brief Check if the buffer of another matrix can be shared. A buffer of an arena closing before the
+         * arena of the matrix is not, so a matrix created before a scope never keeps memory of the scope.
+         * A leaked buffer is not either, since the user may still write in it.
+         */
+        bool __can_share(const shared &s) const
+        {
+            return not s.m_ptr or (not s.m_leaked and cmatrix_arena::outlives(s.m_from, m_arena));
+        }
+
+        /**
+         * @brief Share the buffer of another matrix, or copy it if it can't be shared.
+         */
+        void __share(const shared &s)
+        {
+            m_leaked = false;
+
+            if (__can_share(s))
+            {
+                m_ptr = s.m_ptr;
+                m_from = s.m_from;
+                return;
+            }
+
+            cmatrix_alloc::target to(m_arena);
+            m_ptr = std::allocate_shared<S>(cmatrix_alloc::allocator<S>(), *s.m_ptr);
+            m_from = cmatrix_alloc::target::arena();
+        }
+
+    public:
+        typedef typename S::value_type value_type;
+        typedef typename S::reference reference;
+        typedef typename S::const_reference const_reference;
+        typedef typename S::iterator iterator;
+        typedef typename S::const_iterator const_iterator;
+
+        shared() {}
+
+        shared(const shared &s) { __share(s); }
+
+        /**
+         * @brief Take the buffer of the matrix, and the arena it was created in.
+         */
+        shared(shared &&s) noexcept : m_ptr(std::move(s.m_ptr)), m_arena(s.m_arena), m_from(s.m_from), m_leaked(s.m_leaked)
+        {
+            s.m_leaked = false;
+        }
+
+        /**
+         * @brief Share or take the buffer of the matrix. The matrix keeps the arena it was created in.
+         */
+        shared &operator=(const shared &s)
+        {
+            if (this != &s)
+                __share(s);
+
+            return *this;
+        }
+
+        shared &operator=(shared &&s)
+        {
+            if (this == &s)
+                return *this;
+
+            // The references to the cells of a leaked buffer follow it
+            if (not s.m_ptr or cmatrix_arena::outlives(s.m_from, m_arena))
+            {
+                m_ptr = std::move(s.m_ptr);
+                m_from = s.m_from;
+                m_leaked = s.m_leaked;
+                s.m_leaked = false;
+            }
+            else
+                __share(s);
+
+            return *this;
+        }
+
+        /**
+         * @brief Release the buffer.
+         */
+        void reset()
+        {
+            m_ptr.reset();
+            m_from = nullptr;
+            m_leaked = false;
+        }
+
+        /**
+         * @brief Check if the buffer is shared with another matrix.
+         *
+         * @return bool True if the buffer is shared.
+         */
+        bool is_shared() const { return m_ptr and m_ptr.use_count() > 1; }
+
+        /**
+         * @brief Take a copy of the buffer if it is shared. To call before writing the cells in a parallel loop.
+         */
+        void detach() { __mut(); }
+
+        /**
+         * @brief Take a copy of the buffer if it is shared, and never share it again. To call before giving a
+         * reference or a pointer to a cell to the user, who may write in it after the matrix is copied.
+         */
+        void leak()
+        {
+            __mut();
+            m_leaked = true;
+        }
+
+        size_t size() const { return __get().size(); }
+
+        const_reference operator[](const size_t &i) const { return __get()[i]; }
+        reference operator[](const size_t &i) { return __mut()[i]; }
+
+        const_iterator begin() const { return __get().begin(); }
+        const_iterator end() const { return __get().end(); }
+        const_iterator cbegin() const { return __get().begin(); }
+        const_iterator cend() const { return __get().end(); }
+        iterator begin() { return __mut().begin(); }
+        iterator end() { return __mut().end(); }
+
+        const value_type *data() const { return __get().data(); }
+        value_type *data() { return __mut().data(); }
+
+        /**
+         * @brief Replace the content of the buffer. A shared buffer is replaced without being copied.
+         *
+         * @param n The number of cells.
+         * @param val The value of the cells.
+         */
+        void assign(const size_t &n, const value_type &val)
+        {
+            cmatrix_alloc::target to(m_arena);
+
+            if (not m_ptr or m_ptr.use_count() > 1)
+            {
+                m_ptr = std::allocate_shared<S>(cmatrix_alloc::allocator<S>());
+                m_leaked = false;
+            }
+
+            m_ptr->assign(n, val);
+            __drawn();
+        }
+
+        template <class InputIt>
+        void insert(const iterator &pos, InputIt first, InputIt last)
+        {
+            S &buffer = __mut();
+            cmatrix_alloc::target to(m_arena);
+            buffer.insert(pos, first, last);
+            __drawn();
+        }
+        void erase(const iterator &first, const iterator &last) { __mut().erase(first, last); }
+
+        // Bit-packed buffers
+        const std::uint64_t *words() const { return __get().words(); }
+        std::uint64_t *words() { return __mut().words(); }
+        size_t nwords() const { return __get().nwords(); }
+        size_t count() const { return __get().count(); }
+        void clear_tail() { __mut().clear_tail(); }
+
+        template <class F>
+        void for_each_set(F f) const { __get().for_each_set(f); }
+    };
+}
+
+#endif // CMATRIX_SHARED_HPP
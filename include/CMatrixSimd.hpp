@@ -0,0 +1,975 @@
+/**
+ * @file CMatrixSimd.hpp
+ * @brief This file contains the SIMD kernels of the elementwise operators and comparisons, and the dispatch between them.
+ *
+ * @details The instruction set is detected once, at the first call, and the kernels compiled for
+ *          SSE4.2, AVX2 and AVX-512 are selected at runtime. The same binary can therefore run on any
+ *          x86-64 processor. The other processors and compilers use the scalar kernels.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_SIMD_HPP
+#define CMATRIX_SIMD_HPP
+
+// INCLUDES
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define CMATRIX_SIMD_X86
+#include <immintrin.h>
+#define CMATRIX_SIMD_SSE42 __attribute__((target("sse4.2"), always_inline)) static inline
+#define CMATRIX_SIMD_AVX2 __attribute__((target("avx2"), always_inline)) static inline
+#define CMATRIX_SIMD_AVX512 __attribute__((target("avx512f,avx512dq"), always_inline)) static inline
+#endif
+
+namespace cmatrix_simd
+{
+    /**
+     * @brief The instruction sets, from the oldest to the newest.
+     */
+    enum isa
+    {
+        SCALAR = 0,
+        SSE42 = 1,
+        AVX2 = 2,
+        AVX512 = 3
+    };
+
+    /**
+     * @brief The elementwise arithmetic operators.
+     */
+    enum op
+    {
+        ADD,
+        SUB,
+        MUL,
+        DIV
+    };
+
+    /**
+     * @brief The elementwise comparisons.
+     */
+    enum cmp
+    {
+        EQ,
+        NEQ,
+        LT,
+        LEQ,
+        GT,
+        GEQ
+    };
+
+    /**
+     * @brief The number of cells processed at once by a thread.
+     * Whether the operators run on several threads is decided by the cost model of CMatrixParallel.hpp.
+     */
+    static const size_t CHUNK = 1 << 14;
+
+    /**
+     * @brief A tag to select the overload of an operator.
+     */
+    template <op O>
+    struct op_tag
+    {
+    };
+
+    /**
+     * @brief A tag to select the overload of a comparison.
+     */
+    template <cmp C>
+    struct cmp_tag
+    {
+    };
+
+    // ==================================================
+    // DETECTION
+
+    /**
+     * @brief Detect the newest instruction set supported by the processor and the operating system.
+     *
+     * @return isa The instruction set.
+     */
+    inline isa detect()
+    {
+#ifdef CMATRIX_SIMD_X86
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512dq"))
+            return AVX512;
+
+        if (__builtin_cpu_supports("avx2"))
+            return AVX2;
+
+        if (__builtin_cpu_supports("sse4.2"))
+            return SSE42;
+#endif
+
+        return SCALAR;
+    }
+
+    /**
+     * @brief The instruction set used by the kernels, detected at the first call.
+     */
+    inline isa &__level()
+    {
+        static isa level = detect();
+        return level;
+    }
+
+    /**
+     * @brief Get the instruction set used by the kernels.
+     *
+     * @return isa The instruction set.
+     */
+    inline isa level()
+    {
+        return __level();
+    }
+
+    /**
+     * @brief Set the instruction set used by the kernels. Mostly useful to test or benchmark the older kernels.
+     *
+     * @param level The instruction set. Limited to the instruction set supported by the processor.
+     */
+    inline void set_level(const isa &level)
+    {
+        __level() = std::min(level, detect());
+    }
+
+    // ==================================================
+    // SCALAR KERNELS
+
+    /**
+     * @brief Apply an operator to two values.
+     *
+     * @tparam O The operator.
+     */
+    template <op O>
+    struct scalar_op;
+
+    template <>
+    struct scalar_op<ADD>
+    {
+        template <class T>
+        static T apply(const T &a, const T &b) { return a + b; }
+    };
+
+    template <>
+    struct scalar_op<SUB>
+    {
+        template <class T>
+        static T apply(const T &a, const T &b) { return a - b; }
+    };
+
+    template <>
+    struct scalar_op<MUL>
+    {
+        template <class T>
+        static T apply(const T &a, const T &b) { return a * b; }
+    };
+
+    template <>
+    struct scalar_op<DIV>
+    {
+        template <class T>
+        static T apply(const T &a, const T &b) { return a / b; }
+    };
+
+    /**
+     * @brief Compare two values.
+     *
+     * @tparam C The comparison.
+     */
+    template <cmp C>
+    struct scalar_cmp;
+
+    template <>
+    struct scalar_cmp<EQ>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a == b; }
+    };
+
+    template <>
+    struct scalar_cmp<NEQ>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a != b; }
+    };
+
+    template <>
+    struct scalar_cmp<LT>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a < b; }
+    };
+
+    template <>
+    struct scalar_cmp<LEQ>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a <= b; }
+    };
+
+    template <>
+    struct scalar_cmp<GT>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a > b; }
+    };
+
+    template <>
+    struct scalar_cmp<GEQ>
+    {
+        template <class T>
+        static bool apply(const T &a, const T &b) { return a >= b; }
+    };
+
+    /**
+     * @brief The kernels without vector instructions. Used for the remaining cells of the vector kernels.
+     * The comparisons write a bit per cell, 64 cells per word. The last word is completed with zeros.
+     */
+    struct scalar_kernels
+    {
+        template <class T, op O>
+        static void binary(const T *a, const T *b, T *out, const size_t &n)
+        {
+            for (size_t i = 0; i < n; i++)
+                out[i] = scalar_op<O>::apply(a[i], b[i]);
+        }
+
+        template <class T, op O>
+        static void scalar(const T *a, const T &b, T *out, const size_t &n)
+        {
+            for (size_t i = 0; i < n; i++)
+                out[i] = scalar_op<O>::apply(a[i], b);
+        }
+
+        template <class T, cmp C>
+        static void compare(const T *a, const T *b, std::uint64_t *out, const size_t &n)
+        {
+            for (size_t i = 0; i < n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64 and i + j < n; j++)
+                    word |= std::uint64_t(scalar_cmp<C>::apply(a[i + j], b[i + j])) << j;
+
+                out[i / 64] = word;
+            }
+        }
+
+        template <class T, cmp C>
+        static void compare_scalar(const T *a, const T &b, std::uint64_t *out, const size_t &n)
+        {
+            for (size_t i = 0; i < n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64 and i + j < n; j++)
+                    word |= std::uint64_t(scalar_cmp<C>::apply(a[i + j], b)) << j;
+
+                out[i / 64] = word;
+            }
+        }
+    };
+
+    // ==================================================
+    // REGISTERS
+
+    /**
+     * @brief The vector registers of an instruction set for a type.
+     * Each specialization defines the register type, its number of cells, the load, store, broadcast,
+     * the operators the instruction set provides for the type and the comparisons, returned as a bit per cell.
+     *
+     * @tparam I The instruction set.
+     * @tparam T The type of the cells.
+     */
+    template <isa I, class T>
+    struct reg
+    {
+        static const bool supported = false;
+    };
+
+    /**
+     * @brief Check if a vector kernel exists for an instruction set, a type and an operator.
+     * The integer divisions and the 64 bits integer multiplication before AVX-512 have no vector instruction.
+     */
+    template <isa I, class T, op O>
+    struct has_kernel
+    {
+        static const bool value = reg<I, T>::supported and
+                                  (O != DIV or std::is_floating_point<T>::value) and
+                                  (O != MUL or sizeof(T) == 4 or std::is_floating_point<T>::value or I == AVX512);
+    };
+
+#ifdef CMATRIX_SIMD_X86
+    /**
+     * @brief The predicates of the comparisons, for the floating point and the AVX-512 integer instructions.
+     * The floating point comparisons are false with NaN, except the inequality, like the C++ operators.
+     */
+    template <cmp C>
+    struct cmp_imm;
+
+    template <>
+    struct cmp_imm<EQ>
+    {
+        static const int fp = _CMP_EQ_OQ;
+        static const int integer = _MM_CMPINT_EQ;
+    };
+
+    template <>
+    struct cmp_imm<NEQ>
+    {
+        static const int fp = _CMP_NEQ_UQ;
+        static const int integer = _MM_CMPINT_NE;
+    };
+
+    template <>
+    struct cmp_imm<LT>
+    {
+        static const int fp = _CMP_LT_OQ;
+        static const int integer = _MM_CMPINT_LT;
+    };
+
+    template <>
+    struct cmp_imm<LEQ>
+    {
+        static const int fp = _CMP_LE_OQ;
+        static const int integer = _MM_CMPINT_LE;
+    };
+
+    template <>
+    struct cmp_imm<GT>
+    {
+        static const int fp = _CMP_GT_OQ;
+        static const int integer = _MM_CMPINT_NLE;
+    };
+
+    template <>
+    struct cmp_imm<GEQ>
+    {
+        static const int fp = _CMP_GE_OQ;
+        static const int integer = _MM_CMPINT_NLT;
+    };
+
+    // SSE4.2
+
+    template <>
+    struct reg<SSE42, float>
+    {
+        static const bool supported = true;
+        static const size_t width = 4;
+        typedef __m128 type;
+        CMATRIX_SIMD_SSE42 type load(const float *p) { return _mm_loadu_ps(p); }
+        CMATRIX_SIMD_SSE42 void store(float *p, type a) { _mm_storeu_ps(p, a); }
+        CMATRIX_SIMD_SSE42 type set1(const float &v) { return _mm_set1_ps(v); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<ADD>) { return _mm_add_ps(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<SUB>) { return _mm_sub_ps(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<MUL>) { return _mm_mul_ps(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<DIV>) { return _mm_div_ps(a, b); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return _mm_movemask_ps(_mm_cmpneq_ps(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return _mm_movemask_ps(_mm_cmplt_ps(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return _mm_movemask_ps(_mm_cmple_ps(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm_movemask_ps(_mm_cmpgt_ps(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return _mm_movemask_ps(_mm_cmpge_ps(a, b)); }
+    };
+
+    template <>
+    struct reg<SSE42, double>
+    {
+        static const bool supported = true;
+        static const size_t width = 2;
+        typedef __m128d type;
+        CMATRIX_SIMD_SSE42 type load(const double *p) { return _mm_loadu_pd(p); }
+        CMATRIX_SIMD_SSE42 void store(double *p, type a) { _mm_storeu_pd(p, a); }
+        CMATRIX_SIMD_SSE42 type set1(const double &v) { return _mm_set1_pd(v); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<ADD>) { return _mm_add_pd(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<SUB>) { return _mm_sub_pd(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<MUL>) { return _mm_mul_pd(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<DIV>) { return _mm_div_pd(a, b); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return _mm_movemask_pd(_mm_cmpneq_pd(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return _mm_movemask_pd(_mm_cmplt_pd(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return _mm_movemask_pd(_mm_cmple_pd(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm_movemask_pd(_mm_cmpgt_pd(a, b)); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return _mm_movemask_pd(_mm_cmpge_pd(a, b)); }
+    };
+
+    template <>
+    struct reg<SSE42, std::int32_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 4;
+        typedef __m128i type;
+        CMATRIX_SIMD_SSE42 type load(const std::int32_t *p) { return _mm_loadu_si128((const __m128i *)p); }
+        CMATRIX_SIMD_SSE42 void store(std::int32_t *p, type a) { _mm_storeu_si128((__m128i *)p, a); }
+        CMATRIX_SIMD_SSE42 type set1(const std::int32_t &v) { return _mm_set1_epi32(v); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<ADD>) { return _mm_add_epi32(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<SUB>) { return _mm_sub_epi32(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<MUL>) { return _mm_mullo_epi32(a, b); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b))); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return bits(a, b, cmp_tag<EQ>()) ^ 0xF; }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return bits(b, a, cmp_tag<GT>()); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return bits(a, b, cmp_tag<GT>()) ^ 0xF; }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(a, b))); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return bits(b, a, cmp_tag<GT>()) ^ 0xF; }
+    };
+
+    template <>
+    struct reg<SSE42, std::int64_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 2;
+        typedef __m128i type;
+        CMATRIX_SIMD_SSE42 type load(const std::int64_t *p) { return _mm_loadu_si128((const __m128i *)p); }
+        CMATRIX_SIMD_SSE42 void store(std::int64_t *p, type a) { _mm_storeu_si128((__m128i *)p, a); }
+        CMATRIX_SIMD_SSE42 type set1(const std::int64_t &v) { return _mm_set1_epi64x(v); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<ADD>) { return _mm_add_epi64(a, b); }
+        CMATRIX_SIMD_SSE42 type apply(type a, type b, op_tag<SUB>) { return _mm_sub_epi64(a, b); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(a, b))); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return bits(a, b, cmp_tag<EQ>()) ^ 0x3; }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return bits(b, a, cmp_tag<GT>()); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return bits(a, b, cmp_tag<GT>()) ^ 0x3; }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(a, b))); }
+        CMATRIX_SIMD_SSE42 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return bits(b, a, cmp_tag<GT>()) ^ 0x3; }
+    };
+
+    // AVX2
+
+    template <>
+    struct reg<AVX2, float>
+    {
+        static const bool supported = true;
+        static const size_t width = 8;
+        typedef __m256 type;
+        CMATRIX_SIMD_AVX2 type load(const float *p) { return _mm256_loadu_ps(p); }
+        CMATRIX_SIMD_AVX2 void store(float *p, type a) { _mm256_storeu_ps(p, a); }
+        CMATRIX_SIMD_AVX2 type set1(const float &v) { return _mm256_set1_ps(v); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<ADD>) { return _mm256_add_ps(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<SUB>) { return _mm256_sub_ps(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<MUL>) { return _mm256_mul_ps(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<DIV>) { return _mm256_div_ps(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, cmp_imm<C>::fp)); }
+    };
+
+    template <>
+    struct reg<AVX2, double>
+    {
+        static const bool supported = true;
+        static const size_t width = 4;
+        typedef __m256d type;
+        CMATRIX_SIMD_AVX2 type load(const double *p) { return _mm256_loadu_pd(p); }
+        CMATRIX_SIMD_AVX2 void store(double *p, type a) { _mm256_storeu_pd(p, a); }
+        CMATRIX_SIMD_AVX2 type set1(const double &v) { return _mm256_set1_pd(v); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<ADD>) { return _mm256_add_pd(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<SUB>) { return _mm256_sub_pd(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<MUL>) { return _mm256_mul_pd(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<DIV>) { return _mm256_div_pd(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, cmp_imm<C>::fp)); }
+    };
+
+    template <>
+    struct reg<AVX2, std::int32_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 8;
+        typedef __m256i type;
+        CMATRIX_SIMD_AVX2 type load(const std::int32_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+        CMATRIX_SIMD_AVX2 void store(std::int32_t *p, type a) { _mm256_storeu_si256((__m256i *)p, a); }
+        CMATRIX_SIMD_AVX2 type set1(const std::int32_t &v) { return _mm256_set1_epi32(v); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<ADD>) { return _mm256_add_epi32(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<SUB>) { return _mm256_sub_epi32(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<MUL>) { return _mm256_mullo_epi32(a, b); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b))); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return bits(a, b, cmp_tag<EQ>()) ^ 0xFF; }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return bits(b, a, cmp_tag<GT>()); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return bits(a, b, cmp_tag<GT>()) ^ 0xFF; }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b))); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return bits(b, a, cmp_tag<GT>()) ^ 0xFF; }
+    };
+
+    template <>
+    struct reg<AVX2, std::int64_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 4;
+        typedef __m256i type;
+        CMATRIX_SIMD_AVX2 type load(const std::int64_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+        CMATRIX_SIMD_AVX2 void store(std::int64_t *p, type a) { _mm256_storeu_si256((__m256i *)p, a); }
+        CMATRIX_SIMD_AVX2 type set1(const std::int64_t &v) { return _mm256_set1_epi64x(v); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<ADD>) { return _mm256_add_epi64(a, b); }
+        CMATRIX_SIMD_AVX2 type apply(type a, type b, op_tag<SUB>) { return _mm256_sub_epi64(a, b); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<EQ>) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b))); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<NEQ>) { return bits(a, b, cmp_tag<EQ>()) ^ 0xF; }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<LT>) { return bits(b, a, cmp_tag<GT>()); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<LEQ>) { return bits(a, b, cmp_tag<GT>()) ^ 0xF; }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<GT>) { return _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a, b))); }
+        CMATRIX_SIMD_AVX2 std::uint64_t bits(type a, type b, cmp_tag<GEQ>) { return bits(b, a, cmp_tag<GT>()) ^ 0xF; }
+    };
+
+    // AVX-512
+
+    template <>
+    struct reg<AVX512, float>
+    {
+        static const bool supported = true;
+        static const size_t width = 16;
+        typedef __m512 type;
+        CMATRIX_SIMD_AVX512 type load(const float *p) { return _mm512_loadu_ps(p); }
+        CMATRIX_SIMD_AVX512 void store(float *p, type a) { _mm512_storeu_ps(p, a); }
+        CMATRIX_SIMD_AVX512 type set1(const float &v) { return _mm512_set1_ps(v); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<ADD>) { return _mm512_add_ps(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<SUB>) { return _mm512_sub_ps(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<MUL>) { return _mm512_mul_ps(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<DIV>) { return _mm512_div_ps(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX512 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm512_cmp_ps_mask(a, b, cmp_imm<C>::fp); }
+    };
+
+    template <>
+    struct reg<AVX512, double>
+    {
+        static const bool supported = true;
+        static const size_t width = 8;
+        typedef __m512d type;
+        CMATRIX_SIMD_AVX512 type load(const double *p) { return _mm512_loadu_pd(p); }
+        CMATRIX_SIMD_AVX512 void store(double *p, type a) { _mm512_storeu_pd(p, a); }
+        CMATRIX_SIMD_AVX512 type set1(const double &v) { return _mm512_set1_pd(v); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<ADD>) { return _mm512_add_pd(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<SUB>) { return _mm512_sub_pd(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<MUL>) { return _mm512_mul_pd(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<DIV>) { return _mm512_div_pd(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX512 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm512_cmp_pd_mask(a, b, cmp_imm<C>::fp); }
+    };
+
+    template <>
+    struct reg<AVX512, std::int32_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 16;
+        typedef __m512i type;
+        CMATRIX_SIMD_AVX512 type load(const std::int32_t *p) { return _mm512_loadu_si512(p); }
+        CMATRIX_SIMD_AVX512 void store(std::int32_t *p, type a) { _mm512_storeu_si512(p, a); }
+        CMATRIX_SIMD_AVX512 type set1(const std::int32_t &v) { return _mm512_set1_epi32(v); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<ADD>) { return _mm512_add_epi32(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<SUB>) { return _mm512_sub_epi32(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<MUL>) { return _mm512_mullo_epi32(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX512 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm512_cmp_epi32_mask(a, b, cmp_imm<C>::integer); }
+    };
+
+    template <>
+    struct reg<AVX512, std::int64_t>
+    {
+        static const bool supported = true;
+        static const size_t width = 8;
+        typedef __m512i type;
+        CMATRIX_SIMD_AVX512 type load(const std::int64_t *p) { return _mm512_loadu_si512(p); }
+        CMATRIX_SIMD_AVX512 void store(std::int64_t *p, type a) { _mm512_storeu_si512(p, a); }
+        CMATRIX_SIMD_AVX512 type set1(const std::int64_t &v) { return _mm512_set1_epi64(v); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<ADD>) { return _mm512_add_epi64(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<SUB>) { return _mm512_sub_epi64(a, b); }
+        CMATRIX_SIMD_AVX512 type apply(type a, type b, op_tag<MUL>) { return _mm512_mullo_epi64(a, b); }
+        template <cmp C>
+        CMATRIX_SIMD_AVX512 std::uint64_t bits(type a, type b, cmp_tag<C>) { return _mm512_cmp_epi64_mask(a, b, cmp_imm<C>::integer); }
+    };
+
+    // ==================================================
+    // VECTOR KERNELS
+
+    /**
+     * @brief The kernels compiled for SSE4.2.
+     * Each kernel processes the cells by registers, then the remaining cells one by one.
+     * The comparisons process the cells by words of the mask, then the remaining cells one by one.
+     */
+    struct sse42_kernels
+    {
+        template <class T, op O>
+        __attribute__((target("sse4.2"))) static void binary(const T *a, const T *b, T *out, const size_t &n)
+        {
+            typedef reg<SSE42, T> R;
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), R::load(b + i), op_tag<O>()));
+
+            scalar_kernels::binary<T, O>(a + i, b + i, out + i, n - i);
+        }
+
+        template <class T, op O>
+        __attribute__((target("sse4.2"))) static void scalar(const T *a, const T &b, T *out, const size_t &n)
+        {
+            typedef reg<SSE42, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), vb, op_tag<O>()));
+
+            scalar_kernels::scalar<T, O>(a + i, b, out + i, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("sse4.2"))) static void compare(const T *a, const T *b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<SSE42, T> R;
+            size_t i = 0;
+
+            // Each word of the mask gathers the bits of 64 / width registers
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), R::load(b + i + j), cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare<T, C>(a + i, b + i, out + i / 64, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("sse4.2"))) static void compare_scalar(const T *a, const T &b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<SSE42, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), vb, cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare_scalar<T, C>(a + i, b, out + i / 64, n - i);
+        }
+    };
+
+    /**
+     * @brief The kernels compiled for AVX2.
+     * Each kernel processes the cells by registers, then the remaining cells one by one.
+     * The comparisons process the cells by words of the mask, then the remaining cells one by one.
+     */
+    struct avx2_kernels
+    {
+        template <class T, op O>
+        __attribute__((target("avx2"))) static void binary(const T *a, const T *b, T *out, const size_t &n)
+        {
+            typedef reg<AVX2, T> R;
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), R::load(b + i), op_tag<O>()));
+
+            scalar_kernels::binary<T, O>(a + i, b + i, out + i, n - i);
+        }
+
+        template <class T, op O>
+        __attribute__((target("avx2"))) static void scalar(const T *a, const T &b, T *out, const size_t &n)
+        {
+            typedef reg<AVX2, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), vb, op_tag<O>()));
+
+            scalar_kernels::scalar<T, O>(a + i, b, out + i, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("avx2"))) static void compare(const T *a, const T *b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<AVX2, T> R;
+            size_t i = 0;
+
+            // Each word of the mask gathers the bits of 64 / width registers
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), R::load(b + i + j), cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare<T, C>(a + i, b + i, out + i / 64, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("avx2"))) static void compare_scalar(const T *a, const T &b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<AVX2, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), vb, cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare_scalar<T, C>(a + i, b, out + i / 64, n - i);
+        }
+    };
+
+    /**
+     * @brief The kernels compiled for AVX-512.
+     * Each kernel processes the cells by registers, then the remaining cells one by one.
+     * The comparisons process the cells by words of the mask, then the remaining cells one by one.
+     */
+    struct avx512_kernels
+    {
+        template <class T, op O>
+        __attribute__((target("avx512f,avx512dq"))) static void binary(const T *a, const T *b, T *out, const size_t &n)
+        {
+            typedef reg<AVX512, T> R;
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), R::load(b + i), op_tag<O>()));
+
+            scalar_kernels::binary<T, O>(a + i, b + i, out + i, n - i);
+        }
+
+        template <class T, op O>
+        __attribute__((target("avx512f,avx512dq"))) static void scalar(const T *a, const T &b, T *out, const size_t &n)
+        {
+            typedef reg<AVX512, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + R::width <= n; i += R::width)
+                R::store(out + i, R::apply(R::load(a + i), vb, op_tag<O>()));
+
+            scalar_kernels::scalar<T, O>(a + i, b, out + i, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("avx512f,avx512dq"))) static void compare(const T *a, const T *b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<AVX512, T> R;
+            size_t i = 0;
+
+            // Each word of the mask gathers the bits of 64 / width registers
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), R::load(b + i + j), cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare<T, C>(a + i, b + i, out + i / 64, n - i);
+        }
+
+        template <class T, cmp C>
+        __attribute__((target("avx512f,avx512dq"))) static void compare_scalar(const T *a, const T &b, std::uint64_t *out, const size_t &n)
+        {
+            typedef reg<AVX512, T> R;
+            const typename R::type vb = R::set1(b);
+            size_t i = 0;
+
+            for (; i + 64 <= n; i += 64)
+            {
+                std::uint64_t word = 0;
+
+                for (size_t j = 0; j < 64; j += R::width)
+                    word |= R::bits(R::load(a + i + j), vb, cmp_tag<C>()) << j;
+
+                out[i / 64] = word;
+            }
+
+            scalar_kernels::compare_scalar<T, C>(a + i, b, out + i / 64, n - i);
+        }
+    };
+#endif
+
+    // ==================================================
+    // DISPATCH
+
+    /**
+     * @brief Select the kernels of an instruction set, or the scalar kernels if the instruction set
+     * has no vector instruction for the type and the operator.
+     */
+    template <isa I, class T, op O, bool = has_kernel<I, T, O>::value>
+    struct kernels
+    {
+        typedef scalar_kernels type;
+    };
+
+#ifdef CMATRIX_SIMD_X86
+    template <class T, op O>
+    struct kernels<SSE42, T, O, true>
+    {
+        typedef sse42_kernels type;
+    };
+
+    template <class T, op O>
+    struct kernels<AVX2, T, O, true>
+    {
+        typedef avx2_kernels type;
+    };
+
+    template <class T, op O>
+    struct kernels<AVX512, T, O, true>
+    {
+        typedef avx512_kernels type;
+    };
+#endif
+
+    /**
+     * @brief Select the comparison kernels of an instruction set, or the scalar kernels if the instruction set
+     * has no vector register for the type.
+     */
+    template <isa I, class T, bool = reg<I, T>::supported>
+    struct compare_kernels
+    {
+        typedef scalar_kernels type;
+    };
+
+#ifdef CMATRIX_SIMD_X86
+    template <class T>
+    struct compare_kernels<SSE42, T, true>
+    {
+        typedef sse42_kernels type;
+    };
+
+    template <class T>
+    struct compare_kernels<AVX2, T, true>
+    {
+        typedef avx2_kernels type;
+    };
+
+    template <class T>
+    struct compare_kernels<AVX512, T, true>
+    {
+        typedef avx512_kernels type;
+    };
+#endif
+
+    /**
+     * @brief Compute out[i] = a[i] O b[i] with the kernel of the detected instruction set.
+     *
+     * @tparam O The operator.
+     * @param a The left operands.
+     * @param b The right operands.
+     * @param out The results. Can be equal to `a` or `b`.
+     * @param n The number of cells.
+     */
+    template <op O, class T>
+    void binary(const T *a, const T *b, T *out, const size_t &n)
+    {
+        switch (level())
+        {
+        case AVX512:
+            return kernels<AVX512, T, O>::type::template binary<T, O>(a, b, out, n);
+        case AVX2:
+            return kernels<AVX2, T, O>::type::template binary<T, O>(a, b, out, n);
+        case SSE42:
+            return kernels<SSE42, T, O>::type::template binary<T, O>(a, b, out, n);
+        default:
+            return scalar_kernels::binary<T, O>(a, b, out, n);
+        }
+    }
+
+    /**
+     * @brief Compute out[i] = a[i] O b with the kernel of the detected instruction set.
+     *
+     * @tparam O The operator.
+     * @param a The left operands.
+     * @param b The right operand.
+     * @param out The results. Can be equal to `a`.
+     * @param n The number of cells.
+     */
+    template <op O, class T>
+    void scalar(const T *a, const T &b, T *out, const size_t &n)
+    {
+        switch (level())
+        {
+        case AVX512:
+            return kernels<AVX512, T, O>::type::template scalar<T, O>(a, b, out, n);
+        case AVX2:
+            return kernels<AVX2, T, O>::type::template scalar<T, O>(a, b, out, n);
+        case SSE42:
+            return kernels<SSE42, T, O>::type::template scalar<T, O>(a, b, out, n);
+        default:
+            return scalar_kernels::scalar<T, O>(a, b, out, n);
+        }
+    }
+
+    /**
+     * @brief Compute the bit i of out = a[i] C b[i] with the kernel of the detected instruction set.
+     *
+     * @tparam C The comparison.
+     * @param a The left operands.
+     * @param b The right operands.
+     * @param out The words of the mask, 64 cells per word. The bits beyond the last cell are cleared.
+     * @param n The number of cells.
+     */
+    template <cmp C, class T>
+    void compare(const T *a, const T *b, std::uint64_t *out, const size_t &n)
+    {
+        switch (level())
+        {
+        case AVX512:
+            return compare_kernels<AVX512, T>::type::template compare<T, C>(a, b, out, n);
+        case AVX2:
+            return compare_kernels<AVX2, T>::type::template compare<T, C>(a, b, out, n);
+        case SSE42:
+            return compare_kernels<SSE42, T>::type::template compare<T, C>(a, b, out, n);
+        default:
+            return scalar_kernels::compare<T, C>(a, b, out, n);
+        }
+    }
+
+    /**
+     * @brief Compute the bit i of out = a[i] C b with the kernel of the detected instruction set.
+     *
+     * @tparam C The comparison.
+     * @param a The left operands.
+     * @param b The right operand.
+     * @param out The words of the mask, 64 cells per word. The bits beyond the last cell are cleared.
+     * @param n The number of cells.
+     */
+    template <cmp C, class T>
+    void compare_scalar(const T *a, const T &b, std::uint64_t *out, const size_t &n)
+    {
+        switch (level())
+        {
+        case AVX512:
+            return compare_kernels<AVX512, T>::type::template compare_scalar<T, C>(a, b, out, n);
+        case AVX2:
+            return compare_kernels<AVX2, T>::type::template compare_scalar<T, C>(a, b, out, n);
+        case SSE42:
+            return compare_kernels<SSE42, T>::type::template compare_scalar<T, C>(a, b, out, n);
+        default:
+            return scalar_kernels::compare_scalar<T, C>(a, b, out, n);
+        }
+    }
+}
+
+#endif // CMATRIX_SIMD_HPP
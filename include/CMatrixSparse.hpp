@@ -0,0 +1,277 @@
+/**
+ * @file CMatrixSparse.hpp
+ * @brief This file contains the definition of the csr_matrix class.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_SPARSE_HPP
+#define CMATRIX_SPARSE_HPP
+
+// INCLUDES
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CMatrixLayout.hpp"
+
+/**
+ * @brief A sparse matrix in the compressed sparse row format.
+ *
+ * @details Only the nonzero cells are stored, row by row: their columns and values, and for each row
+ *          the position of its first cell. So the memory and the time of the operations scale with the
+ *          number of nonzero cells, instead of the number of cells.
+ *
+ * @tparam T The type of elements in the matrix.
+ */
+template <class T>
+class csr_matrix
+{
+private:
+    // ATTRIBUTES
+    size_t m_height = 0;
+    size_t m_width = 0;
+    std::vector<size_t> m_row_ptr = std::vector<size_t>(1, 0);
+    std::vector<size_t> m_col_ids = std::vector<size_t>();
+    std::vector<T> m_values = std::vector<T>();
+
+    // CHECK METHODS
+    /**
+     * @brief Check if the index is a valid row index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid row index.
+     */
+    void __check_valid_row_id(const size_t &n) const;
+    /**
+     * @brief Check if the index is a valid column index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid column index.
+     */
+    void __check_valid_col_id(const size_t &n) const;
+
+public:
+    // CONSTRUCTORS
+    /**
+     * @brief Construct an empty sparse matrix.
+     */
+    csr_matrix() {}
+    /**
+     * @brief Construct a sparse matrix without nonzero cell.
+     *
+     * @param height The number of rows.
+     * @param width The number of columns.
+     */
+    csr_matrix(const size_t &height, const size_t &width);
+    /**
+     * @brief Construct a sparse matrix from the nonzero cells of a matrix.
+     *
+     * @param m The matrix.
+     *
+     * @code
+     * $ cmatrix<int> m = {{0, 2}, {3, 0}};
+     * $ csr_matrix<int>(m).nnz();
+     * > 2
+     * @endcode
+     */
+    explicit csr_matrix(const cmatrix<T> &m);
+    /**
+     * @brief Build a sparse matrix from a list of cells in the coordinate format.
+     * The cells can be in any order. The values of the cells with the same coordinates are summed.
+     *
+     * @param height The number of rows.
+     * @param width The number of columns.
+     * @param rows The row of each cell.
+     * @param cols The column of each cell.
+     * @param values The value of each cell.
+     * @return csr_matrix<T> The sparse matrix.
+     * @throw std::invalid_argument If the lists don't have the same size.
+     * @throw std::out_of_range If a row or a column is out of range.
+     *
+     * @code
+     * $ csr_matrix<int>::from_coo(2, 2, {1, 0, 1}, {0, 1, 0}, {3, 2, 1}).to_cmatrix();
+     * > [[0, 2], [4, 0]]
+     * @endcode
+     */
+    static csr_matrix<T> from_coo(const size_t &height, const size_t &width,
+                                  const std::vector<size_t> &rows,
+                                  const std::vector<size_t> &cols,
+                                  const std::vector<T> &values);
+
+    // GETTERS
+    /**
+     * @brief Get the number of rows of the matrix.
+     *
+     * @return size_t The number of rows.
+     */
+    size_t height() const;
+    /**
+     * @brief Get the number of columns of the matrix.
+     *
+     * @return size_t The number of columns.
+     */
+    size_t width() const;
+    /**
+     * @brief Get the dimensions of the matrix.
+     *
+     * @return std::pair<size_t, size_t> The number of rows and the number of columns.
+     */
+    std::pair<size_t, size_t> size() const;
+    /**
+     * @brief Get the number of stored cells.
+     *
+     * @return size_t The number of nonzero cells.
+     */
+    size_t nnz() const;
+    /**
+     * @brief Check if the matrix has no cell.
+     *
+     * @return bool True if the matrix has no row or no column.
+     */
+    bool is_empty() const;
+    /**
+     * @brief Get the position of the first stored cell of each row, followed by the number of stored cells.
+     *
+     * @return const std::vector<size_t>& The positions of the rows.
+     */
+    const std::vector<size_t> &row_ptr() const;
+    /**
+     * @brief Get the column of each stored cell, row by row.
+     *
+     * @return const std::vector<size_t>& The columns.
+     */
+    const std::vector<size_t> &col_ids() const;
+    /**
+     * @brief Get the value of each stored cell, row by row.
+     *
+     * @return const std::vector<T>& The values.
+     */
+    const std::vector<T> &values() const;
+    /**
+     * @brief Get a cell of the matrix. The cell is searched in the columns of its row.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return T The cell, or T() if it is not stored.
+     * @throw std::out_of_range If the index is out of range.
+     */
+    T cell(const size_t &row, const size_t &col) const;
+
+    // CONVERSION METHODS
+    /**
+     * @brief Convert the sparse matrix to a dense matrix.
+     *
+     * @return cmatrix<T> The dense matrix.
+     */
+    cmatrix<T> to_cmatrix() const;
+
+    // MATH METHODS
+    /**
+     * @brief Get the product of the matrix by a vector.
+     *
+     * @param x The vector. Its size must be the number of columns.
+     * @return std::vector<T> The product.
+     * @throw std::invalid_argument If the size of the vector is not the number of columns.
+     *
+     * @code
+     * $ csr_matrix<int>(cmatrix<int>({{0, 2}, {3, 0}})).matvec({1, 2});
+     * > {4, 3}
+     * @endcode
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    std::vector<T> matvec(const std::vector<T> &x) const;
+    /**
+     * @brief Get the product of the matrix by a dense matrix.
+     * Each stored cell adds a multiple of a row of the dense matrix to a row of the result.
+     *
+     * @param m The dense matrix.
+     * @return cmatrix<T> The product.
+     * @throw std::invalid_argument If the number of columns is not equal to the number of rows of `m`.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    cmatrix<T> matmul(const cmatrix<T> &m) const;
+    /**
+     * @brief Get the transpose of the matrix.
+     *
+     * @return csr_matrix<T> The transposed matrix.
+     */
+    csr_matrix<T> transpose() const;
+
+    // STATISTICS METHODS
+    /**
+     * @brief Compute the sum of each row (axis: 0) or column (axis: 1) of the matrix.
+     *
+     * @param axis The axis of the sum. 0 for the rows, 1 for the columns. (default: 0)
+     * @param zero The zero value of the sum. (default: T())
+     * @return cmatrix<T> The sums.
+     * @throw std::invalid_argument If the axis is not 0 or 1.
+     *
+     * @see cmatrix::sum
+     */
+    cmatrix<T> sum(const unsigned int &axis = 0, const T &zero = T()) const;
+    /**
+     * @brief Get the maximum value of each row (axis: 0) or column (axis: 1) of the matrix.
+     * The cells which are not stored count as T().
+     *
+     * @param axis The axis of the maximum. 0 for the rows, 1 for the columns. (default: 0)
+     * @return cmatrix<T> The maximum values.
+     * @throw std::invalid_argument If the axis is not 0 or 1.
+     *
+     * @see cmatrix::max
+     */
+    cmatrix<T> max(const unsigned int &axis = 0) const;
+
+    // OPERATORS
+    /**
+     * @brief Multiply each cell by a value. The zeros stay zeros, so only the stored cells are computed.
+     *
+     * @param n The value.
+     * @return csr_matrix<T> The product.
+     */
+    csr_matrix<T> operator*(const T &n) const;
+    /**
+     * @brief Divide each cell by a value. The zeros stay zeros, so only the stored cells are computed.
+     *
+     * @param n The value.
+     * @return csr_matrix<T> The quotient.
+     * @throw std::invalid_argument If the value is 0.
+     */
+    csr_matrix<T> operator/(const T &n) const;
+    /**
+     * @brief Add a value to each cell. The zeros become the value, so the result is dense.
+     *
+     * @param n The value.
+     * @return cmatrix<T> The sum.
+     */
+    cmatrix<T> operator+(const T &n) const;
+    /**
+     * @brief Subtract a value from each cell. The zeros become the opposite of the value, so the result is dense.
+     *
+     * @param n The value.
+     * @return cmatrix<T> The difference.
+     */
+    cmatrix<T> operator-(const T &n) const;
+    /**
+     * @brief Multiply each stored cell by a value.
+     *
+     * @param n The value.
+     * @return csr_matrix<T>& The matrix.
+     */
+    csr_matrix<T> &operator*=(const T &n);
+    /**
+     * @brief Divide each stored cell by a value.
+     *
+     * @param n The value.
+     * @return csr_matrix<T>& The matrix.
+     * @throw std::invalid_argument If the value is 0.
+     */
+    csr_matrix<T> &operator/=(const T &n);
+};
+
+#endif // CMATRIX_SPARSE_HPP
@@ -0,0 +1,473 @@
+/**
+ * @file CMatrixTask.hpp
+ * @brief This file contains the tasks of the recursive kernels, and the work-stealing scheduler running them.
+ *
+ * @details A recursive kernel splits its work in halves, spawns a task for one half and computes the other
+ *          one, then waits for the task. The parallel loops divide the work in equal parts beforehand, so
+ *          they balance badly the blocks of uneven costs of a recursion: the tasks are taken by the idle
+ *          threads as they come. The tasks run:
+ *          - on the cmatrix_task::scheduler set as pool of the execution policy: each thread pushes its tasks
+ *            on its own deque, runs them last in first out, and steals the oldest tasks of the others when
+ *            its deque is empty. The thread waiting for its tasks runs tasks meanwhile.
+ *          - as OpenMP tasks with the OpenMP policy.
+ *          - on the spawning thread with the serial policy, other pools, and under the thresholds.
+ *          The spawns and syncs can be used in the tasks of an application working on blocks of a matrix.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_TASK_HPP
+#define CMATRIX_TASK_HPP
+
+// INCLUDES
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CMatrixExec.hpp"
+#include "CMatrixParallel.hpp"
+
+namespace cmatrix_task
+{
+    class scheduler;
+
+    /**
+     * @brief Where the tasks spawned by a thread go: the deque of a scheduler, the OpenMP team, or nowhere.
+     */
+    struct context
+    {
+        scheduler *owner;
+        size_t index;
+        bool openmp;
+    };
+
+    /**
+     * @brief The context of the thread. Outside of any scheduler and OpenMP team, the tasks run when spawned.
+     */
+    inline context &__context()
+    {
+        static thread_local context current = {nullptr, 0, false};
+        return current;
+    }
+
+    /**
+     * @brief Set the context of the thread until the end of the scope.
+     */
+    struct context_guard
+    {
+        context m_previous;
+
+        explicit context_guard(const context &c) : m_previous(__context()) { __context() = c; }
+        ~context_guard() { __context() = m_previous; }
+    };
+
+    /**
+     * @brief A deque of tasks. Its thread pushes and pops the tasks at the back, the other threads steal them at the front.
+     */
+    class deque
+    {
+    private:
+        // ATTRIBUTES
+        std::mutex m_mutex;
+        std::deque<std::function<void()>> m_tasks;
+
+    public:
+        void push(std::function<void()> &&task)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+
+        /**
+         * @brief Take the newest task: its data is still in the cache of the thread.
+         *
+         * @param task The task taken.
+         * @return bool False if the deque is empty.
+         */
+        bool pop(std::function<void()> &task)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_tasks.empty())
+                return false;
+
+            task = std::move(m_tasks.back());
+            m_tasks.pop_back();
+            return true;
+        }
+
+        /**
+         * @brief Take the oldest task: the biggest part of the work left in a recursion.
+         *
+         * @param task The task taken.
+         * @return bool False if the deque is empty.
+         */
+        bool steal(std::function<void()> &task)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_tasks.empty())
+                return false;
+
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            return true;
+        }
+    };
+
+    /**
+     * @brief A pool of threads with a deque of tasks each, taking the tasks of the others when idle.
+     * Set it as pool of the execution policy to run the parallel loops and the recursive kernels on it.
+     * The threads calling the library from outside of the pool share a deque, and run tasks while they wait.
+     *
+     * @code
+     * $ cmatrix_task::scheduler tasks(8);
+     * $ cmatrix_exec::set_policy(cmatrix_exec::thread_pool(tasks));
+     * $ cmatrix<float> t(m.width(), m.height());
+     * $ m.transpose_into(t); // The halves of the matrix are stolen by the idle threads
+     * @endcode
+     */
+    class scheduler : public cmatrix_exec::pool
+    {
+    private:
+        // ATTRIBUTES
+        std::vector<std::unique_ptr<deque>> m_deques;
+        std::vector<std::thread> m_workers;
+        std::atomic<size_t> m_queued;
+        std::atomic<size_t> m_sleeping;
+        std::atomic<bool> m_stop;
+        std::mutex m_sleep;
+        std::condition_variable m_wake;
+
+        /**
+         * @brief The loop of a thread of the pool: run its tasks and steal the others, sleep when there are none.
+         * The parallel loops called by the tasks run on their thread.
+         */
+        void __work(const size_t index)
+        {
+            context_guard c({this, index, false});
+            cmatrix_exec::task_guard guard;
+            std::function<void()> task;
+
+            while (true)
+            {
+                if (__find(index, task))
+                {
+                    task();
+                    task = nullptr;
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_sleep);
+                m_sleeping++;
+                m_wake.wait(lock, [this]
+                            { return m_stop or m_queued > 0; });
+                m_sleeping--;
+
+                if (m_stop)
+                    return;
+            }
+        }
+
+    public:
+        /**
+         * @brief Start the threads of the pool.
+         *
+         * @param threads The number of threads, counting the calling thread. (default: the number of cores)
+         */
+        explicit scheduler(const size_t &threads = std::max(std::thread::hardware_concurrency(), 1u))
+            : m_queued(0), m_sleeping(0), m_stop(false)
+        {
+            // The deque 0 is shared by the threads outside of the pool
+            for (size_t i = 0; i < std::max(threads, size_t(1)); i++)
+                m_deques.emplace_back(new deque());
+
+            for (size_t i = 1; i < m_deques.size(); i++)
+                m_workers.emplace_back(&scheduler::__work, this, i);
+        }
+
+        scheduler(const scheduler &) = delete;
+        scheduler &operator=(const scheduler &) = delete;
+
+        /**
+         * @brief Stop and join the threads of the pool. No task must be left.
+         */
+        ~scheduler()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_sleep);
+                m_stop = true;
+            }
+
+            m_wake.notify_all();
+
+            for (std::thread &worker : m_workers)
+                worker.join();
+        }
+
+        size_t size() const { return m_deques.size(); }
+
+        /**
+         * @brief Spawn the tasks, and run tasks until they are done.
+         *
+         * @param tasks The number of tasks.
+         * @param task The task.
+         * @throw The first exception thrown by the tasks.
+         */
+        void run(const size_t &tasks, const std::function<void(size_t)> &task);
+
+        /**
+         * @brief Push a task on a deque, and wake a sleeping thread.
+         */
+        void __push(const size_t &index, std::function<void()> &&task)
+        {
+            m_deques[index]->push(std::move(task));
+            m_queued++;
+
+            // A thread going to sleep counts itself before checking the tasks: it is either woken or sees the task
+            if (m_sleeping > 0)
+            {
+                std::lock_guard<std::mutex> lock(m_sleep);
+                m_wake.notify_one();
+            }
+        }
+
+        /**
+         * @brief Take a task from a deque, or steal one from the other deques.
+         */
+        bool __find(const size_t &index, std::function<void()> &task)
+        {
+            if (m_queued == 0)
+                return false;
+
+            for (size_t i = 0; i < m_deques.size(); i++)
+            {
+                const size_t victim = (index + i) % m_deques.size();
+
+                if (i == 0 ? m_deques[victim]->pop(task) : m_deques[victim]->steal(task))
+                {
+                    m_queued--;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    /**
+     * @brief A group of tasks: the tasks spawned in it, waited by sync().
+     * The tasks of a group can spawn tasks in their own groups.
+     *
+     * @code
+     * $ void sum_rows(const cmatrix<float> &m, size_t first, size_t last, float *out)
+     * $ {
+     * $     if (last - first <= 64)
+     * $         return ...;
+     * $
+     * $     cmatrix_task::group g;
+     * $     g.spawn([&] { sum_rows(m, first, (first + last) / 2, out); });
+     * $     sum_rows(m, (first + last) / 2, last, out);
+     * $     g.sync();
+     * $ }
+     * @endcode
+     */
+    class group
+    {
+    private:
+        // ATTRIBUTES
+        std::atomic<size_t> m_pending;
+        std::mutex m_mutex;
+        std::exception_ptr m_error;
+
+        /**
+         * @brief Call a task, keeping its exception for sync().
+         */
+        template <class F>
+        void __call(const F &f)
+        {
+            try
+            {
+                f();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                if (not m_error)
+                    m_error = std::current_exception();
+            }
+        }
+
+        /**
+         * @brief Wait for the tasks of the group, running the tasks of the scheduler meanwhile.
+         */
+        void __wait()
+        {
+            const context c = __context();
+
+            if (c.owner)
+            {
+                std::function<void()> task;
+
+                while (m_pending > 0)
+                {
+                    if (c.owner->__find(c.index, task))
+                    {
+                        cmatrix_exec::task_guard guard;
+                        task();
+                        task = nullptr;
+                    }
+
+                    else
+                        std::this_thread::yield();
+                }
+            }
+
+            else if (c.openmp)
+            {
+                #pragma omp taskwait
+            }
+        }
+
+    public:
+        group() : m_pending(0) {}
+
+        group(const group &) = delete;
+        group &operator=(const group &) = delete;
+
+        /**
+         * @brief Wait for the tasks left. Their exceptions are lost.
+         */
+        ~group() { __wait(); }
+
+        /**
+         * @brief Spawn a task: another thread may run it, until sync() returns.
+         * Outside of a scheduler and of an OpenMP team, the task runs now.
+         *
+         * @param f The task, copied. The data it references must live until sync().
+         */
+        template <class F>
+        void spawn(const F &f)
+        {
+            const context c = __context();
+
+            if (c.owner)
+            {
+                m_pending++;
+                c.owner->__push(c.index, [this, f]()
+                                { __call(f);
+                                  m_pending--; });
+            }
+
+            else if (c.openmp)
+            {
+                F task = f;
+
+                #pragma omp task firstprivate(task)
+                __call(task);
+            }
+
+            else
+                __call(f);
+        }
+
+        /**
+         * @brief Wait for the tasks spawned in the group. The thread runs the other tasks meanwhile.
+         *
+         * @throw The first exception thrown by the tasks.
+         */
+        void sync()
+        {
+            __wait();
+
+            std::exception_ptr error;
+            std::swap(error, m_error);
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+    };
+
+    inline void scheduler::run(const size_t &tasks, const std::function<void(size_t)> &task)
+    {
+        // A thread outside of the pool pushes the tasks on the shared deque
+        context_guard c(__context().owner == this ? __context() : context{this, 0, false});
+        group g;
+
+        for (size_t i = 0; i < tasks; i++)
+            g.spawn([&task, i]()
+                    { task(i); });
+
+        g.sync();
+    }
+
+    /**
+     * @brief Run a recursive computation spawning tasks, with the execution policy of the thread.
+     * Called from a task, the computation spawns its tasks in the same scheduler or OpenMP team.
+     *
+     * @param k The kind of the computation.
+     * @param work The estimated work of the computation, in units of work of the kind. Under the threshold
+     *             of the kind, the tasks run when spawned. (see CMatrixParallel.hpp)
+     * @param f The computation.
+     * @throw The exception thrown by the computation.
+     *
+     * @code
+     * $ cmatrix_task::run(cmatrix_parallel::REDUCTION, m.height() * m.width(), [&] { sum_rows(m, 0, m.height(), out); });
+     * @endcode
+     */
+    template <class F>
+    void run(const cmatrix_parallel::kind &k, const size_t &work, const F &f)
+    {
+        if (__context().owner or __context().openmp)
+            return f();
+
+        const cmatrix_exec::policy p = cmatrix_exec::current();
+        scheduler *s = p.type == cmatrix_exec::THREAD_POOL ? dynamic_cast<scheduler *>(p.workers) : nullptr;
+        const int max = s ? cmatrix_parallel::threads(s->size()) : p.type == cmatrix_exec::OPENMP ? cmatrix_parallel::threads() : 1;
+
+        if (cmatrix_parallel::team(k, work, max) <= 1)
+            return f();
+
+        if (s)
+        {
+            context_guard c({s, 0, false});
+            return f();
+        }
+
+        // An exception can't leave the parallel region: it is rethrown after it
+        std::exception_ptr error;
+
+        #pragma omp parallel num_threads(cmatrix_parallel::team(k, work, max))
+        {
+            context_guard c({nullptr, 0, true});
+
+            #pragma omp single
+            {
+                try
+                {
+                    f();
+                }
+                catch (...)
+                {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+#endif // CMATRIX_TASK_HPP
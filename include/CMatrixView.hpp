@@ -0,0 +1,311 @@
+/**
+ * @file CMatrixView.hpp
+ * @brief This file contains the definition of the cmatrix_view class.
+ *
+ * @author Manitas Bahri <https://github.com/b-manitas>
+ * @date 2023
+ * @license MIT License
+ */
+
+#ifndef CMATRIX_VIEW_HPP
+#define CMATRIX_VIEW_HPP
+
+// INCLUDES
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "CMatrixExpr.hpp"
+
+/**
+ * @brief A read-only view on the cells of a matrix, without copy.
+ *
+ * @details A view is described by its first cell, its dimensions and the distances between two rows
+ *          and two columns in the buffer. So slicing rows or columns, or transposing a view, costs O(1).
+ *          A view is an expression: it can be used with the arithmetic operators, compared to a matrix
+ *          and assigned to a matrix to get a copy of its cells.
+ *
+ * @warning The view references the buffer of the matrix. It is invalidated when the matrix is
+ *          destroyed, or when its dimensions change, or when it is modified while its buffer is shared
+ *          with a copy: the modified matrix then moves to a new buffer. The cells of a small matrix are
+ *          stored in the matrix object, so moving the matrix also invalidates its views. (see CMatrixInline.hpp)
+ *
+ * @tparam T The type of elements in the view.
+ */
+template <class T>
+class cmatrix_view : public cmatrix_expr::expr<cmatrix_view<T>, T>
+{
+private:
+    // ATTRIBUTES
+    const T *m_data = nullptr;
+    size_t m_height = 0;
+    size_t m_width = 0;
+    size_t m_row_stride = 0;
+    size_t m_col_stride = 0;
+
+    // CHECK METHODS
+    /**
+     * @brief Check if the index is a valid row index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid row index.
+     */
+    void __check_valid_row_id(const size_t &n) const;
+    /**
+     * @brief Check if the index is a valid column index.
+     *
+     * @param n The index to check.
+     * @throw std::out_of_range If the index is not a valid column index.
+     */
+    void __check_valid_col_id(const size_t &n) const;
+
+public:
+    // CONSTRUCTORS
+    /**
+     * @brief Construct an empty view.
+     */
+    cmatrix_view() {}
+    /**
+     * @brief Construct a view on a buffer.
+     *
+     * @param data The first cell of the view.
+     * @param height The number of rows.
+     * @param width The number of columns.
+     * @param row_stride The distance between two rows in the buffer.
+     * @param col_stride The distance between two columns in the buffer.
+     */
+    cmatrix_view(const T *data, const size_t &height, const size_t &width, const size_t &row_stride, const size_t &col_stride);
+
+    // GETTERS
+    /**
+     * @brief Get the number of rows of the view.
+     *
+     * @return size_t The number of rows.
+     */
+    size_t height() const;
+    /**
+     * @brief Get the number of columns of the view.
+     *
+     * @return size_t The number of columns.
+     */
+    size_t width() const;
+    /**
+     * @brief Get the dimensions of the view.
+     *
+     * @return std::pair<size_t, size_t> The number of rows and the number of columns.
+     */
+    std::pair<size_t, size_t> size() const;
+    /**
+     * @brief Check if the view has no cell.
+     *
+     * @return bool True if the view has no row or no column.
+     */
+    bool is_empty() const;
+    /**
+     * @brief Get the distance between two rows in the buffer.
+     *
+     * @return size_t The distance between two rows.
+     */
+    size_t row_stride() const;
+    /**
+     * @brief Get the distance between two columns in the buffer.
+     *
+     * @return size_t The distance between two columns.
+     */
+    size_t col_stride() const;
+    /**
+     * @brief Get the first cell of the view.
+     *
+     * @return const T* The first cell.
+     */
+    const T *data() const;
+    /**
+     * @brief Get a cell of the view, without checking the indexes.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return const T& The cell.
+     */
+    const T &operator()(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Repeat the single row or column of the view to the dimensions of the result of an operator.
+     * The strides of the repeated axis are set to 0, so the cells are not copied.
+     *
+     * @param height The number of rows of the result.
+     * @param width The number of columns of the result.
+     */
+    void broadcast_to(const size_t &height, const size_t &width);
+    /**
+     * @brief Check if the view reads cells of a buffer, so an expression using it can't be evaluated in this buffer.
+     *
+     * @param begin The first cell of the buffer.
+     * @param end The end of the buffer.
+     * @return bool True if a cell of the view is in the buffer.
+     */
+    bool overlaps(const T *begin, const T *end) const;
+    /**
+     * @brief Get a cell of the view.
+     *
+     * @param row The row of the cell.
+     * @param col The column of the cell.
+     * @return const T& The cell.
+     * @throw std::out_of_range If the index is out of range.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.view().cell(1, 0);
+     * > 3
+     * @endcode
+     */
+    const T &cell(const size_t &row, const size_t &col) const;
+    /**
+     * @brief Get a view on the rows between two indexes.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @return cmatrix_view<T> The view on the rows.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}, {5, 6}};
+     * $ m.view().slice_rows(1, 2);
+     * > [[3, 4], [5, 6]]
+     * @endcode
+     */
+    cmatrix_view<T> slice_rows(const size_t &start, const size_t &end) const;
+    /**
+     * @brief Get a view on the columns between two indexes.
+     *
+     * @param start The start index inclusive.
+     * @param end The end index inclusive.
+     * @return cmatrix_view<T> The view on the columns.
+     * @throw std::out_of_range If the index is out of range.
+     * @throw std::invalid_argument If the start index is greater than the end index.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+     * $ m.view().slice_columns(1, 2);
+     * > [[2, 3], [5, 6]]
+     * @endcode
+     */
+    cmatrix_view<T> slice_columns(const size_t &start, const size_t &end) const;
+    /**
+     * @brief Get a view on a row.
+     *
+     * @param n The index of the row.
+     * @return cmatrix_view<T> The view on the row.
+     * @throw std::out_of_range If the index is out of range.
+     */
+    cmatrix_view<T> row(const size_t &n) const;
+    /**
+     * @brief Get a view on a column.
+     *
+     * @param n The index of the column.
+     * @return cmatrix_view<T> The view on the column.
+     * @throw std::out_of_range If the index is out of range.
+     */
+    cmatrix_view<T> column(const size_t &n) const;
+    /**
+     * @brief Get the transposed view, by swapping the dimensions and the strides.
+     *
+     * @return cmatrix_view<T> The transposed view.
+     *
+     * @code
+     * $ cmatrix<int> m = {{1, 2}, {3, 4}};
+     * $ m.view().transpose();
+     * > [[1, 3], [2, 4]]
+     * @endcode
+     */
+    cmatrix_view<T> transpose() const;
+
+    // READ-ONLY OPERATIONS
+    /**
+     * @brief Copy the cells of the view in a new matrix.
+     *
+     * @return cmatrix<T> The copied matrix.
+     */
+    cmatrix<T> copy() const;
+    /**
+     * @brief Compute the sum of each row (axis: 0) or column (axis: 1) of the view.
+     *
+     * @param axis The axis of the sum. 0 for the rows, 1 for the columns. (default: 0)
+     * @param zero The zero value of the type. (default: T())
+     * @return cmatrix<T> The sums.
+     * @throw std::invalid_argument If the axis is not 0 or 1.
+     *
+     * @see cmatrix::sum
+     */
+    cmatrix<T> sum(const unsigned int &axis = 0, const T &zero = T()) const;
+    /**
+     * @brief Apply a function to each cell of the view, in a new matrix.
+     *
+     * @param f The function to apply.
+     * @return cmatrix<T> The mapped matrix.
+     *
+     * @see cmatrix::map
+     */
+    cmatrix<T> map(const std::function<T(T)> &f) const;
+    /**
+     * @brief Apply a function to each cell of the view, in a new matrix.
+     *
+     * @param f The function to apply. f(T value, size_t row, size_t col) -> T
+     * @return cmatrix<T> The mapped matrix.
+     *
+     * @see cmatrix::map
+     */
+    cmatrix<T> map(const std::function<T(T, size_t, size_t)> &f) const;
+    /**
+     * @brief Get the product with another view, without copying the operands.
+     *
+     * @param m The view to multiply.
+     * @return cmatrix<T> The result of the product.
+     * @throw std::invalid_argument If the number of columns of the view is not equal to the number of rows of `m`.
+     *
+     * @note The product is computed by the cache blocked engine of CMatrixGemm.tpp.
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    cmatrix<T> matmul(const cmatrix_view<T> &m) const;
+    /**
+     * @brief Get the product with a matrix, without copying the operands.
+     *
+     * @param m The matrix to multiply.
+     * @tparam Layout The layout of the matrix.
+     * @return cmatrix<T> The result of the product.
+     * @throw std::invalid_argument If the number of columns of the view is not equal to the number of rows of `m`.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    template <class Layout>
+    cmatrix<T> matmul(const cmatrix<T, Layout> &m) const;
+    /**
+     * @brief Write the product with another view in a matrix, without allocating it.
+     *
+     * @param out The matrix receiving the product. Its dimensions must be the dimensions of the product.
+     * @param m The view to multiply.
+     * @tparam Layout The layout of the matrix receiving the product.
+     * @throw std::invalid_argument If the number of columns of the view is not equal to the number of rows of `m`.
+     * @throw std::invalid_argument If the dimensions of the matrix `out` are not the dimensions of the product.
+     * @throw std::invalid_argument If the matrix `out` shares its cells with an operand.
+     *
+     * @note PARALLELIZED METHOD with OpenMP.
+     */
+    template <class Layout>
+    void matmul_into(cmatrix<T, Layout> &out, const cmatrix_view<T> &m) const;
+};
+
+namespace cmatrix_expr
+{
+    // The views are operands of the arithmetic operators
+    template <class T>
+    struct operand<cmatrix_view<T>>
+    {
+        static const bool value = true;
+        typedef T value_type;
+        typedef cmatrix_view<T> type;
+        static const type &wrap(const type &e) { return e; }
+    };
+}
+
+#endif // CMATRIX_VIEW_HPP
@@ -12,119 +12,219 @@
 // ==================================================
 // GENERAL FUNCTIONS
 
-template <class T>
-void cmatrix<T>::print() const
+template <class T, class Layout>
+void cmatrix<T, Layout>::print() const
 {
     std::cout << *this << std::endl;
 }
 
-template <class T>
-void cmatrix<T>::clear()
+template <class T, class Layout>
+void cmatrix<T, Layout>::clear()
 {
-    matrix = std::vector<std::vector<T>>();
+    matrix = storage_type();
+    m_height = 0;
+    m_width = 0;
+    m_stride = 0;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::copy() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::copy() const
 {
     return *this;
 }
 
-template <class T>
-void cmatrix<T>::apply(const std::function<T(T, size_t, size_t)> &f)
+template <class T, class Layout>
+void cmatrix<T, Layout>::apply(const std::function<T(T, size_t, size_t)> &f)
+{
+    // The template overload is named explicitly, so this overload doesn't call itself
+    apply<const std::function<T(T, size_t, size_t)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<void, F, T, size_t, size_t> cmatrix<T, Layout>::apply(F &&f)
 {
     for (size_t r = 0; r < height(); r++)
         for (size_t c = 0; c < width(); c++)
-            set_cell(r, c, f(cell(r, c), r, c));
+            __at(r, c) = f(__at(r, c), r, c);
 }
 
-template <class T>
-void cmatrix<T>::apply(const std::function<T(T)> &f)
+template <class T, class Layout>
+void cmatrix<T, Layout>::apply(const std::function<T(T)> &f)
 {
-    #pragma omp parallel for collapse(2)
-    for (size_t r = 0; r < height(); r++)
+    apply<const std::function<T(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<void, F, T> cmatrix<T, Layout>::apply(F &&f)
+{
+    // Take the iterator once, so a shared buffer is copied before the threads write in it,
+    // and the inner loop is a plain loop on the row, which the compiler can vectorize
+    typename storage_type::iterator it = matrix.begin();
+
+    cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), height(), [&](size_t r)
+                           {
         for (size_t c = 0; c < width(); c++)
-            set_cell(r, c, f(cell(r, c)));
+            it[__index(r, c)] = f(it[__index(r, c)]); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::map(const std::function<T(T, size_t, size_t)> &f) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::map(const std::function<T(T, size_t, size_t)> &f) const
 {
-    cmatrix<T> m = copy();
-    m.apply(f);
-    return m;
+    return map<T, const std::function<T(T, size_t, size_t)> &>(f);
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-cmatrix<U> cmatrix<T>::map(const std::function<U(T, size_t, size_t)> &f) const
+cmatrix<U, Layout> cmatrix<T, Layout>::map(const std::function<U(T, size_t, size_t)> &f) const
 {
-    cmatrix<U> m = cmatrix<U>(height(), width());
+    return map<U, const std::function<U(T, size_t, size_t)> &>(f);
+}
 
-    for (size_t r = 0; r < height(); r++)
-        for (size_t c = 0; c < width(); c++)
-            m.set_cell(r, c, f(cell(r, c), r, c));
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<cmatrix<T, Layout>, F, T, size_t, size_t> cmatrix<T, Layout>::map(F &&f) const
+{
+    // Write the result in a new buffer, instead of copying the cells to overwrite them
+    return map<T>(std::forward<F>(f));
+}
+
+template <class T, class Layout>
+template <class U, class F>
+cmatrix_fn::if_callable_t<cmatrix<U, Layout>, F, T, size_t, size_t> cmatrix<T, Layout>::map(F &&f) const
+{
+    cmatrix<U, Layout> m = cmatrix<U, Layout>(height(), width());
+    map_into(m, std::forward<F>(f));
 
     return m;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::map(const std::function<T(T)> &f) const
+template <class T, class Layout>
+template <class U, class F>
+cmatrix_fn::if_callable_t<void, F, T, size_t, size_t> cmatrix<T, Layout>::map_into(cmatrix<U, Layout> &out, F &&f) const
 {
-    cmatrix<T> m = copy();
-    m.apply(f);
-    return m;
+    __check_out(out, height(), width());
+
+    // Take the output iterator first, so a buffer shared with the matrix is copied before being read
+    typename cmatrix<U, Layout>::storage_type::iterator dst = out.matrix.begin();
+    typename storage_type::const_iterator in = matrix.cbegin();
+
+    for (size_t r = 0; r < height(); r++)
+        for (size_t c = 0; c < width(); c++)
+            dst[out.__index(r, c)] = f(in[__index(r, c)], r, c);
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::map(const std::function<T(T)> &f) const
+{
+    return map<T, const std::function<T(T)> &>(f);
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-cmatrix<U> cmatrix<T>::map(const std::function<U(T)> &f) const
+cmatrix<U, Layout> cmatrix<T, Layout>::map(const std::function<U(T)> &f) const
+{
+    return map<U, const std::function<U(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<cmatrix<T, Layout>, F, T> cmatrix<T, Layout>::map(F &&f) const
+{
+    return map<T>(std::forward<F>(f));
+}
+
+template <class T, class Layout>
+template <class U, class F>
+cmatrix_fn::if_callable_t<cmatrix<U, Layout>, F, T> cmatrix<T, Layout>::map(F &&f) const
 {
     // Create a new matrix with the same dimensions
-    cmatrix<U> m = cmatrix<U>(height(), width());
+    cmatrix<U, Layout> m = cmatrix<U, Layout>(height(), width());
+    map_into(m, std::forward<F>(f));
 
-    // Set the mapped value for each cell
-    #pragma omp parallel for collapse(2)
-    for (size_t r = 0; r < height(); r++)
+    return m;
+}
+
+template <class T, class Layout>
+template <class U, class F>
+cmatrix_fn::if_callable_t<void, F, T> cmatrix<T, Layout>::map_into(cmatrix<U, Layout> &out, F &&f) const
+{
+    __check_out(out, height(), width());
+
+    // Take the output iterator first, so a buffer shared with the matrix is copied before being read
+    typename cmatrix<U, Layout>::storage_type::iterator dst = out.matrix.begin();
+    typename storage_type::const_iterator in = matrix.cbegin();
+
+    // Set the mapped value for each cell, through iterators taken once so the inner loop can be vectorized
+    cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), height(), [&](size_t r)
+                           {
         for (size_t c = 0; c < width(); c++)
-            m.set_cell(r, c, f(cell(r, c)));
+            dst[out.__index(r, c)] = f(in[__index(r, c)]); });
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::fill(const T &value)
+{
+    // A shared buffer is replaced instead of being copied
+    matrix.assign(matrix.size(), value);
+}
+
+template <class T, class Layout>
+std::vector<std::vector<T>> cmatrix<T, Layout>::to_vector() const
+{
+    std::vector<std::vector<T>> m;
+    m.reserve(height());
+
+    // Copy each row in its own vector
+    for (size_t r = 0; r < height(); r++)
+        m.push_back(rows_vec(r));
 
     return m;
 }
 
-template <class T>
-void cmatrix<T>::fill(const T &value)
+template <class T, class Layout>
+void cmatrix<T, Layout>::__reset(const size_t &height, const size_t &width, const T &val)
 {
-    *this = cmatrix<T>(height(), width(), value);
+    m_height = height;
+    m_width = height == 0 ? 0 : width;
+    m_stride = __stride(Layout::length(m_height, m_width));
+    matrix.assign(Layout::lines(m_height, m_width) * m_stride, val);
 }
 
-template <class T>
-std::vector<std::vector<T>> cmatrix<T>::to_vector() const
+template <class T, class Layout>
+size_t cmatrix<T, Layout>::__stride(const size_t &width)
 {
-    return matrix;
+    const size_t cells = cmatrix_alloc::ALIGNMENT / sizeof(T);
+
+    // Round the width up to a whole number of cache lines
+    if (CMATRIX_ALIGNED_ROWS and (std::is_same<T, float>::value or std::is_same<T, double>::value))
+        return (width + cells - 1) / cells * cells;
+
+    return width;
 }
 
 // ==================================================
 // CAST FUNCTIONS
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-cmatrix<U> cmatrix<T>::__cast(std::true_type) const
+cmatrix<U, Layout> cmatrix<T, Layout>::__cast(std::true_type) const
 {
     // Create a new matrix with the same dimensions
-    cmatrix<U> m(height(), width());
+    cmatrix<U, Layout> m(height(), width());
 
     // Set the casted value for each cell
     for (size_t r = 0; r < height(); r++)
         for (size_t c = 0; c < width(); c++)
-            m.set_cell(r, c, static_cast<U>(cell(r, c)));
+            m.__at(r, c) = static_cast<U>(__at(r, c));
 
     return m;
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-cmatrix<U> cmatrix<T>::__cast(std::false_type) const
+cmatrix<U, Layout> cmatrix<T, Layout>::__cast(std::false_type) const
 {
     throw std::invalid_argument("T type" +
                                 std::string(typeid(T).name()) +
@@ -132,9 +232,9 @@ cmatrix<U> cmatrix<T>::__cast(std::false_type) const
                                 std::string(typeid(U).name()) + ".");
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-cmatrix<U> cmatrix<T>::cast() const
+cmatrix<U, Layout> cmatrix<T, Layout>::cast() const
 {
     return __cast<U>(std::is_convertible<T, U>());
 }
@@ -144,8 +244,8 @@ cmatrix<U> cmatrix<T>::cast() const
 
 // TO INT
 
-template <class T>
-cmatrix<int> cmatrix<T>::to_int() const
+template <class T, class Layout>
+cmatrix<int, Layout> cmatrix<T, Layout>::to_int() const
 {
     return cast<int>();
 }
@@ -184,30 +284,30 @@ cmatrix<float> cmatrix<std::string>::to_float() const
                         } });
 }
 
-template <class T>
-cmatrix<float> cmatrix<T>::to_float() const
+template <class T, class Layout>
+cmatrix<float, Layout> cmatrix<T, Layout>::to_float() const
 {
     return cast<float>();
 }
 
 // TO STRING
 
-template <class T>
-cmatrix<std::string> cmatrix<T>::__to_string(std::true_type) const
+template <class T, class Layout>
+cmatrix<std::string, Layout> cmatrix<T, Layout>::__to_string(std::true_type) const
 {
     return map<std::string>([&](T cell)
                             { return std::to_string(cell); });
 }
 
-template <class T>
-cmatrix<std::string> cmatrix<T>::__to_string(std::false_type) const
+template <class T, class Layout>
+cmatrix<std::string, Layout> cmatrix<T, Layout>::__to_string(std::false_type) const
 {
     throw std::invalid_argument("The type should be a primitive type. Actual type: " +
                                 std::string(typeid(T).name()) + ".");
 }
 
-template <class T>
-cmatrix<std::string> cmatrix<T>::to_string() const
+template <class T, class Layout>
+cmatrix<std::string, Layout> cmatrix<T, Layout>::to_string() const
 {
     return __to_string(std::is_fundamental<T>());
 }
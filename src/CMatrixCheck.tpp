@@ -12,45 +12,45 @@
 // ==================================================
 // IS METHODS
 
-template <class T>
-bool cmatrix<T>::is_empty() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_empty() const
 {
     return width() == 0 and height() == 0;
 }
 
-template <class T>
-bool cmatrix<T>::is_square() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_square() const
 {
     return width() == height();
 }
 
-template <class T>
-bool cmatrix<T>::is_diag() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_diag() const
 {
     return is_square() and is_triangular_up() and is_triangular_low();
 }
 
-template <class T>
-bool cmatrix<T>::is_identity() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_identity() const
 {
     return identity(width()) == *this;
 }
 
-template <class T>
-bool cmatrix<T>::is_symetric() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_symetric() const
 {
     return *this == transpose();
 }
 
-template <class T>
-bool cmatrix<T>::is_triangular_up() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_triangular_up() const
 {
     if (is_square())
     {
         // Check if the upper triangle is zero
         for (size_t r = 0; r < height(); r++)
             for (size_t c = 0; c < r; c++)
-                if (cell(r, c) != 0)
+                if (__at(r, c) != 0)
                     return false;
 
         return true;
@@ -59,15 +59,15 @@ bool cmatrix<T>::is_triangular_up() const
     return false;
 }
 
-template <class T>
-bool cmatrix<T>::is_triangular_low() const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_triangular_low() const
 {
     if (is_square())
     {
         // Check if the lower triangle is zero
         for (size_t r = 0; r < height(); r++)
             for (size_t c = r + 1; c < width(); c++)
-                if (cell(r, c) != 0)
+                if (__at(r, c) != 0)
                     return false;
 
         return true;
@@ -76,39 +76,53 @@ bool cmatrix<T>::is_triangular_low() const
     return false;
 }
 
-template <class T>
-bool cmatrix<T>::all(const std::function<bool(T)> &f) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::all(const std::function<bool(T)> &f) const
+{
+    return all<const std::function<bool(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<bool, F, T> cmatrix<T, Layout>::all(F &&f) const
 {
     // Check if all elements satisfy the condition
     for (size_t r = 0; r < height(); r++)
         for (size_t c = 0; c < width(); c++)
-            if (!f(cell(r, c)))
+            if (!f(__at(r, c)))
                 return false;
 
     return true;
 }
 
-template <class T>
-bool cmatrix<T>::all(const T &val) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::all(const T &val) const
 {
     return all([&](T e)
                { return e == val; });
 }
 
-template <class T>
-bool cmatrix<T>::any(const std::function<bool(T)> &f) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::any(const std::function<bool(T)> &f) const
+{
+    return any<const std::function<bool(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<bool, F, T> cmatrix<T, Layout>::any(F &&f) const
 {
     // Check if any element satisfies the condition
     for (size_t r = 0; r < height(); r++)
         for (size_t c = 0; c < width(); c++)
-            if (f(cell(r, c)))
+            if (f(__at(r, c)))
                 return true;
 
     return false;
 }
 
-template <class T>
-bool cmatrix<T>::any(const T &val) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::any(const T &val) const
 {
     return any([&](T e)
                { return e == val; });
@@ -117,8 +131,8 @@ bool cmatrix<T>::any(const T &val) const
 // ==================================================
 // THROW METHODS
 
-template <class T>
-void cmatrix<T>::__check_size(const std::tuple<size_t, size_t> &size) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_size(const std::tuple<size_t, size_t> &size) const
 {
     if (std::get<0>(size) != height() || std::get<1>(size) != width())
         throw std::invalid_argument("The matrices must have the same dimension. Expected: " +
@@ -131,14 +145,32 @@ void cmatrix<T>::__check_size(const std::tuple<size_t, size_t> &size) const
                                     std::to_string(std::get<1>(size)));
 }
 
-template <class T>
-void cmatrix<T>::__check_size(const cmatrix<T> &m) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_size(const cmatrix<T, Layout> &m) const
 {
     __check_size(m.size());
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_row(const std::vector<T> &row) const
+template <class T, class Layout>
+template <class U, class M>
+void cmatrix<T, Layout>::__check_out(const cmatrix<U, M> &out, const size_t &height, const size_t &width)
+{
+    // A matrix without rows has no columns
+    const size_t &w = height == 0 ? 0 : width;
+
+    if (out.height() != height || out.width() != w)
+        throw std::invalid_argument("The output matrix must have the dimensions of the result. Expected: " +
+                                    std::to_string(height) +
+                                    "x" +
+                                    std::to_string(w) +
+                                    ". Actual: " +
+                                    std::to_string(out.height()) +
+                                    "x" +
+                                    std::to_string(out.width()));
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_row(const std::vector<T> &row) const
 {
     if (row.size() != width())
         throw std::invalid_argument("Invalid row size. Expected: " +
@@ -147,8 +179,8 @@ void cmatrix<T>::__check_valid_row(const std::vector<T> &row) const
                                     std::to_string(row.size()));
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_col(const std::vector<T> &col) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_col(const std::vector<T> &col) const
 {
     if (col.size() != height())
         throw std::invalid_argument("Invalid column size. Expected: " +
@@ -157,8 +189,8 @@ void cmatrix<T>::__check_valid_col(const std::vector<T> &col) const
                                     std::to_string(col.size()));
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_diag(const std::vector<T> &diag) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_diag(const std::vector<T> &diag) const
 {
     const size_t min = std::min(width(), height());
     if (diag.size() != min)
@@ -168,8 +200,8 @@ void cmatrix<T>::__check_valid_diag(const std::vector<T> &diag) const
                                     std::to_string(diag.size()));
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_row_id(const size_t &n) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_row_id(const size_t &n) const
 {
     if (n < 0 || n >= height())
         throw std::out_of_range("Invalid row index. Expected: 0 <= " +
@@ -178,8 +210,8 @@ void cmatrix<T>::__check_valid_row_id(const size_t &n) const
                                 std::to_string(height()));
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_col_id(const size_t &n) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_col_id(const size_t &n) const
 {
     if (n < 0 || n >= width())
         throw std::out_of_range("Invalid column index. Expected: 0 <= " +
@@ -188,8 +220,8 @@ void cmatrix<T>::__check_valid_col_id(const size_t &n) const
                                 std::to_string(width()));
 }
 
-template <class T>
-void cmatrix<T>::__check_expected_id(const size_t &n, const size_t &expectedBegin, const size_t &exepectedEnd) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_expected_id(const size_t &n, const size_t &expectedBegin, const size_t &exepectedEnd) const
 {
     if (n < expectedBegin || n > exepectedEnd)
         throw std::out_of_range("Invalid index. Expected: " +
@@ -200,17 +232,28 @@ void cmatrix<T>::__check_expected_id(const size_t &n, const size_t &expectedBegi
                                 std::to_string(exepectedEnd));
 }
 
-template <class T>
-void cmatrix<T>::__check_expected_id(const size_t &n, const size_t &expected) const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_expected_id(const size_t &n, const size_t &expected) const
 {
     __check_expected_id(n, expected, expected);
 }
 
-template <class T>
-void cmatrix<T>::__check_valid_type() const
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_valid_type() const
 {
     if (std::is_same<T, bool>::value)
         throw std::invalid_argument("The type " + std::string(typeid(T).name()) + " is not supported. Use 'cbool' instead.");
 }
 
+template <class T, class Layout>
+void cmatrix<T, Layout>::__check_bounds(const size_t &row, const size_t &col) const
+{
+    // The condition is a constant, so the checks are removed when the bounds checking is disabled
+    if (CMATRIX_BOUNDS_CHECK)
+    {
+        __check_valid_row_id(row);
+        __check_valid_col_id(col);
+    }
+}
+
 #endif // CMATRIX_CHECK_TPP
@@ -11,60 +11,119 @@
 // ==================================================
 // CONSTRUCTORS
 
-template <class T>
-cmatrix<T>::cmatrix() 
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix() 
 {
     __check_valid_type();
 }
 
-template <class T>
-cmatrix<T>::cmatrix(const std::initializer_list<std::initializer_list<T>> &m) : cmatrix<T>(std::vector<std::vector<T>>(m.begin(), m.end())) 
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(const std::initializer_list<std::initializer_list<T>> &m) : cmatrix<T, Layout>(std::vector<std::vector<T>>(m.begin(), m.end())) 
 {
     __check_valid_type();
 }
 
-template <class T>
-cmatrix<T>::cmatrix(const std::vector<std::vector<T>> &m)
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(const std::vector<std::vector<T>> &m)
 {
     __check_valid_type();
 
-    if (is_matrix(m))
-        matrix = m;
+    if (not is_matrix(m))
+        throw std::invalid_argument("The vector must be a matrix.");
+
+    __reset(m.size(), m.empty() ? 0 : m[0].size());
+
+    typename storage_type::iterator dst = matrix.begin();
 
-    else
+    // Copy each row in its line of the buffer, or each cell in the lines of the columns
+    for (size_t r = 0; r < height(); r++)
+        if (cmatrix_layout::is_row_major<Layout>::value)
+            std::copy(m[r].begin(), m[r].end(), dst + __index(r, 0));
+        else
+            for (size_t c = 0; c < width(); c++)
+                dst[__index(r, c)] = m[r][c];
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(std::vector<std::vector<T>> &&m)
+{
+    __check_valid_type();
+
+    if (not is_matrix(m))
         throw std::invalid_argument("The vector must be a matrix.");
+
+    __reset(m.size(), m.empty() ? 0 : m[0].size());
+
+    typename storage_type::iterator dst = matrix.begin();
+
+    // Move each row in its line of the buffer, or each cell in the lines of the columns
+    for (size_t r = 0; r < height(); r++)
+        if (cmatrix_layout::is_row_major<Layout>::value)
+            std::move(m[r].begin(), m[r].end(), dst + __index(r, 0));
+        else
+            for (size_t c = 0; c < width(); c++)
+                dst[__index(r, c)] = std::move(m[r][c]);
+
+    m.clear();
 }
 
-template <class T>
-cmatrix<T>::cmatrix(const size_t &height, const size_t &width)
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(const size_t &height, const size_t &width)
 {
     __check_valid_type();
+    __reset(height, width);
+}
 
-    matrix = std::vector<std::vector<T>>(height, std::vector<T>(width));
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(const size_t &height, const size_t &width, const T &value)
+{
+    __check_valid_type();
+    __reset(height, width, value);
 }
 
-template <class T>
-cmatrix<T>::cmatrix(const size_t &height, const size_t &width, const T &value)
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(const cmatrix<T, Layout> &m)
+    : matrix(m.matrix), m_height(m.m_height), m_width(m.m_width), m_stride(m.m_stride) {}
+
+template <class T, class Layout>
+cmatrix<T, Layout>::cmatrix(cmatrix<T, Layout> &&m) noexcept
+    : matrix(std::move(m.matrix)), m_height(m.m_height), m_width(m.m_width), m_stride(m.m_stride)
+{
+    m.clear();
+}
+
+template <class T, class Layout>
+template <class M>
+cmatrix<T, Layout>::cmatrix(const cmatrix<T, M> &m)
 {
     __check_valid_type();
+    __reset(m.height(), m.width());
 
-    matrix = std::vector<std::vector<T>>(height, std::vector<T>(width, value));
+    // The lines of one layout are the columns of the other (see CMatrixTranspose.tpp)
+    m.__transpose_into(*this, std::is_same<T, cbool>());
 }
 
-template <class T>
-template <class U>
-cmatrix<T>::cmatrix(const cmatrix<U> &m)
+template <class T, class Layout>
+template <class U, class M>
+cmatrix<T, Layout>::cmatrix(const cmatrix<U, M> &m)
 {
     __check_valid_type();
+    *this = m.template cast<T>();
+}
 
-    cmatrix<T> result = m.template cast<T>();
-    matrix = result.to_vector();
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout>::cmatrix(const cmatrix_expr::expr<E, T> &e)
+{
+    __check_valid_type();
+    __reset(e.self().height(), e.self().width());
+    __assign_expr(e.self());
 }
 
 // ==================================================
 // DESTRUCTOR
 
-template <class T>
-cmatrix<T>::~cmatrix() {}
+template <class T, class Layout>
+cmatrix<T, Layout>::~cmatrix() {}
 
 #endif // CMATRIX_CONSTRUCTOR_TPP
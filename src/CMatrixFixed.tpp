@@ -0,0 +1,668 @@
+/**
+ * @file CMatrixFixed.tpp
+ * @brief This file contains the implementation of the cmatrix_fixed class.
+ *
+ * @see cmatrix_fixed
+ */
+
+#ifndef CMATRIX_FIXED_TPP
+#define CMATRIX_FIXED_TPP
+
+namespace cmatrix_small
+{
+    // ==================================================
+    // SQUARE KERNELS
+
+    /**
+     * @brief The determinant and the inverse of a N x N matrix, stored row by row.
+     * The generic kernels use a Gaussian elimination with partial pivoting, fraction-free for the
+     * integer types. The kernels of the matrices up to 4x4 are specialized with closed formulas,
+     * without loop or branch.
+     *
+     * @tparam T The type of elements in the matrix.
+     * @tparam N The dimension of the matrix.
+     */
+    template <class T, size_t N>
+    struct square
+    {
+        /**
+         * @brief Get the row of the largest pivot of the column k, from the row k.
+         */
+        static size_t pivot(const T *m, const size_t &k)
+        {
+            size_t p = k;
+
+            for (size_t i = k + 1; i < N; i++)
+                if (std::abs(m[i * N + k]) > std::abs(m[p * N + k]))
+                    p = i;
+
+            return p;
+        }
+
+        static T det(const T *a)
+        {
+            return det(a, std::is_integral<T>());
+        }
+
+        /**
+         * @brief Get the determinant of a matrix of integers by the Bareiss elimination.
+         * Each step divides by the previous pivot, and the division is exact, so no cell is truncated.
+         * The cells stay minors of the matrix, so they only overflow if a minor of the matrix does.
+         */
+        static T det(const T *a, std::true_type)
+        {
+            T m[N * N];
+            std::copy(a, a + N * N, m);
+            T previous = T(1);
+            bool negate = false;
+
+            for (size_t k = 0; k + 1 < N; k++)
+            {
+                // A null pivot is swapped with the first row below having a cell in the column k
+                if (m[k * N + k] == T())
+                {
+                    size_t p = k + 1;
+
+                    while (p < N and m[p * N + k] == T())
+                        p++;
+
+                    if (p == N)
+                        return T();
+
+                    std::swap_ranges(m + k * N, m + (k + 1) * N, m + p * N);
+                    negate = not negate;
+                }
+
+                for (size_t i = k + 1; i < N; i++)
+                    for (size_t j = k + 1; j < N; j++)
+                        m[i * N + j] = (m[i * N + j] * m[k * N + k] - m[i * N + k] * m[k * N + j]) / previous;
+
+                previous = m[k * N + k];
+            }
+
+            return negate ? -m[N * N - 1] : m[N * N - 1];
+        }
+
+        static T det(const T *a, std::false_type)
+        {
+            T m[N * N];
+            std::copy(a, a + N * N, m);
+            T d = T(1);
+
+            for (size_t k = 0; k < N; k++)
+            {
+                const size_t p = pivot(m, k);
+
+                if (m[p * N + k] == T())
+                    return T();
+
+                // Swapping two rows changes the sign of the determinant
+                if (p != k)
+                {
+                    std::swap_ranges(m + k * N, m + (k + 1) * N, m + p * N);
+                    d = -d;
+                }
+
+                d *= m[k * N + k];
+
+                // Remove the column k from the next rows
+                for (size_t i = k + 1; i < N; i++)
+                {
+                    const T f = m[i * N + k] / m[k * N + k];
+
+                    for (size_t j = k; j < N; j++)
+                        m[i * N + j] -= f * m[k * N + j];
+                }
+            }
+
+            return d;
+        }
+
+        static bool inverse(const T *a, T *inv)
+        {
+            T m[N * N];
+            std::copy(a, a + N * N, m);
+
+            // Start from the identity, which receives the same operations as the matrix
+            std::fill(inv, inv + N * N, T());
+            for (size_t i = 0; i < N; i++)
+                inv[i * N + i] = T(1);
+
+            for (size_t k = 0; k < N; k++)
+            {
+                const size_t p = pivot(m, k);
+
+                if (m[p * N + k] == T())
+                    return false;
+
+                if (p != k)
+                {
+                    std::swap_ranges(m + k * N, m + (k + 1) * N, m + p * N);
+                    std::swap_ranges(inv + k * N, inv + (k + 1) * N, inv + p * N);
+                }
+
+                // Scale the row k so its pivot is 1
+                const T s = T(1) / m[k * N + k];
+                for (size_t j = 0; j < N; j++)
+                {
+                    m[k * N + j] *= s;
+                    inv[k * N + j] *= s;
+                }
+
+                // Remove the column k from the other rows
+                for (size_t i = 0; i < N; i++)
+                {
+                    if (i == k)
+                        continue;
+
+                    const T f = m[i * N + k];
+
+                    for (size_t j = 0; j < N; j++)
+                    {
+                        m[i * N + j] -= f * m[k * N + j];
+                        inv[i * N + j] -= f * inv[k * N + j];
+                    }
+                }
+            }
+
+            return true;
+        }
+    };
+
+    template <class T>
+    struct square<T, 1>
+    {
+        static T det(const T *a) { return a[0]; }
+
+        static bool inverse(const T *a, T *inv)
+        {
+            if (a[0] == T())
+                return false;
+
+            inv[0] = T(1) / a[0];
+            return true;
+        }
+    };
+
+    template <class T>
+    struct square<T, 2>
+    {
+        static T det(const T *a) { return a[0] * a[3] - a[1] * a[2]; }
+
+        static bool inverse(const T *a, T *inv)
+        {
+            const T d = det(a);
+
+            if (d == T())
+                return false;
+
+            inv[0] = a[3] / d;
+            inv[1] = -a[1] / d;
+            inv[2] = -a[2] / d;
+            inv[3] = a[0] / d;
+            return true;
+        }
+    };
+
+    template <class T>
+    struct square<T, 3>
+    {
+        static T det(const T *a)
+        {
+            return a[0] * (a[4] * a[8] - a[5] * a[7]) -
+                   a[1] * (a[3] * a[8] - a[5] * a[6]) +
+                   a[2] * (a[3] * a[7] - a[4] * a[6]);
+        }
+
+        static bool inverse(const T *a, T *inv)
+        {
+            const T d = det(a);
+
+            if (d == T())
+                return false;
+
+            // The transpose of the cofactors, divided by the determinant
+            inv[0] = (a[4] * a[8] - a[5] * a[7]) / d;
+            inv[1] = (a[2] * a[7] - a[1] * a[8]) / d;
+            inv[2] = (a[1] * a[5] - a[2] * a[4]) / d;
+            inv[3] = (a[5] * a[6] - a[3] * a[8]) / d;
+            inv[4] = (a[0] * a[8] - a[2] * a[6]) / d;
+            inv[5] = (a[2] * a[3] - a[0] * a[5]) / d;
+            inv[6] = (a[3] * a[7] - a[4] * a[6]) / d;
+            inv[7] = (a[1] * a[6] - a[0] * a[7]) / d;
+            inv[8] = (a[0] * a[4] - a[1] * a[3]) / d;
+            return true;
+        }
+    };
+
+    template <class T>
+    struct square<T, 4>
+    {
+        /**
+         * @brief The 2x2 minors of the two first rows (s) and of the two last rows (c).
+         * The determinant and the cofactors are computed from them, as in the Laplace expansion by pairs of rows.
+         */
+        struct minors
+        {
+            T s[6];
+            T c[6];
+
+            explicit minors(const T *a)
+            {
+                s[0] = a[0] * a[5] - a[4] * a[1];
+                s[1] = a[0] * a[6] - a[4] * a[2];
+                s[2] = a[0] * a[7] - a[4] * a[3];
+                s[3] = a[1] * a[6] - a[5] * a[2];
+                s[4] = a[1] * a[7] - a[5] * a[3];
+                s[5] = a[2] * a[7] - a[6] * a[3];
+
+                c[0] = a[8] * a[13] - a[12] * a[9];
+                c[1] = a[8] * a[14] - a[12] * a[10];
+                c[2] = a[8] * a[15] - a[12] * a[11];
+                c[3] = a[9] * a[14] - a[13] * a[10];
+                c[4] = a[9] * a[15] - a[13] * a[11];
+                c[5] = a[10] * a[15] - a[14] * a[11];
+            }
+
+            T det() const
+            {
+                return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+            }
+        };
+
+        static T det(const T *a) { return minors(a).det(); }
+
+        static bool inverse(const T *a, T *inv)
+        {
+            const minors m(a);
+            const T d = m.det();
+
+            if (d == T())
+                return false;
+
+            const T *s = m.s;
+            const T *c = m.c;
+
+            inv[0] = (a[5] * c[5] - a[6] * c[4] + a[7] * c[3]) / d;
+            inv[1] = (-a[1] * c[5] + a[2] * c[4] - a[3] * c[3]) / d;
+            inv[2] = (a[13] * s[5] - a[14] * s[4] + a[15] * s[3]) / d;
+            inv[3] = (-a[9] * s[5] + a[10] * s[4] - a[11] * s[3]) / d;
+
+            inv[4] = (-a[4] * c[5] + a[6] * c[2] - a[7] * c[1]) / d;
+            inv[5] = (a[0] * c[5] - a[2] * c[2] + a[3] * c[1]) / d;
+            inv[6] = (-a[12] * s[5] + a[14] * s[2] - a[15] * s[1]) / d;
+            inv[7] = (a[8] * s[5] - a[10] * s[2] + a[11] * s[1]) / d;
+
+            inv[8] = (a[4] * c[4] - a[5] * c[2] + a[7] * c[0]) / d;
+            inv[9] = (-a[0] * c[4] + a[1] * c[2] - a[3] * c[0]) / d;
+            inv[10] = (a[12] * s[4] - a[13] * s[2] + a[15] * s[0]) / d;
+            inv[11] = (-a[8] * s[4] + a[9] * s[2] - a[11] * s[0]) / d;
+
+            inv[12] = (-a[4] * c[3] + a[5] * c[1] - a[6] * c[0]) / d;
+            inv[13] = (a[0] * c[3] - a[1] * c[1] + a[2] * c[0]) / d;
+            inv[14] = (-a[12] * s[3] + a[13] * s[1] - a[14] * s[0]) / d;
+            inv[15] = (a[8] * s[3] - a[9] * s[1] + a[10] * s[0]) / d;
+            return true;
+        }
+    };
+}
+
+// ==================================================
+// CONSTRUCTORS
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C>::cmatrix_fixed(const T &val)
+{
+    fill(val);
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C>::cmatrix_fixed(const std::initializer_list<std::initializer_list<T>> &m)
+{
+    if (m.size() != R)
+        throw std::invalid_argument("The number of rows must be " + std::to_string(R) + ". Actual: " + std::to_string(m.size()));
+
+    size_t r = 0;
+    for (const std::initializer_list<T> &row : m)
+    {
+        if (row.size() != C)
+            throw std::invalid_argument("The number of columns must be " + std::to_string(C) + ". Actual: " + std::to_string(row.size()));
+
+        std::copy(row.begin(), row.end(), m_data + r * C);
+        r++;
+    }
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C>::cmatrix_fixed(const cmatrix<T> &m)
+{
+    if (m.height() != R or m.width() != C)
+        throw std::invalid_argument("The matrices must have the same dimension. Expected: " +
+                                    std::to_string(R) +
+                                    "x" +
+                                    std::to_string(C) +
+                                    ". Actual: " +
+                                    std::to_string(m.height()) +
+                                    "x" +
+                                    std::to_string(m.width()));
+
+    for (size_t r = 0; r < R; r++)
+        std::copy(m.row_data(r), m.row_data(r) + C, m_data + r * C);
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::identity()
+{
+    static_assert(R == C, "The matrix must be square.");
+
+    cmatrix_fixed<T, R, C> m;
+    cmatrix_unroll::loop<R>::run([&](size_t i)
+                                 { m.m_data[i * C + i] = T(1); });
+
+    return m;
+}
+
+// ==================================================
+// CHECK METHODS
+
+template <class T, size_t R, size_t C>
+void cmatrix_fixed<T, R, C>::__check_valid_row_id(const size_t &n)
+{
+    if (n >= R)
+        throw std::out_of_range("Invalid row index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(R));
+}
+
+template <class T, size_t R, size_t C>
+void cmatrix_fixed<T, R, C>::__check_valid_col_id(const size_t &n)
+{
+    if (n >= C)
+        throw std::out_of_range("Invalid column index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(C));
+}
+
+// ==================================================
+// GETTERS
+
+template <class T, size_t R, size_t C>
+T &cmatrix_fixed<T, R, C>::cell(const size_t &row, const size_t &col)
+{
+    __check_valid_row_id(row);
+    __check_valid_col_id(col);
+
+    return m_data[row * C + col];
+}
+
+template <class T, size_t R, size_t C>
+T &cmatrix_fixed<T, R, C>::at_unchecked(const size_t &row, const size_t &col)
+{
+    // The condition is a constant, so the checks are removed when the bounds checking is disabled
+    if (CMATRIX_BOUNDS_CHECK)
+    {
+        __check_valid_row_id(row);
+        __check_valid_col_id(col);
+    }
+
+    return m_data[row * C + col];
+}
+
+template <class T, size_t R, size_t C>
+const T &cmatrix_fixed<T, R, C>::at_unchecked(const size_t &row, const size_t &col) const
+{
+    if (CMATRIX_BOUNDS_CHECK)
+    {
+        __check_valid_row_id(row);
+        __check_valid_col_id(col);
+    }
+
+    return m_data[row * C + col];
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, C, R> cmatrix_fixed<T, R, C>::transpose() const
+{
+    cmatrix_fixed<T, C, R> m;
+
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { m.m_data[(i % C) * R + i / C] = m_data[i]; });
+
+    return m;
+}
+
+// ==================================================
+// SETTERS
+
+template <class T, size_t R, size_t C>
+void cmatrix_fixed<T, R, C>::fill(const T &val)
+{
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { m_data[i] = val; });
+}
+
+// ==================================================
+// CONVERSION METHODS
+
+template <class T, size_t R, size_t C>
+cmatrix<T> cmatrix_fixed<T, R, C>::to_cmatrix() const
+{
+    cmatrix<T> m(R, C);
+
+    for (size_t r = 0; r < R; r++)
+        std::copy(m_data + r * C, m_data + (r + 1) * C, m.matrix.data() + m.__index(r, 0));
+
+    return m;
+}
+
+// ==================================================
+// MATH METHODS
+
+template <class T, size_t R, size_t C>
+template <size_t K>
+cmatrix_fixed<T, R, K> cmatrix_fixed<T, R, C>::matmul(const cmatrix_fixed<T, C, K> &m) const
+{
+    cmatrix_fixed<T, R, K> res;
+
+    // The indexes are constants once the loops are unrolled, so each cell is a sum of C products
+    cmatrix_unroll::loop<R * K>::run([&](size_t i)
+                                     {
+        T sum = T();
+        cmatrix_unroll::loop<C>::run([&](size_t p)
+                                     { sum += m_data[(i / K) * C + p] * m.m_data[p * K + i % K]; });
+        res.m_data[i] = sum; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+T cmatrix_fixed<T, R, C>::det() const
+{
+    static_assert(R == C, "The matrix must be square.");
+
+    return cmatrix_small::square<T, R>::det(m_data);
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::inverse() const
+{
+    static_assert(R == C, "The matrix must be square.");
+    static_assert(not std::is_integral<T>::value, "The inverse of an integer matrix would be truncated. Use a floating point type.");
+
+    cmatrix_fixed<T, R, C> m;
+
+    if (not cmatrix_small::square<T, R>::inverse(m_data, m.m_data))
+        throw std::invalid_argument("The matrix must be invertible.");
+
+    return m;
+}
+
+template <class T, size_t R, size_t C>
+T cmatrix_fixed<T, R, C>::sum_all(const T &zero) const
+{
+    T sum = zero;
+
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { sum += m_data[i]; });
+
+    return sum;
+}
+
+template <class T, size_t R, size_t C>
+bool cmatrix_fixed<T, R, C>::near(const cmatrix_fixed<T, R, C> &m, const T &tolerance) const
+{
+    for (size_t i = 0; i < R * C; i++)
+        if (not std::isgreaterequal(m_data[i], m.m_data[i] - tolerance) or
+            not std::islessequal(m_data[i], m.m_data[i] + tolerance))
+            return false;
+
+    return true;
+}
+
+// ==================================================
+// OPERATORS
+
+template <class T, size_t R, size_t C>
+bool cmatrix_fixed<T, R, C>::operator==(const cmatrix_fixed<T, R, C> &m) const
+{
+    return std::equal(m_data, m_data + R * C, m.m_data);
+}
+
+template <class T, size_t R, size_t C>
+bool cmatrix_fixed<T, R, C>::operator!=(const cmatrix_fixed<T, R, C> &m) const
+{
+    return not(*this == m);
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator+(const cmatrix_fixed<T, R, C> &m) const
+{
+    cmatrix_fixed<T, R, C> res = *this;
+    return res += m;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator-(const cmatrix_fixed<T, R, C> &m) const
+{
+    cmatrix_fixed<T, R, C> res = *this;
+    return res -= m;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator*(const cmatrix_fixed<T, R, C> &m) const
+{
+    cmatrix_fixed<T, R, C> res;
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { res.m_data[i] = m_data[i] * m.m_data[i]; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator-() const
+{
+    cmatrix_fixed<T, R, C> res;
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { res.m_data[i] = -m_data[i]; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator+(const T &n) const
+{
+    cmatrix_fixed<T, R, C> res;
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { res.m_data[i] = m_data[i] + n; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator-(const T &n) const
+{
+    cmatrix_fixed<T, R, C> res;
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { res.m_data[i] = m_data[i] - n; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator*(const T &n) const
+{
+    cmatrix_fixed<T, R, C> res = *this;
+    return res *= n;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> cmatrix_fixed<T, R, C>::operator/(const T &n) const
+{
+    if (n == T())
+        throw std::invalid_argument("The value must be different from 0.");
+
+    cmatrix_fixed<T, R, C> res;
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { res.m_data[i] = m_data[i] / n; });
+
+    return res;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> &cmatrix_fixed<T, R, C>::operator+=(const cmatrix_fixed<T, R, C> &m)
+{
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { m_data[i] += m.m_data[i]; });
+
+    return *this;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> &cmatrix_fixed<T, R, C>::operator-=(const cmatrix_fixed<T, R, C> &m)
+{
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { m_data[i] -= m.m_data[i]; });
+
+    return *this;
+}
+
+template <class T, size_t R, size_t C>
+cmatrix_fixed<T, R, C> &cmatrix_fixed<T, R, C>::operator*=(const T &n)
+{
+    cmatrix_unroll::loop<R * C>::run([&](size_t i)
+                                     { m_data[i] *= n; });
+
+    return *this;
+}
+
+template <class U, size_t H, size_t W>
+std::ostream &operator<<(std::ostream &out, const cmatrix_fixed<U, H, W> &m)
+{
+    out << "[";
+
+    for (size_t i = 0; i < H; i++)
+    {
+        out << "[";
+
+        for (size_t j = 0; j < W; j++)
+        {
+            out << m.m_data[i * W + j];
+
+            if (j != W - 1)
+                out << ", ";
+        }
+
+        out << "]";
+
+        if (i != H - 1)
+            out << ", ";
+    }
+
+    out << "]";
+
+    return out;
+}
+
+#endif // CMATRIX_FIXED_TPP
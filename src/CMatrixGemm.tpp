@@ -0,0 +1,358 @@
+/**
+ * @file CMatrixGemm.tpp
+ * @brief This file contains the implementation of the blocked matrix multiplication engine used by matmul.
+ *
+ * @details The product C += A * B is split in three levels of blocks sized for the caches:
+ *          - the columns of B and C are split in blocks of NC columns (L3),
+ *          - the inner dimension is split in blocks of KC (L1 for a panel of B),
+ *          - the rows of A and C are split in blocks of MC rows (L2).
+ *          The blocks of A and B are packed in contiguous panels of MR rows and NR columns,
+ *          and a register tiled micro-kernel computes each MR x NR tile of C.
+ *          The operands are read through their strides, so a transposed operand is not copied: the
+ *          packing and the small products pick the loop order reading it along its contiguous cells.
+ *
+ * @see cmatrix::matmul
+ */
+
+#ifndef CMATRIX_GEMM_TPP
+#define CMATRIX_GEMM_TPP
+
+namespace cmatrix_gemm
+{
+    // ==================================================
+    // BLOCKING PARAMETERS
+
+    /**
+     * @brief The dimensions of the blocks used by the engine.
+     * The micro-tile (MR x NR) fits in the vector registers, a KC x NR panel of B fits in the L1 cache,
+     * a MC x KC block of A fits in the L2 cache and a KC x NC block of B fits in the L3 cache.
+     *
+     * @tparam T The type of elements in the matrices.
+     */
+    template <class T>
+    struct blocking
+    {
+        static const size_t MR = sizeof(T) <= 4 ? 6 : 4;
+        static const size_t NR = sizeof(T) <= 4 ? 16 : 8;
+        static const size_t KC = 256;
+        static const size_t MC = sizeof(T) <= 4 ? 144 : 72;
+        static const size_t NC = 4096;
+
+        /** Under this number of multiplications, the packing costs more than it saves. */
+        static const size_t SMALL = 32 * 32 * 32;
+    };
+
+    template <class T> const size_t blocking<T>::MR;
+    template <class T> const size_t blocking<T>::NR;
+    template <class T> const size_t blocking<T>::KC;
+    template <class T> const size_t blocking<T>::MC;
+    template <class T> const size_t blocking<T>::NC;
+    template <class T> const size_t blocking<T>::SMALL;
+
+    // ==================================================
+    // BUFFERS
+
+    /**
+     * @brief Get a packing buffer of the calling thread, of at least n cells.
+     * The buffers are kept between the products, so the products computed in a loop don't allocate.
+     *
+     * @param id The buffer: 0 for the blocks of A, 1 for the block of B.
+     * @param n The minimal number of cells.
+     * @return T* The first cell of the buffer.
+     */
+    template <class T>
+    T *scratch(const size_t &id, const size_t &n)
+    {
+        static thread_local std::vector<T> buffers[2];
+
+        if (buffers[id].size() < n)
+            buffers[id].resize(n);
+
+        return buffers[id].data();
+    }
+
+    // ==================================================
+    // PACKING
+
+    /**
+     * @brief Pack a block of A in panels of MR rows.
+     * Each panel stores the KC columns one after the other, MR cells per column.
+     * The missing rows of the last panel are filled with zeros.
+     *
+     * @param mc The number of rows of the block.
+     * @param kc The number of columns of the block.
+     * @param a The first cell of the block.
+     * @param rsa The distance between two rows of A.
+     * @param csa The distance between two columns of A.
+     * @param ap The buffer receiving the panels.
+     */
+    template <class T>
+    void pack_a(const size_t &mc, const size_t &kc, const T *a, const size_t &rsa, const size_t &csa, T *ap)
+    {
+        const size_t MR = blocking<T>::MR;
+
+        for (size_t ir = 0; ir < mc; ir += MR)
+        {
+            const size_t mr = std::min(MR, mc - ir);
+
+            // The rows of A are contiguous: read them one after the other, and write the panel with a stride
+            if (csa == 1 and rsa != 1)
+            {
+                for (size_t i = 0; i < MR; i++)
+                    for (size_t p = 0; p < kc; p++)
+                        ap[p * MR + i] = i < mr ? a[(ir + i) * rsa + p] : T();
+
+                ap += kc * MR;
+                continue;
+            }
+
+            for (size_t p = 0; p < kc; p++)
+            {
+                for (size_t i = 0; i < mr; i++)
+                    ap[i] = a[(ir + i) * rsa + p * csa];
+
+                for (size_t i = mr; i < MR; i++)
+                    ap[i] = T();
+
+                ap += MR;
+            }
+        }
+    }
+
+    /**
+     * @brief Pack one panel of NR columns of a block of B.
+     * The panel stores the KC rows one after the other, NR cells per row.
+     * The missing columns of the last panel are filled with zeros.
+     *
+     * @param kc The number of rows of the block.
+     * @param nr The number of columns of the panel.
+     * @param b The first cell of the panel.
+     * @param rsb The distance between two rows of B.
+     * @param csb The distance between two columns of B.
+     * @param bp The buffer receiving the panel.
+     */
+    template <class T>
+    void pack_b(const size_t &kc, const size_t &nr, const T *b, const size_t &rsb, const size_t &csb, T *bp)
+    {
+        const size_t NR = blocking<T>::NR;
+
+        // The columns of B are contiguous, as in a transpose: read them one after the other
+        if (rsb == 1 and csb != 1)
+        {
+            for (size_t j = 0; j < NR; j++)
+                for (size_t p = 0; p < kc; p++)
+                    bp[p * NR + j] = j < nr ? b[p + j * csb] : T();
+
+            return;
+        }
+
+        for (size_t p = 0; p < kc; p++)
+        {
+            for (size_t j = 0; j < nr; j++)
+                bp[j] = b[p * rsb + j * csb];
+
+            for (size_t j = nr; j < NR; j++)
+                bp[j] = T();
+
+            bp += NR;
+        }
+    }
+
+    // ==================================================
+    // KERNELS
+
+    /**
+     * @brief Compute a MR x NR tile of C from a panel of A and a panel of B.
+     * The tile is accumulated in local variables the compiler can keep in registers,
+     * then added to C.
+     *
+     * @param kc The inner dimension of the panels.
+     * @param ap The packed panel of A.
+     * @param bp The packed panel of B.
+     * @param c The first cell of the tile in C.
+     * @param rsc The distance between two rows of C.
+     * @param csc The distance between two columns of C.
+     * @param mr The number of rows of the tile to write (<= MR).
+     * @param nr The number of columns of the tile to write (<= NR).
+     */
+    template <class T>
+    void micro_kernel(const size_t &kc, const T *ap, const T *bp, T *c, const size_t &rsc, const size_t &csc, const size_t &mr, const size_t &nr)
+    {
+        const size_t MR = blocking<T>::MR;
+        const size_t NR = blocking<T>::NR;
+
+        T acc[MR][NR];
+
+        for (size_t i = 0; i < MR; i++)
+            for (size_t j = 0; j < NR; j++)
+                acc[i][j] = T();
+
+        // Rank-1 update of the tile for each step of the inner dimension
+        for (size_t p = 0; p < kc; p++, ap += MR, bp += NR)
+            for (size_t i = 0; i < MR; i++)
+            {
+                const T a = ap[i];
+
+                #pragma omp simd
+                for (size_t j = 0; j < NR; j++)
+                    acc[i][j] += a * bp[j];
+            }
+
+        for (size_t i = 0; i < mr; i++)
+            for (size_t j = 0; j < nr; j++)
+                c[i * rsc + j * csc] += acc[i][j];
+    }
+
+    /**
+     * @brief Multiply a packed block of A by a packed block of B, tile by tile.
+     *
+     * @param mc The number of rows of the block of A.
+     * @param nc The number of columns of the block of B.
+     * @param kc The inner dimension of the blocks.
+     * @param ap The packed block of A.
+     * @param bp The packed block of B.
+     * @param c The first cell of the block in C.
+     * @param rsc The distance between two rows of C.
+     * @param csc The distance between two columns of C.
+     */
+    template <class T>
+    void macro_kernel(const size_t &mc, const size_t &nc, const size_t &kc, const T *ap, const T *bp, T *c, const size_t &rsc, const size_t &csc)
+    {
+        const size_t MR = blocking<T>::MR;
+        const size_t NR = blocking<T>::NR;
+
+        for (size_t jr = 0; jr < nc; jr += NR)
+            for (size_t ir = 0; ir < mc; ir += MR)
+                micro_kernel(kc, ap + ir * kc, bp + jr * kc, c + ir * rsc + jr * csc, rsc, csc,
+                             std::min(MR, mc - ir), std::min(NR, nc - jr));
+    }
+
+    /**
+     * @brief Compute C += A * B without packing, for the small products.
+     *
+     * @see gemm
+     */
+    template <class T>
+    void gemm_small(const size_t &m, const size_t &n, const size_t &k,
+                    const T *a, const size_t &rsa, const size_t &csa,
+                    const T *b, const size_t &rsb, const size_t &csb,
+                    T *c, const size_t &rsc, const size_t &csc)
+    {
+        // The rows of A and the columns of B are contiguous, as in A * B^T: each cell of C is a dot product
+        if (csa == 1 and rsb == 1)
+        {
+            for (size_t i = 0; i < m; i++)
+                for (size_t j = 0; j < n; j++)
+                {
+                    T sum = T();
+
+                    for (size_t p = 0; p < k; p++)
+                        sum += a[i * rsa + p] * b[p + j * csb];
+
+                    c[i * rsc + j * csc] += sum;
+                }
+
+            return;
+        }
+
+        // The columns of A and C are contiguous, as in A^T * B in the column-major layout:
+        // the j-k-i order reads A and writes C along their columns
+        if (rsa == 1 and rsc == 1)
+        {
+            for (size_t j = 0; j < n; j++)
+                for (size_t p = 0; p < k; p++)
+                {
+                    const T bpj = b[p * rsb + j * csb];
+
+                    for (size_t i = 0; i < m; i++)
+                        c[i + j * csc] += a[i + p * csa] * bpj;
+                }
+
+            return;
+        }
+
+        // The i-k-j order reads B and writes C along their rows
+        for (size_t i = 0; i < m; i++)
+            for (size_t p = 0; p < k; p++)
+            {
+                const T aip = a[i * rsa + p * csa];
+
+                for (size_t j = 0; j < n; j++)
+                    c[i * rsc + j * csc] += aip * b[p * rsb + j * csb];
+            }
+    }
+
+    // ==================================================
+    // ENGINE
+
+    /**
+     * @brief Compute C += A * B, where A is m x k, B is k x n and C is m x n.
+     * Each matrix is described by its first cell and the distances between two rows and two columns,
+     * so the operands can be stored in any layout.
+     *
+     * @param m The number of rows of A and C.
+     * @param n The number of columns of B and C.
+     * @param k The number of columns of A and rows of B.
+     * @param a The first cell of A.
+     * @param rsa The distance between two rows of A.
+     * @param csa The distance between two columns of A.
+     * @param b The first cell of B.
+     * @param rsb The distance between two rows of B.
+     * @param csb The distance between two columns of B.
+     * @param c The first cell of C.
+     * @param rsc The distance between two rows of C.
+     * @param csc The distance between two columns of C.
+     *
+     * @note C must not overlap A or B.
+     * @note PARALLELIZED METHOD with OpenMP. The blocks of rows of C are distributed across the threads.
+     */
+    template <class T>
+    void gemm(const size_t &m, const size_t &n, const size_t &k,
+              const T *a, const size_t &rsa, const size_t &csa,
+              const T *b, const size_t &rsb, const size_t &csb,
+              T *c, const size_t &rsc, const size_t &csc)
+    {
+        typedef blocking<T> blk;
+
+        if (m == 0 or n == 0 or k == 0)
+            return;
+
+        if (m * n * k <= blk::SMALL)
+            return gemm_small(m, n, k, a, rsa, csa, b, rsb, csb, c, rsc, csc);
+
+        // The packed block of B is shared by all the threads
+        const size_t nc_max = std::min(blk::NC, n);
+        const size_t kc_max = std::min(blk::KC, k);
+        T *bp = scratch<T>(1, kc_max * ((nc_max + blk::NR - 1) / blk::NR) * blk::NR);
+        const size_t mc_max = std::min(blk::MC, (m + blk::MR - 1) / blk::MR * blk::MR);
+
+        for (size_t jc = 0; jc < n; jc += blk::NC)
+        {
+            const size_t nc = std::min(blk::NC, n - jc);
+            const size_t panels = (nc + blk::NR - 1) / blk::NR;
+
+            for (size_t pc = 0; pc < k; pc += blk::KC)
+            {
+                const size_t kc = std::min(blk::KC, k - pc);
+
+                // Pack the block of B, one panel of NR columns per iteration
+                cmatrix_exec::for_each(cmatrix_parallel::PRODUCT, m * nc * kc, panels, [&](size_t jr)
+                                       { pack_b(kc, std::min(blk::NR, nc - jr * blk::NR),
+                                                b + pc * rsb + (jc + jr * blk::NR) * csb, rsb, csb,
+                                                bp + jr * blk::NR * kc); });
+
+                // Distribute the blocks of rows of C across the threads, each one packing its own blocks of A
+                cmatrix_exec::for_each(cmatrix_parallel::PRODUCT, m * nc * kc, (m + blk::MC - 1) / blk::MC, [&](size_t i)
+                                       {
+                    const size_t ic = i * blk::MC;
+                    const size_t mc = std::min(blk::MC, m - ic);
+                    T *ap = scratch<T>(0, mc_max * kc_max);
+
+                    pack_a(mc, kc, a + ic * rsa + pc * csa, rsa, csa, ap);
+                    macro_kernel(mc, nc, kc, ap, bp, c + ic * rsc + jc * csc, rsc, csc); }, true);
+            }
+        }
+    }
+}
+
+#endif // CMATRIX_GEMM_TPP
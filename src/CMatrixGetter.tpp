@@ -12,23 +12,30 @@
 // ==================================================
 // GET METHODS
 
-template <class T>
-cmatrix<T> cmatrix<T>::get(const cmatrix<cbool> &m) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::get(const cmatrix<cbool> &m) const
 {
-    const std::vector<std::pair<size_t, size_t>> &indexes = m.find_all(m);
-
     // Get all cells where the matrix m is true
+    // The true cells are found word by word, and counted to allocate the result once
     if (m.height() == height() and m.width() == width())
-        return cells(indexes);
+    {
+        cmatrix<T, Layout> res(1, m.matrix.count());
+        size_t i = 0;
+
+        m.matrix.for_each_set([&](const size_t &pos)
+                              { res.__at(0, i++) = __at(pos / width(), pos % width()); });
+
+        return res;
+    }
 
     // Get all rows where the matrix m is true
     else if (m.height() == height() and m.width() == 1)
     {
-        std::vector<size_t> indexes_rows(indexes.size());
+        std::vector<size_t> indexes_rows;
+        indexes_rows.reserve(m.matrix.count());
 
-        // Iterate over the indexes and get the rows ids
-        for (size_t i = 0; i < indexes.size(); i++)
-            indexes_rows[i] = indexes[i].first;
+        m.matrix.for_each_set([&](const size_t &row)
+                              { indexes_rows.push_back(row); });
 
         return rows(indexes_rows);
     }
@@ -36,11 +43,11 @@ cmatrix<T> cmatrix<T>::get(const cmatrix<cbool> &m) const
     // Get all columns where the matrix m is true
     else if (m.height() == 1 and m.width() == width())
     {
-        std::vector<size_t> indexes_columns(indexes.size());
+        std::vector<size_t> indexes_columns;
+        indexes_columns.reserve(m.matrix.count());
 
-        // Iterate over the indexes and get the columns ids
-        for (size_t i = 0; i < indexes.size(); i++)
-            indexes_columns[i] = indexes[i].second;
+        m.matrix.for_each_set([&](const size_t &col)
+                              { indexes_columns.push_back(col); });
 
         return columns(indexes_columns);
     }
@@ -52,22 +59,38 @@ cmatrix<T> cmatrix<T>::get(const cmatrix<cbool> &m) const
                                     std::to_string(m.width()));
 }
 
-template <class T>
-std::vector<T> cmatrix<T>::rows_vec(const size_t &n) const
+template <class T, class Layout>
+std::vector<T> cmatrix<T, Layout>::rows_vec(const size_t &n) const
 {
     __check_valid_row_id(n);
-    return matrix[n];
+
+    // The cells of a row are contiguous in the row-major layout
+    if (cmatrix_layout::is_row_major<Layout>::value)
+        return std::vector<T>(matrix.begin() + __index(n, 0), matrix.begin() + __index(n, 0) + width());
+
+    std::vector<T> row;
+    row.reserve(width());
+
+    for (size_t c = 0; c < width(); c++)
+        row.push_back(__at(n, c));
+
+    return row;
 }
 
-template <class T>
-std::vector<T> cmatrix<T>::columns_vec(const size_t &n) const
+template <class T, class Layout>
+std::vector<T> cmatrix<T, Layout>::columns_vec(const size_t &n) const
 {
     __check_valid_col_id(n);
+
+    // The cells of a column are contiguous in the column-major layout
+    if (not cmatrix_layout::is_row_major<Layout>::value)
+        return std::vector<T>(matrix.begin() + __index(0, n), matrix.begin() + __index(0, n) + height());
+
     std::vector<T> col;
     col.reserve(height());
 
-    for (const std::vector<T> &row : matrix)
-        col.push_back(row[n]);
+    for (size_t r = 0; r < height(); r++)
+        col.push_back(__at(r, n));
 
     return col;
 }
@@ -75,97 +98,230 @@ std::vector<T> cmatrix<T>::columns_vec(const size_t &n) const
 // ==================================================
 // GET SUBMATRIX METHODS
 
-template <class T>
-cmatrix<T> cmatrix<T>::rows(const size_t &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::rows(const size_t &ids) const
 {
     return rows({ids});
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::rows(const std::initializer_list<size_t> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::rows(const std::initializer_list<size_t> &ids) const
 {
     return rows(std::vector<size_t>(ids));
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::rows(const std::vector<size_t> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::rows(const std::vector<size_t> &ids) const
 {
-    cmatrix<T> m;
-
     for (const size_t &id : ids)
-    {
         __check_valid_row_id(id);
-        m.push_row_back(matrix[id]);
-    }
+
+    cmatrix<T, Layout> m(ids.size(), width());
+
+    // Copy each selected row in the new matrix
+    for (size_t i = 0; i < ids.size(); i++)
+        if (cmatrix_layout::is_row_major<Layout>::value)
+            std::copy(matrix.begin() + __index(ids[i], 0),
+                      matrix.begin() + __index(ids[i], 0) + width(),
+                      m.matrix.begin() + m.__index(i, 0));
+        else
+            for (size_t c = 0; c < width(); c++)
+                m.__at(i, c) = __at(ids[i], c);
 
     return m;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::columns(const size_t &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::columns(const size_t &ids) const
 {
     return columns({ids});
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::columns(const std::initializer_list<size_t> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::columns(const std::initializer_list<size_t> &ids) const
 {
     return columns(std::vector<size_t>(ids));
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::columns(const std::vector<size_t> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::columns(const std::vector<size_t> &ids) const
 {
-    cmatrix<T> m(height(), ids.size());
+    for (const size_t &id : ids)
+        __check_valid_col_id(id);
+
+    cmatrix<T, Layout> m(height(), ids.size());
 
+    // Copy each selected column in the new matrix
     for (size_t i = 0; i < ids.size(); i++)
-        m.set_column(i, columns_vec(ids[i]));
+        if (not cmatrix_layout::is_row_major<Layout>::value)
+            std::copy(matrix.begin() + __index(0, ids[i]),
+                      matrix.begin() + __index(0, ids[i]) + height(),
+                      m.matrix.begin() + m.__index(0, i));
+
+    // Otherwise, copy the selected cells row by row
+    for (size_t r = 0; cmatrix_layout::is_row_major<Layout>::value and r < height(); r++)
+        for (size_t i = 0; i < ids.size(); i++)
+            m.__at(r, i) = __at(r, ids[i]);
 
     return m;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::cells(const size_t &row, const size_t &col) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::cells(const size_t &row, const size_t &col) const
 {
     return cells({{row, col}});
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::cells(const std::initializer_list<std::pair<size_t, size_t>> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::cells(const std::initializer_list<std::pair<size_t, size_t>> &ids) const
 {
     return cells(std::vector<std::pair<size_t, size_t>>(ids));
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::cells(const std::vector<std::pair<size_t, size_t>> &ids) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::cells(const std::vector<std::pair<size_t, size_t>> &ids) const
 {
-    cmatrix<T> m(1, ids.size());
+    cmatrix<T, Layout> m(1, ids.size());
 
     // Iterate over the ids and set the cells
     for (size_t i = 0; i < ids.size(); i++)
-        m.set_cell(0, i, cell(ids[i].first, ids[i].second));
+        m.__at(0, i) = cell(ids[i].first, ids[i].second);
 
     return m;
 }
 
-template <class T>
-T &cmatrix<T>::cell(const size_t &row, const size_t &col)
+template <class T, class Layout>
+typename cmatrix<T, Layout>::storage_type::reference cmatrix<T, Layout>::cell(const size_t &row, const size_t &col)
 {
     __check_valid_row_id(row);
     __check_valid_col_id(col);
-    return matrix[row][col];
+
+    // The reference may be written after the matrix is copied: the buffer is not shared anymore
+    matrix.leak();
+    return matrix[__index(row, col)];
 }
 
-template <class T>
-T cmatrix<T>::cell(const size_t &row, const size_t &col) const
+template <class T, class Layout>
+T cmatrix<T, Layout>::cell(const size_t &row, const size_t &col) const
 {
     __check_valid_row_id(row);
     __check_valid_col_id(col);
-    return matrix[row][col];
+    return matrix[__index(row, col)];
+}
+
+template <class T, class Layout>
+typename cmatrix<T, Layout>::storage_type::reference cmatrix<T, Layout>::at_unchecked(const size_t &row, const size_t &col)
+{
+    matrix.leak();
+    return __at(row, col);
+}
+
+template <class T, class Layout>
+typename cmatrix<T, Layout>::storage_type::const_reference cmatrix<T, Layout>::at_unchecked(const size_t &row, const size_t &col) const
+{
+    return __at(row, col);
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::slice_rows(const size_t &start, const size_t &end) const
+template <class T, class Layout>
+T *cmatrix<T, Layout>::data()
+{
+    matrix.leak();
+    return matrix.data();
+}
+
+template <class T, class Layout>
+const T *cmatrix<T, Layout>::data() const
+{
+    return matrix.data();
+}
+
+template <class T, class Layout>
+T *cmatrix<T, Layout>::row_data(const size_t &row)
+{
+    static_assert(cmatrix_layout::is_row_major<Layout>::value, "The rows of a column-major matrix are not contiguous.");
+
+    if (CMATRIX_BOUNDS_CHECK)
+        __check_valid_row_id(row);
+
+    matrix.leak();
+    return matrix.data() + __index(row, 0);
+}
+
+template <class T, class Layout>
+const T *cmatrix<T, Layout>::row_data(const size_t &row) const
+{
+    static_assert(cmatrix_layout::is_row_major<Layout>::value, "The rows of a column-major matrix are not contiguous.");
+
+    if (CMATRIX_BOUNDS_CHECK)
+        __check_valid_row_id(row);
+
+    return matrix.data() + __index(row, 0);
+}
+
+template <class T, class Layout>
+T *cmatrix<T, Layout>::col_data(const size_t &col)
+{
+    static_assert(not cmatrix_layout::is_row_major<Layout>::value, "The columns of a row-major matrix are not contiguous.");
+
+    if (CMATRIX_BOUNDS_CHECK)
+        __check_valid_col_id(col);
+
+    matrix.leak();
+    return matrix.data() + __index(0, col);
+}
+
+template <class T, class Layout>
+const T *cmatrix<T, Layout>::col_data(const size_t &col) const
+{
+    static_assert(not cmatrix_layout::is_row_major<Layout>::value, "The columns of a row-major matrix are not contiguous.");
+
+    if (CMATRIX_BOUNDS_CHECK)
+        __check_valid_col_id(col);
+
+    return matrix.data() + __index(0, col);
+}
+
+template <class T, class Layout>
+size_t cmatrix<T, Layout>::__index(const size_t &row, const size_t &col) const
+{
+    return Layout::index(row, col, m_stride);
+}
+
+template <class T, class Layout>
+typename cmatrix<T, Layout>::storage_type::reference cmatrix<T, Layout>::__at(const size_t &row, const size_t &col)
+{
+    __check_bounds(row, col);
+    return matrix[__index(row, col)];
+}
+
+template <class T, class Layout>
+typename cmatrix<T, Layout>::storage_type::const_reference cmatrix<T, Layout>::__at(const size_t &row, const size_t &col) const
+{
+    __check_bounds(row, col);
+    return matrix[__index(row, col)];
+}
+
+template <class T, class Layout>
+cmatrix_view<T> cmatrix<T, Layout>::view() const
+{
+    return cmatrix_view<T>(matrix.data(), height(), width(), Layout::row_step(m_stride), Layout::col_step(m_stride));
+}
+
+template <class T, class Layout>
+typename cmatrix<T, Layout>::slice_type cmatrix<T, Layout>::slice_rows(const size_t &start, const size_t &end) const &
+{
+    return __slice_rows(start, end, std::is_same<T, cbool>());
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::slice_rows(const size_t &start, const size_t &end) &&
+{
+    // A view would dangle once the temporary matrix is destroyed
+    return cmatrix<T, Layout>(__slice_rows(start, end, std::is_same<T, cbool>()));
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::__slice_rows(const size_t &start, const size_t &end, std::true_type) const
 {
     __check_valid_row_id(start);
     __check_valid_row_id(end);
@@ -173,14 +329,36 @@ cmatrix<T> cmatrix<T>::slice_rows(const size_t &start, const size_t &end) const
     if (start > end)
         throw std::invalid_argument("The start index must be less than or equal to the end index");
 
-    // Create a vector of vectors from start to end containing the rows
-    std::vector<std::vector<T>> submatrix(matrix.begin() + start, matrix.begin() + end + 1);
+    cmatrix<T, Layout> m(end - start + 1, width());
+
+    for (size_t i = 0; i < m.height(); i++)
+        for (size_t j = 0; j < width(); j++)
+            m.__at(i, j) = __at(start + i, j);
+
+    return m;
+}
+
+template <class T, class Layout>
+cmatrix_view<T> cmatrix<T, Layout>::__slice_rows(const size_t &start, const size_t &end, std::false_type) const
+{
+    return view().slice_rows(start, end);
+}
 
-    return cmatrix<T>(submatrix);
+template <class T, class Layout>
+typename cmatrix<T, Layout>::slice_type cmatrix<T, Layout>::slice_columns(const size_t &start, const size_t &end) const &
+{
+    return __slice_columns(start, end, std::is_same<T, cbool>());
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::slice_columns(const size_t &start, const size_t &end) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::slice_columns(const size_t &start, const size_t &end) &&
+{
+    // A view would dangle once the temporary matrix is destroyed
+    return cmatrix<T, Layout>(__slice_columns(start, end, std::is_same<T, cbool>()));
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::__slice_columns(const size_t &start, const size_t &end, std::true_type) const
 {
     __check_valid_col_id(start);
     __check_valid_col_id(end);
@@ -188,44 +366,58 @@ cmatrix<T> cmatrix<T>::slice_columns(const size_t &start, const size_t &end) con
     if (start > end)
         throw std::invalid_argument("The start index must be less than or equal to the end index");
 
-    // Create a vector of ids from start to end
-    std::vector<size_t> ids(end - start + 1);
-    std::iota(ids.begin(), ids.end(), start);
+    cmatrix<T, Layout> m(height(), end - start + 1);
+
+    for (size_t i = 0; i < height(); i++)
+        for (size_t j = 0; j < m.width(); j++)
+            m.__at(i, j) = __at(i, start + j);
 
-    return columns(ids);
+    return m;
+}
+
+template <class T, class Layout>
+cmatrix_view<T> cmatrix<T, Layout>::__slice_columns(const size_t &start, const size_t &end, std::false_type) const
+{
+    return view().slice_columns(start, end);
 }
 
 // ==================================================
 // DIM METHODS
 
-template <class T>
-size_t cmatrix<T>::width() const
+template <class T, class Layout>
+size_t cmatrix<T, Layout>::width() const
+{
+    return m_width;
+}
+
+template <class T, class Layout>
+size_t cmatrix<T, Layout>::stride() const
 {
-    return height() == 0 ? 0 : matrix[0].size();
+    return m_stride;
 }
 
-template <class T>
-size_t cmatrix<T>::height() const
+template <class T, class Layout>
+size_t cmatrix<T, Layout>::height() const
 {
-    return matrix.size();
+    return m_height;
 }
 
-template <class T>
-std::pair<size_t, size_t> cmatrix<T>::size() const
+template <class T, class Layout>
+std::pair<size_t, size_t> cmatrix<T, Layout>::size() const
 {
     return std::pair<size_t, size_t>(height(), width());
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-U cmatrix<T>::height_t() const
+U cmatrix<T, Layout>::height_t() const
 {
     return (U)height();
 }
 
-template <class T>
+template <class T, class Layout>
 template <class U>
-U cmatrix<T>::width_t() const
+U cmatrix<T, Layout>::width_t() const
 {
     return (U)width();
 }
@@ -233,29 +425,77 @@ U cmatrix<T>::width_t() const
 // ==================================================
 // SIMILARS MATRIX
 
-template <class T>
-cmatrix<T> cmatrix<T>::transpose() const
+template <class T, class Layout>
+typename cmatrix<T, Layout>::transpose_type cmatrix<T, Layout>::transpose() const
+{
+    return __transpose(std::is_same<T, cbool>());
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::__transpose(std::true_type) const
 {
     // Create a new matrix with the inverted dimensions
-    cmatrix<T> m(width(), height());
+    cmatrix<T, Layout> m(width(), height());
+    transpose_into(m);
 
-// Swap the rows and the columns
-#pragma omp parallel for collapse(2)
-    for (size_t r = 0; r < height(); r++)
-        for (size_t c = 0; c < width(); c++)
-            m.set_cell(c, r, cell(r, c));
+    return m;
+}
+
+template <class T, class Layout>
+cmatrix<T, typename cmatrix_layout::transposed<Layout>::type> cmatrix<T, Layout>::__transpose(std::false_type) const
+{
+    // The lines of the buffer are the rows of the matrix and the columns of its transpose, or the reverse:
+    // the transpose shares the buffer, with the inverted dimensions and the same stride
+    cmatrix<T, typename cmatrix_layout::transposed<Layout>::type> m;
+    m.matrix = matrix;
+    m.m_height = width();
+    m.m_width = height();
+    m.m_stride = m_stride;
 
     return m;
 }
 
-template <class T>
-std::vector<T> cmatrix<T>::diag() const
+template <class T, class Layout>
+void cmatrix<T, Layout>::transpose_into(cmatrix<T, Layout> &out) const
+{
+    // The cells would be overwritten before being read
+    if (&out == this)
+        throw std::invalid_argument("The output matrix must not be the transposed matrix.");
+
+    __check_out(out, width(), height());
+
+    // The lines of the matrix are the columns of its transpose in the same layout
+    __transpose_into(out, std::is_same<T, cbool>());
+}
+
+template <class T, class Layout>
+template <class M>
+void cmatrix<T, Layout>::__transpose_into(cmatrix<T, M> &out, std::true_type) const
+{
+    // Take the iterator once, so a shared buffer is copied before the threads write in it
+    cmatrix_transpose::transpose(matrix.cbegin(), m_stride, out.matrix.begin(), out.m_stride,
+                                 Layout::lines(height(), width()), Layout::length(height(), width()));
+}
+
+template <class T, class Layout>
+template <class M>
+void cmatrix<T, Layout>::__transpose_into(cmatrix<T, M> &out, std::false_type) const
+{
+    const storage_type &in = matrix;
+
+    // Take the buffer once, so a shared buffer is copied before the threads write in it
+    cmatrix_transpose::transpose(in.data(), m_stride, out.matrix.data(), out.m_stride,
+                                 Layout::lines(height(), width()), Layout::length(height(), width()));
+}
+
+template <class T, class Layout>
+std::vector<T> cmatrix<T, Layout>::diag() const
 {
     std::vector<T> d(std::min(width(), height()));
 
     // Iterate over the diagonal of a matrix potentially not square
     for (size_t i = 0; i < d.size(); i++)
-        d[i] = cell(i, i);
+        d[i] = __at(i, i);
 
     return d;
 }
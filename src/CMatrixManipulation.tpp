@@ -12,13 +12,17 @@
 // ==================================================
 // INSERT FUNCTIONS
 
-template <class T>
-void cmatrix<T>::insert_row(const size_t &pos, const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::insert_row(const size_t &pos, const std::vector<T> &val)
 {
     // If the matrix is empty, we can insert the row of any size
     // However, the position must be 0
     if (is_empty())
+    {
         __check_expected_id(pos, 0);
+        __reset(1, val.size());
+        set_row(0, val);
+    }
 
     // Otherwise, we can only insert a row of the same size as the others
     // The position must be between 0 and the number of rows
@@ -26,13 +30,17 @@ void cmatrix<T>::insert_row(const size_t &pos, const std::vector<T> &val)
     {
         __check_expected_id(pos, 0, height());
         __check_valid_row(val);
-    }
 
-    matrix.insert(matrix.begin() + pos, val);
+        // A row is a line of the buffer in the row-major layout, and a cell of each line otherwise
+        if (cmatrix_layout::is_row_major<Layout>::value)
+            __insert_line(pos, val);
+        else
+            __insert_across(pos, val);
+    }
 }
 
-template <class T>
-void cmatrix<T>::insert_column(const size_t &pos, const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::insert_column(const size_t &pos, const std::vector<T> &val)
 {
     // If the matrix is empty, we can insert the column of any size
     if (is_empty())
@@ -41,8 +49,8 @@ void cmatrix<T>::insert_column(const size_t &pos, const std::vector<T> &val)
         __check_expected_id(pos, 0);
 
         // Insert the column
-        for (size_t i = 0; i < val.size(); i++)
-            matrix.push_back(std::vector<T>{val[i]});
+        __reset(val.size(), 1);
+        set_column(0, val);
     }
 
     // Otherwise, we can only insert a column of the same size as the others
@@ -52,39 +60,66 @@ void cmatrix<T>::insert_column(const size_t &pos, const std::vector<T> &val)
         __check_expected_id(pos, 0, width());
         __check_valid_col(val);
 
-        // Reserve the space for the new column
-        matrix.reserve(height() + val.size());
-
-        // For each row, insert the value at the given position
-        #pragma omp parallel for
-        for (size_t i = 0; i < height(); i++)
-            matrix[i].insert(matrix[i].begin() + pos, val[i]);
+        // A column is a cell of each line of the buffer in the row-major layout, and a line otherwise
+        if (cmatrix_layout::is_row_major<Layout>::value)
+            __insert_across(pos, val);
+        else
+            __insert_line(pos, val);
     }
 }
 
-// ==================================================
-// PUSH FUNCTIONS
+template <class T, class Layout>
+void cmatrix<T, Layout>::__insert_line(const size_t &pos, const std::vector<T> &val)
+{
+    // Shift the following lines and copy the new one in the buffer, with its padding
+    std::vector<T> line(val);
+    line.resize(m_stride);
+    matrix.insert(matrix.begin() + pos * m_stride, line.begin(), line.end());
+
+    (cmatrix_layout::is_row_major<Layout>::value ? m_height : m_width)++;
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::__insert_across(const size_t &pos, const std::vector<T> &val)
+{
+    const bool rows = cmatrix_layout::is_row_major<Layout>::value;
+    const size_t &length = Layout::length(height(), width());
+
+    // Build the new buffer with one more cell in each line
+    cmatrix<T, Layout> m(rows ? height() : height() + 1, rows ? width() + 1 : width());
+    typename storage_type::const_iterator in = matrix.cbegin();
+    typename storage_type::iterator out = m.matrix.begin();
+
+    // For each line, copy the cells around the given position and insert the value
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, m.height() * m.width(), val.size(), [&](size_t i)
+                           {
+        std::copy(in + i * m_stride, in + i * m_stride + pos, out + i * m.m_stride);
+        out[i * m.m_stride + pos] = val[i];
+        std::copy(in + i * m_stride + pos, in + i * m_stride + length, out + i * m.m_stride + pos + 1); });
 
-template <class T>
-void cmatrix<T>::push_row_front(const std::vector<T> &val)
+    *this = std::move(m);
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::push_row_front(const std::vector<T> &val)
 {
     insert_row(0, val);
 }
 
-template <class T>
-void cmatrix<T>::push_row_back(const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::push_row_back(const std::vector<T> &val)
 {
     insert_row(height(), val);
 }
 
-template <class T>
-void cmatrix<T>::push_col_front(const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::push_col_front(const std::vector<T> &val)
 {
     insert_column(0, val);
 }
 
-template <class T>
-void cmatrix<T>::push_col_back(const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::push_col_back(const std::vector<T> &val)
 {
     insert_column(width(), val);
 }
@@ -92,8 +127,8 @@ void cmatrix<T>::push_col_back(const std::vector<T> &val)
 // ==================================================
 // FIND FUNCTIONS
 
-template <class T>
-int cmatrix<T>::find_row(const std::function<bool(std::vector<T>)> &f) const
+template <class T, class Layout>
+int cmatrix<T, Layout>::find_row(const std::function<bool(std::vector<T>)> &f) const
 {
     // For each row, check if the condition is satisfied
     for (size_t row = 0; row < height(); row++)
@@ -103,15 +138,15 @@ int cmatrix<T>::find_row(const std::function<bool(std::vector<T>)> &f) const
     return -1;
 }
 
-template <class T>
-int cmatrix<T>::find_row(const std::vector<T> &val) const
+template <class T, class Layout>
+int cmatrix<T, Layout>::find_row(const std::vector<T> &val) const
 {
     return find_row([&](std::vector<T> row)
                     { return row == val; });
 }
 
-template <class T>
-int cmatrix<T>::find_column(const std::function<bool(std::vector<T>)> &f) const
+template <class T, class Layout>
+int cmatrix<T, Layout>::find_column(const std::function<bool(std::vector<T>)> &f) const
 {
     // For each column, check if the condition is satisfied
     for (size_t col = 0; col < width(); col++)
@@ -121,48 +156,62 @@ int cmatrix<T>::find_column(const std::function<bool(std::vector<T>)> &f) const
     return -1;
 }
 
-template <class T>
-int cmatrix<T>::find_column(const std::vector<T> &val) const
+template <class T, class Layout>
+int cmatrix<T, Layout>::find_column(const std::vector<T> &val) const
 {
     return find_column([&](std::vector<T> col)
                        { return col == val; });
 }
 
-template <class T>
-std::pair<int, int> cmatrix<T>::find(const std::function<bool(T)> &f) const
+template <class T, class Layout>
+std::pair<int, int> cmatrix<T, Layout>::find(const std::function<bool(T)> &f) const
+{
+    return find<const std::function<bool(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<std::pair<int, int>, F, T> cmatrix<T, Layout>::find(F &&f) const
 {
     // For each cell, check if the condition is satisfied
     for (size_t row = 0; row < height(); row++)
         for (size_t col = 0; col < width(); col++)
-            if (f(cell(row, col)))
+            if (f(__at(row, col)))
                 return std::pair<int, int>(int(row), int(col));
 
     return std::pair<int, int>(-1, -1);
 }
 
-template <class T>
-std::pair<int, int> cmatrix<T>::find(const T &val) const
+template <class T, class Layout>
+std::pair<int, int> cmatrix<T, Layout>::find(const T &val) const
 {
     return find([&](T e)
                 { return e == val; });
 }
 
-template <class T>
-std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const std::function<bool(T)> &f) const
+template <class T, class Layout>
+std::vector<std::pair<size_t, size_t>> cmatrix<T, Layout>::find_all(const std::function<bool(T)> &f) const
+{
+    return find_all<const std::function<bool(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<std::vector<std::pair<size_t, size_t>>, F, T> cmatrix<T, Layout>::find_all(F &&f) const
 {
     std::vector<std::pair<size_t, size_t>> res;
 
     // For each cell, check if the condition is satisfied
     for (size_t row = 0; row < height(); row++)
         for (size_t col = 0; col < width(); col++)
-            if (f(cell(row, col)))
+            if (f(__at(row, col)))
                 res.push_back(std::pair<size_t, size_t>(row, col));
 
     return res;
 }
 
-template <class T>
-std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const cmatrix<cbool> &m) const
+template <class T, class Layout>
+std::vector<std::pair<size_t, size_t>> cmatrix<T, Layout>::find_all(const cmatrix<cbool> &m) const
 {
     // To select indexes of the mask that are true in the mask
     const bool &select_cells = m.height() == height() and m.width() == width();
@@ -173,29 +222,35 @@ std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const cmatrix<cbool>
     // To select indexes of the columns that are true in the mask
     const bool &select_cols = m.height() == 1 and m.width() == width();
 
-    if (select_cells or select_rows or select_cols)
+    std::vector<std::pair<size_t, size_t>> ids;
+
+    // The true cells of the mask are found word by word, in the order of the rows
+    if (select_cells)
     {
-        std::vector<std::pair<size_t, size_t>> ids;
-        ids.reserve(m.sum_all());
+        ids.reserve(m.matrix.count());
+        m.matrix.for_each_set([&](const size_t &pos)
+                              { ids.push_back(std::pair<size_t, size_t>(pos / width(), pos % width())); });
+    }
 
-        // For each cell, check if the condition is satisfied
-        for (size_t row = 0; row < height(); row++)
-            for (size_t col = 0; col < width(); col++)
-            {
-                // Check if the current INDEX is true in the mask
-                const bool &cells = select_cells && m.cell(row, col);
-                
-                // Check if the current ROW is true in the mask
-                const bool &rows = select_rows && m.cell(row, 0);
-                
-                // Check if the current COLUMN is true in the mask
-                const bool &cols = select_cols && m.cell(0, col);
-
-                if (cells or rows or cols)
-                    ids.push_back(std::pair<size_t, size_t>(row, col));
-            }
+    // Select every cell of the true rows
+    else if (select_rows)
+    {
+        ids.reserve(m.matrix.count() * width());
+        m.matrix.for_each_set([&](const size_t &row)
+                              {
+                                  for (size_t col = 0; col < width(); col++)
+                                      ids.push_back(std::pair<size_t, size_t>(row, col));
+                              });
+    }
+
+    // Select the true columns of every row
+    else if (select_cols)
+    {
+        ids.reserve(m.matrix.count() * height());
 
-        return ids;
+        for (size_t row = 0; row < height(); row++)
+            m.matrix.for_each_set([&](const size_t &col)
+                                  { ids.push_back(std::pair<size_t, size_t>(row, col)); });
     }
 
     else
@@ -207,10 +262,12 @@ std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const cmatrix<cbool>
                                     std::to_string(m.height()) +
                                     "x" +
                                     std::to_string(m.width()));
+
+    return ids;
 }
 
-template <class T>
-std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const T &val) const
+template <class T, class Layout>
+std::vector<std::pair<size_t, size_t>> cmatrix<T, Layout>::find_all(const T &val) const
 {
     return find_all([&](T e)
                     { return e == val; });
@@ -219,180 +276,559 @@ std::vector<std::pair<size_t, size_t>> cmatrix<T>::find_all(const T &val) const
 // ==================================================
 // MASK FUNCTIONS
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::mask(const std::function<bool(T)> &f) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::mask(const std::function<bool(T)> &f) const
+{
+    return mask<const std::function<bool(T)> &>(f);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T> cmatrix<T, Layout>::mask(F &&f) const
 {
     cmatrix<cbool> res(height(), width(), false);
+    mask_into(res, std::forward<F>(f));
 
-    // For each cell, check if the condition is satisfied
-    for (size_t row = 0; row < height(); row++)
-        for (size_t col = 0; col < width(); col++)
-            res.set_cell(row, col, f(cell(row, col)));
+    return res;
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<void, F, T> cmatrix<T, Layout>::mask_into(cmatrix<cbool> &out_mask, F &&f) const
+{
+    __check_out(out_mask, height(), width());
+
+    std::uint64_t *out = out_mask.matrix.words();
+    const size_t n = height() * width();
+    size_t r = 0, c = 0;
+
+    // Build each word of the mask, then write it at once
+    // The cells are read row by row, whatever the layout and the padding of the buffer
+    for (size_t i = 0; i < n; i += cmatrix_bits::WORD)
+    {
+        std::uint64_t word = 0;
+
+        for (size_t j = 0; j < cmatrix_bits::WORD and i + j < n; j++)
+        {
+            word |= std::uint64_t(f(matrix[__index(r, c)])) << j;
+
+            if (++c == width())
+            {
+                c = 0;
+                r++;
+            }
+        }
+
+        out[i / cmatrix_bits::WORD] = word;
+    }
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::mask(const std::function<bool(T, T)> &f, const cmatrix<T, Layout> &m) const
+{
+    return mask<const std::function<bool(T, T)> &>(f, m);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T, T> cmatrix<T, Layout>::mask(F &&f, const cmatrix<T, Layout> &m) const
+{
+    // Create the result matrix
+    cmatrix<cbool> res(height(), width(), false);
+    mask_into(res, std::forward<F>(f), m);
 
     return res;
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::mask(const std::function<bool(T, T)> &f, const cmatrix<T> &m) const
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<void, F, T, T> cmatrix<T, Layout>::mask_into(cmatrix<cbool> &out_mask, F &&f, const cmatrix<T, Layout> &m) const
 {
     // Check if the matrices have the same size
     __check_size(m);
+    __check_out(out_mask, height(), width());
 
-    // Create the result matrix
-    cmatrix<cbool> res(height(), width(), false);
+    std::uint64_t *out = out_mask.matrix.words();
+    const size_t n = height() * width();
+    size_t r = 0, c = 0;
 
-    // For each cell, check if the condition is satisfied
-    for (size_t row = 0; row < height(); row++)
-        for (size_t col = 0; col < width(); col++)
-            res.set_cell(row, col, f(cell(row, col), m.cell(row, col)));
+    // Build each word of the mask, then write it at once
+    // The cells are read row by row, whatever the layout and the padding of the buffer
+    for (size_t i = 0; i < n; i += cmatrix_bits::WORD)
+    {
+        std::uint64_t word = 0;
+
+        for (size_t j = 0; j < cmatrix_bits::WORD and i + j < n; j++)
+        {
+            word |= std::uint64_t(f(matrix[__index(r, c)], m.matrix[m.__index(r, c)])) << j;
+
+            if (++c == width())
+            {
+                c = 0;
+                r++;
+            }
+        }
+
+        out[i / cmatrix_bits::WORD] = word;
+    }
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::mask(const std::function<bool(T, T)> &f, const cmatrix_view<T> &m) const
+{
+    return mask<const std::function<bool(T, T)> &>(f, m);
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<cmatrix<cbool>, F, T, T> cmatrix<T, Layout>::mask(F &&f, const cmatrix_view<T> &m) const
+{
+    cmatrix<cbool> res(height(), width(), false);
+    mask_into(res, std::forward<F>(f), m);
 
     return res;
 }
 
+template <class T, class Layout>
+template <class F>
+cmatrix_fn::if_callable_t<void, F, T, T> cmatrix<T, Layout>::mask_into(cmatrix<cbool> &out_mask, F &&f, const cmatrix_view<T> &m) const
+{
+    // Check if the matrix and the view have the same size
+    __check_size(m.size());
+    __check_out(out_mask, height(), width());
+
+    std::uint64_t *out = out_mask.matrix.words();
+    const size_t n = height() * width();
+    size_t r = 0, c = 0;
+
+    // The cells of the view are read through its strides, so a strided or transposed view is not copied
+    for (size_t i = 0; i < n; i += cmatrix_bits::WORD)
+    {
+        std::uint64_t word = 0;
+
+        for (size_t j = 0; j < cmatrix_bits::WORD and i + j < n; j++)
+        {
+            word |= std::uint64_t(f(matrix[__index(r, c)], m(r, c))) << j;
+
+            if (++c == width())
+            {
+                c = 0;
+                r++;
+            }
+        }
+
+        out[i / cmatrix_bits::WORD] = word;
+    }
+}
+
 template <> inline
 cmatrix<cbool> cmatrix<cbool>::not_() const
 {
-    return map([](cbool e)
-               { return not e; });
+    cmatrix<cbool> res(height(), width());
+    const std::uint64_t *a = matrix.words();
+    std::uint64_t *out = res.matrix.words();
+
+    // Negate 64 cells at once
+    for (size_t w = 0; w < matrix.nwords(); w++)
+        out[w] = ~a[w];
+
+    res.matrix.clear_tail();
+    return res;
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::eq(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::eq(const cmatrix<T, Layout> &m) const
 {
-    return mask(std::equal_to<T>(), m);
+    return __compare<cmatrix_simd::EQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::eq(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::eq(const cmatrix_view<T> &m) const
 {
-    return mask([val](T e)
-                { return e == val; });
+    return __compare<cmatrix_simd::EQ>(m);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::eq(const T &val) const
+{
+    return __compare<cmatrix_simd::EQ>(val);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::neq(const cmatrix<T, Layout> &m) const
+{
+    return __compare<cmatrix_simd::NEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::neq(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::neq(const cmatrix_view<T> &m) const
 {
-    return mask(std::not_equal_to<T>(), m);
+    return __compare<cmatrix_simd::NEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::neq(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::neq(const T &val) const
 {
-    return mask([val](T e)
-                { return e != val; });
+    return __compare<cmatrix_simd::NEQ>(val);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::leq(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::leq(const cmatrix<T, Layout> &m) const
 {
-    return mask(std::less_equal<T>(), m);
+    return __compare<cmatrix_simd::LEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::leq(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::leq(const cmatrix_view<T> &m) const
 {
-    return mask([val](T e)
-                { return e <= val; });
+    return __compare<cmatrix_simd::LEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::geq(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::leq(const T &val) const
 {
-    return mask(std::greater_equal<T>(), m);
+    return __compare<cmatrix_simd::LEQ>(val);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::geq(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::geq(const cmatrix<T, Layout> &m) const
 {
-    return mask([val](T e)
-                { return e >= val; });
+    return __compare<cmatrix_simd::GEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::lt(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::geq(const cmatrix_view<T> &m) const
 {
-    return mask(std::less<T>(), m);
+    return __compare<cmatrix_simd::GEQ>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::lt(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::geq(const T &val) const
 {
-    return mask([val](T e)
-                { return e < val; });
+    return __compare<cmatrix_simd::GEQ>(val);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::gt(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::lt(const cmatrix<T, Layout> &m) const
 {
-    return mask(std::greater<T>(), m);
+    return __compare<cmatrix_simd::LT>(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::gt(const T &val) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::lt(const cmatrix_view<T> &m) const
 {
-    return mask([val](T e)
-                { return e > val; });
+    return __compare<cmatrix_simd::LT>(m);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::lt(const T &val) const
+{
+    return __compare<cmatrix_simd::LT>(val);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::gt(const cmatrix<T, Layout> &m) const
+{
+    return __compare<cmatrix_simd::GT>(m);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::gt(const cmatrix_view<T> &m) const
+{
+    return __compare<cmatrix_simd::GT>(m);
+}
+
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::gt(const T &val) const
+{
+    return __compare<cmatrix_simd::GT>(val);
+}
+
+template <class T, class Layout>
+template <cmatrix_simd::cmp C>
+cmatrix<cbool> cmatrix<T, Layout>::__compare(const cmatrix<T, Layout> &m) const
+{
+    // The padded or column-major buffers are compared cell by cell
+    if (m.height() != height() or m.width() != width() or m_stride != width() or not cmatrix_layout::is_row_major<Layout>::value)
+        return __compare_broadcast<C>(m);
+
+    cmatrix<cbool> res(height(), width());
+    const size_t n = height() * width();
+    const size_t chunks = (n + cmatrix_simd::CHUNK - 1) / cmatrix_simd::CHUNK;
+
+    // A chunk is a multiple of 64 cells, so each chunk writes its own words of the mask
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, n, chunks, [&](size_t i)
+                           {
+        const size_t begin = i * cmatrix_simd::CHUNK;
+        cmatrix_simd::compare<C>(matrix.data() + begin, m.matrix.data() + begin,
+                                 res.matrix.words() + begin / cmatrix_bits::WORD,
+                                 std::min(cmatrix_simd::CHUNK, n - begin)); });
+
+    return res;
+}
+
+template <class T, class Layout>
+template <cmatrix_simd::cmp C>
+cmatrix<cbool> cmatrix<T, Layout>::__compare(const T &val) const
+{
+    cmatrix<cbool> res(height(), width());
+
+    // The padded or column-major buffers are compared cell by cell
+    if (m_stride != width() or not cmatrix_layout::is_row_major<Layout>::value)
+    {
+        mask_into(res, [&val](const T &x) { return cmatrix_simd::scalar_cmp<C>::apply(x, val); });
+        return res;
+    }
+
+    const size_t n = height() * width();
+    const size_t chunks = (n + cmatrix_simd::CHUNK - 1) / cmatrix_simd::CHUNK;
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, n, chunks, [&](size_t i)
+                           {
+        const size_t begin = i * cmatrix_simd::CHUNK;
+        cmatrix_simd::compare_scalar<C>(matrix.data() + begin, val,
+                                        res.matrix.words() + begin / cmatrix_bits::WORD,
+                                        std::min(cmatrix_simd::CHUNK, n - begin)); });
+
+    return res;
+}
+
+template <class T, class Layout>
+template <cmatrix_simd::cmp C>
+cmatrix<cbool> cmatrix<T, Layout>::__compare_broadcast(const cmatrix<T, Layout> &m) const
+{
+    const std::pair<size_t, size_t> size = cmatrix_expr::broadcast_size(height(), width(), m.height(), m.width());
+    cmatrix<cbool> res(size.first, size.second);
+    std::uint64_t *out = res.matrix.words();
+    const size_t cells = res.height() * res.width();
+
+    // The single row or column of an operand is read in place, with a step of 0
+    const size_t a_row = height() == 1 ? 0 : 1, a_col = width() == 1 ? 0 : 1;
+    const size_t b_row = m.height() == 1 ? 0 : 1, b_col = m.width() == 1 ? 0 : 1;
+
+    // Each thread builds whole words, so two threads never write the same word
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, cells, res.matrix.nwords(), [&](size_t w)
+                           {
+        std::uint64_t word = 0;
+
+        for (size_t b = 0; b < cmatrix_bits::WORD and w * cmatrix_bits::WORD + b < cells; b++)
+        {
+            const size_t r = (w * cmatrix_bits::WORD + b) / res.width();
+            const size_t c = (w * cmatrix_bits::WORD + b) % res.width();
+            const bool bit = cmatrix_simd::scalar_cmp<C>::apply(T(__at(r * a_row, c * a_col)), T(m.__at(r * b_row, c * b_col)));
+            word |= std::uint64_t(bit) << b;
+        }
+
+        out[w] = word; });
+
+    return res;
+}
+
+template <class T, class Layout>
+template <cmatrix_simd::cmp C>
+cmatrix<cbool> cmatrix<T, Layout>::__compare(const cmatrix_view<T> &m) const
+{
+    const std::pair<size_t, size_t> size = cmatrix_expr::broadcast_size(height(), width(), m.height(), m.width());
+    cmatrix<cbool> res(size.first, size.second);
+    std::uint64_t *out = res.matrix.words();
+    const size_t cells = res.height() * res.width();
+
+    // Both operands are read through views, so a single row or column is repeated with a step of 0
+    cmatrix_view<T> a = view(), b = m;
+    a.broadcast_to(size.first, size.second);
+    b.broadcast_to(size.first, size.second);
+
+    // Each thread builds whole words, so two threads never write the same word
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, cells, res.matrix.nwords(), [&](size_t w)
+                           {
+        std::uint64_t word = 0;
+
+        for (size_t i = 0; i < cmatrix_bits::WORD and w * cmatrix_bits::WORD + i < cells; i++)
+        {
+            const size_t r = (w * cmatrix_bits::WORD + i) / res.width();
+            const size_t c = (w * cmatrix_bits::WORD + i) % res.width();
+            word |= std::uint64_t(cmatrix_simd::scalar_cmp<C>::apply(a(r, c), b(r, c))) << i;
+        }
+
+        out[w] = word; });
+
+    return res;
+}
+
+template <>
+template <cmatrix_simd::cmp C>
+inline cmatrix<cbool> cmatrix<cbool>::__compare(const cmatrix<cbool> &m) const
+{
+    if (m.height() != height() or m.width() != width())
+        return __compare_broadcast<C>(m);
+
+    cmatrix<cbool> res(height(), width());
+    const std::uint64_t *a = matrix.words();
+    const std::uint64_t *b = m.matrix.words();
+    std::uint64_t *out = res.matrix.words();
+
+    // Compare 64 cells at once with the logical operators
+    for (size_t w = 0; w < matrix.nwords(); w++)
+        out[w] = cmatrix_bits::word_cmp<C>::apply(a[w], b[w]);
+
+    res.matrix.clear_tail();
+    return res;
+}
+
+template <>
+template <cmatrix_simd::cmp C>
+inline cmatrix<cbool> cmatrix<cbool>::__compare(const cbool &val) const
+{
+    cmatrix<cbool> res(height(), width());
+    const std::uint64_t *a = matrix.words();
+    const std::uint64_t b = val ? ~std::uint64_t(0) : 0;
+    std::uint64_t *out = res.matrix.words();
+
+    for (size_t w = 0; w < matrix.nwords(); w++)
+        out[w] = cmatrix_bits::word_cmp<C>::apply(a[w], b);
+
+    res.matrix.clear_tail();
+    return res;
 }
 
 // ==================================================
 // ERASE FUNCTIONS
 
-template <class T>
-void cmatrix<T>::remove_row(const size_t &pos)
+template <class T, class Layout>
+void cmatrix<T, Layout>::remove_row(const size_t &pos)
 {
     __check_valid_row_id(pos);
-    matrix.erase(matrix.begin() + pos);
+
+    // A matrix without rows has no columns
+    if (height() == 1)
+        clear();
+
+    // Otherwise, remove the line of the row, or its cell in each line
+    else if (cmatrix_layout::is_row_major<Layout>::value)
+        __remove_line(pos);
+
+    else
+        __remove_across(pos);
 }
 
-template <class T>
-void cmatrix<T>::remove_column(const size_t &pos)
+template <class T, class Layout>
+void cmatrix<T, Layout>::remove_column(const size_t &pos)
 {
     __check_valid_col_id(pos);
 
     // If the matrix has only one column, we can clear it
     // To prevent matrix = [[]]
     if (width() == 1)
-        matrix.clear();
+        clear();
+
+    // Otherwise, remove the cell of the column in each line, or its line
+    else if (cmatrix_layout::is_row_major<Layout>::value)
+        __remove_across(pos);
 
-    // Otherwise, for each row, remove the value at the given position
     else
-        for (size_t i = 0; i < height(); i++)
-            matrix[i].erase(matrix[i].begin() + pos);
+        __remove_line(pos);
 }
 
-template <class T>
-void cmatrix<T>::concatenate(const cmatrix<T> &m, const unsigned int &axis)
+template <class T, class Layout>
+void cmatrix<T, Layout>::__remove_line(const size_t &pos)
 {
-    // Concatenate the rows
-    if (axis == 0)
+    // Shift the following lines in the buffer
+    matrix.erase(matrix.begin() + pos * m_stride, matrix.begin() + (pos + 1) * m_stride);
+
+    (cmatrix_layout::is_row_major<Layout>::value ? m_height : m_width)--;
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::__remove_across(const size_t &pos)
+{
+    const bool rows = cmatrix_layout::is_row_major<Layout>::value;
+    const size_t &lines = Layout::lines(height(), width());
+    const size_t &length = Layout::length(height(), width());
+
+    cmatrix<T, Layout> m(rows ? height() : height() - 1, rows ? width() - 1 : width());
+    typename storage_type::const_iterator in = matrix.cbegin();
+    typename storage_type::iterator out = m.matrix.begin();
+
+    // For each line, copy the cells around the given position
+    for (size_t i = 0; i < lines; i++)
     {
-        if (width() != m.width())
-            throw std::invalid_argument("The matrices must have the same number of columns. Actual: " +
-                                        std::to_string(width()) +
-                                        " and " +
-                                        std::to_string(m.width()));
-
-        // Push the rows of the second matrix
-        for (size_t i = 0; i < m.height(); i++)
-            push_row_back(m.rows_vec(i));
+        std::copy(in + i * m_stride, in + i * m_stride + pos, out + i * m.m_stride);
+        std::copy(in + i * m_stride + pos + 1, in + i * m_stride + length, out + i * m.m_stride + pos);
     }
 
+    *this = std::move(m);
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::concatenate(const cmatrix<T, Layout> &m, const unsigned int &axis)
+{
+    // Concatenate the rows
+    if (axis == 0 and width() != m.width())
+        throw std::invalid_argument("The matrices must have the same number of columns. Actual: " +
+                                    std::to_string(width()) +
+                                    " and " +
+                                    std::to_string(m.width()));
+
     // Concatenate the columns
-    else if (axis == 1)
+    else if (axis == 1 and height() != m.height())
+        throw std::invalid_argument("The matrices must have the same number of rows. Actual: " +
+                                    std::to_string(height()) +
+                                    " and " +
+                                    std::to_string(m.height()));
+
+    else if (axis > 1)
+        throw std::invalid_argument("The axis must be 0 or 1. Actual: " + std::to_string(axis));
+
+    cmatrix<T, Layout> res(axis == 0 ? height() + m.height() : height(), axis == 0 ? width() : width() + m.width());
+    typename storage_type::iterator out = res.matrix.begin();
+
+    // The lines of both matrices are concatenated: copy both buffers one after the other
+    if ((axis == 0) == cmatrix_layout::is_row_major<Layout>::value)
     {
-        if (height() != m.height())
-            throw std::invalid_argument("The matrices must have the same number of rows. Actual: " +
-                                        std::to_string(height()) +
-                                        " and " +
-                                        std::to_string(m.height()));
-
-        // Push the columns of the second matrix
-        for (size_t i = 0; i < m.width(); i++)
-            push_col_back(m.columns_vec(i));
+        std::copy(matrix.cbegin(), matrix.cend(), out);
+        std::copy(m.matrix.cbegin(), m.matrix.cend(), out + matrix.size());
     }
 
+    // Otherwise, copy both lines side by side
     else
-        throw std::invalid_argument("The axis must be 0 or 1. Actual: " + std::to_string(axis));
+    {
+        const size_t &length = Layout::length(height(), width());
+        const size_t &other = Layout::length(m.height(), m.width());
+
+        for (size_t i = 0; i < Layout::lines(res.height(), res.width()); i++)
+        {
+            std::copy(matrix.cbegin() + i * m_stride, matrix.cbegin() + i * m_stride + length, out + i * res.m_stride);
+            std::copy(m.matrix.cbegin() + i * m.m_stride, m.matrix.cbegin() + i * m.m_stride + other, out + i * res.m_stride + length);
+        }
+    }
+
+    *this = std::move(res);
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::transpose_inplace()
+{
+    if (not is_square())
+        throw std::invalid_argument("The matrix must be square. Expected: " +
+                                    std::to_string(width()) +
+                                    ". Actual: " +
+                                    std::to_string(height()));
+
+    __transpose_inplace(std::is_same<T, cbool>());
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::__transpose_inplace(std::true_type)
+{
+    // The bits are written with atomic operations, so the threads can share the words
+    cmatrix_transpose::transpose_square(matrix.begin(), m_stride, height());
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::__transpose_inplace(std::false_type)
+{
+    // Take the buffer once, so a shared buffer is copied before the threads write in it
+    cmatrix_transpose::transpose_square(matrix.data(), m_stride, height());
 }
 
 #endif // CMATRIX_MANIPULATION_TPP
@@ -12,8 +12,8 @@
 // ==================================================
 // COMPARISON FUNCTIONS
 
-template <class T>
-bool cmatrix<T>::near(const cmatrix<T> &m, const T &tolerance) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::near(const cmatrix<T, Layout> &m, const T &tolerance) const
 {
     // Check if the dimensions are the same
     if (width() != m.width() or height() != m.height())
@@ -22,34 +22,34 @@ bool cmatrix<T>::near(const cmatrix<T> &m, const T &tolerance) const
     // For each cell, check if the values are the same
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            if (not std::isgreaterequal(cell(i, j), m.cell(i, j) - tolerance) or
-                not std::islessequal(cell(i, j), m.cell(i, j) + tolerance))
+            if (not std::isgreaterequal(__at(i, j), m.__at(i, j) - tolerance) or
+                not std::islessequal(__at(i, j), m.__at(i, j) + tolerance))
                 return false;
 
     return true;
 }
 
-template <class T>
-bool cmatrix<T>::near(const T &n, const T &tolerance) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::near(const T &n, const T &tolerance) const
 {
     // For each cell, check if the values are the same
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            if (not std::isgreaterequal(cell(i, j), n - tolerance) or
-                not std::islessequal(cell(i, j), n + tolerance))
+            if (not std::isgreaterequal(__at(i, j), n - tolerance) or
+                not std::islessequal(__at(i, j), n + tolerance))
                 return false;
 
     return true;
 }
 
-template <class T>
-bool cmatrix<T>::nearq(const cmatrix<T> &m, const T &tolerance) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::nearq(const cmatrix<T, Layout> &m, const T &tolerance) const
 {
     return not near(m, tolerance);
 }
 
-template <class T>
-bool cmatrix<T>::nearq(const T &n, const T &tolerance) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::nearq(const T &n, const T &tolerance) const
 {
     return not near(n, tolerance);
 }
@@ -57,42 +57,51 @@ bool cmatrix<T>::nearq(const T &n, const T &tolerance) const
 // ==================================================
 // MATHEMATICAL OPERATIONS
 
-template <class T>
-cmatrix<T> cmatrix<T>::matmul(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::matmul(const cmatrix<T, Layout> &m) const
 {
-    // Check if the number of columns of the first matrix
-    // is equal to the number of rows of the second matrix
-    if (width() != m.height())
-        throw std::invalid_argument("The number of columns of the first matrix must be equal to the number of rows of the second matrix. Expected: " +
-                                    std::to_string(width()) +
-                                    ". Actual: " +
-                                    std::to_string(m.height()));
+    return matmul(m.view());
+}
 
-    // Create a new matrix with the same number of rows of the first matrix
-    // and the same number of columns of the second matrix
-    cmatrix<T> result(height(), m.width());
+template <class T, class Layout>
+template <class M>
+cmatrix<T, Layout> cmatrix<T, Layout>::matmul(const cmatrix<T, M> &m) const
+{
+    // The view of a matrix of the other layout swaps the strides, so a transpose is not copied
+    return matmul(m.view());
+}
 
-    // For each cell of the new matrix, calculate the sum of the products
-    #pragma omp parallel for collapse(2)
-    for (size_t i = 0; i < height(); i++)
-        for (size_t j = 0; j < m.width(); j++)
-        {
-            T sum{};
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::matmul(const cmatrix_view<T> &m) const
+{
+    // The product is written in the layout of the matrix
+    cmatrix<T, Layout> result(height(), m.width());
+    view().matmul_into(result, m);
 
-            // For each cell of the first matrix, multiply the value of the cell
-            // with the value of the corresponding cell of the second matrix
-            #pragma omp parallel for reduction(+ : sum)
-            for (size_t k = 0; k < width(); k++)
-                sum += cell(i, k) * m.cell(k, j);
+    return result;
+}
 
-            result.set_cell(i, j, sum);
-        }
+template <class T, class Layout>
+void cmatrix<T, Layout>::matmul_into(cmatrix<T, Layout> &out, const cmatrix<T, Layout> &m) const
+{
+    view().matmul_into(out, m.view());
+}
 
-    return result;
+template <class T, class Layout>
+template <class M>
+void cmatrix<T, Layout>::matmul_into(cmatrix<T, Layout> &out, const cmatrix<T, M> &m) const
+{
+    view().matmul_into(out, m.view());
+}
+
+template <class T, class Layout>
+void cmatrix<T, Layout>::matmul_into(cmatrix<T, Layout> &out, const cmatrix_view<T> &m) const
+{
+    view().matmul_into(out, m);
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::matpow(const unsigned int &n) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::matpow(const unsigned int &n) const
 {
     // Check if the matrix is square
     if (not is_square())
@@ -101,64 +110,94 @@ cmatrix<T> cmatrix<T>::matpow(const unsigned int &n) const
                                     ". Actual: " +
                                     std::to_string(height()));
 
-    // If the exponent is 0, return the identity matrix
+    // If the exponent is 0, return the identity matrix of the type
     if (n == 0)
-        return cmatrix<T>::identity(width());
+    {
+        cmatrix<T, Layout> m(height(), width(), T());
+
+        for (size_t i = 0; i < height(); i++)
+            m.__at(i, i) = T(1);
+
+        return m;
+    }
 
     // If the exponent is 1, return a copy of itself
     if (n == 1)
         return copy();
 
-    // If the exponent is even, return the square of the matrix to the power of n / 2
-    // Ex: A^2 = (A * A)^1
-    if (n % 2 == 0)
-        return matmul(*this) ^ (n / 2);
+    // Exponentiation by squaring: base = A^(2^k), and result gathers the powers of the bits of n.
+    // The products are written in a third buffer, then swapped: the loop doesn't allocate.
+    // The cells of the base are copied, so it doesn't share its buffer with the matrix.
+    cmatrix<T, Layout> base(height(), width()), result(height(), width()), tmp(height(), width());
+    std::copy(matrix.cbegin(), matrix.cend(), base.matrix.begin());
+    bool first = true;
+
+    for (unsigned int e = n;; e >>= 1)
+    {
+        // The lowest power only initializes the result: A^(2^k) * I = A^(2^k)
+        if (e & 1)
+        {
+            if (first)
+                std::copy(base.matrix.cbegin(), base.matrix.cend(), result.matrix.begin());
+            else
+            {
+                result.matmul_into(tmp, base);
+                std::swap(result, tmp);
+            }
+
+            first = false;
+        }
+
+        if (e == 1)
+            break;
+
+        base.matmul_into(tmp, base);
+        std::swap(base, tmp);
+    }
 
-    // If the exponent is odd, return the square of the matrix to the power of (n - 1) / 2
-    // Ex: A^3 = (A * A)^1 * A
-    return matmul(matmul(*this) ^ ((n - 1) / 2));
+    return result;
 }
 
 // ==================================================
 // MATHEMATICAL FUNCTIONS
 
-template <class T>
-cmatrix<T> cmatrix<T>::log() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::log() const
 {
     return map([](const T &n)
                { return std::log(n); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::log2() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::log2() const
 {
     return map([](const T &n)
                { return std::log2(n); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::log10() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::log10() const
 {
     return map([](const T &n)
                { return std::log10(n); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::exp() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::exp() const
 {
     return map([](const T &n)
                { return std::exp(n); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::sqrt() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::sqrt() const
 {
     return map([](const T &n)
                { return std::sqrt(n); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::abs() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::abs() const
 {
     return map([](const T &n)
                { return std::abs(n); });
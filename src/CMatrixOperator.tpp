@@ -12,30 +12,72 @@
 // ==================================================
 // ASSIGMENT OPERATOR
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator=(const cmatrix<T> &m)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator=(const cmatrix<T, Layout> &m)
 {
     // Check if the matrix is the same
     // Prevents self-assignment
     if (this != &m)
+    {
         matrix = m.matrix;
+        m_height = m.m_height;
+        m_width = m.m_width;
+        m_stride = m.m_stride;
+    }
+
+    return *this;
+}
+
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator=(cmatrix<T, Layout> &&m)
+{
+    // Take the buffer of the matrix, and leave it empty
+    if (this != &m)
+    {
+        matrix = std::move(m.matrix);
+        m_height = m.m_height;
+        m_width = m.m_width;
+        m_stride = m.m_stride;
+        m.clear();
+    }
+
+    return *this;
+}
+
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator=(const cmatrix_expr::expr<E, T> &e)
+{
+    // The expression can reference the matrix, so the buffer is kept
+    // unless the dimensions change, or a view reads the cells before they are computed
+    if (e.self().height() == height() and e.self().width() == width() and not __overlaps(e.self()))
+        __assign_expr(e.self());
+
+    else
+        *this = cmatrix<T, Layout>(e);
 
     return *this;
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator=(const std::initializer_list<std::initializer_list<T>> &m)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator=(const std::initializer_list<std::initializer_list<T>> &m)
 {
-    cmatrix<T> tmp(m);
-    *this = tmp;
+    *this = cmatrix<T, Layout>(m);
     return *this;
 }
 
 // ==================================================
 // COMPARISON OPERATORS
 
-template <class T>
-bool cmatrix<T>::operator==(const cmatrix<T> &m) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::operator==(const cmatrix<T, Layout> &m) const
+{
+    return this->template operator==<Layout>(m);
+}
+
+template <class T, class Layout>
+template <class M>
+bool cmatrix<T, Layout>::operator==(const cmatrix<T, M> &m) const
 {
     // Check if the dimensions are the same
     if (width() != m.width() or height() != m.height())
@@ -44,214 +86,190 @@ bool cmatrix<T>::operator==(const cmatrix<T> &m) const
     // For each cell, check if the values are the same
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            if (cell(i, j) != m.cell(i, j))
+            if (__at(i, j) != m.__at(i, j))
                 return false;
 
     return true;
 }
 
-template <class T>
-bool cmatrix<T>::operator!=(const cmatrix<T> &m) const
+template <class T, class Layout>
+bool cmatrix<T, Layout>::operator!=(const cmatrix<T, Layout> &m) const
+{
+    return not(*this == m);
+}
+
+template <class T, class Layout>
+template <class M>
+bool cmatrix<T, Layout>::operator!=(const cmatrix<T, M> &m) const
 {
     return not(*this == m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator==(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator==(const T &n) const
 {
     return eq(n);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator!=(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator!=(const T &n) const
 {
     return neq(n);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator<(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator<(const cmatrix<T, Layout> &m) const
 {
     return lt(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator<(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator<(const T &n) const
 {
     return lt(n);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator<=(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator<=(const cmatrix<T, Layout> &m) const
 {
     return leq(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator<=(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator<=(const T &n) const
 {
     return leq(n);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator>(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator>(const cmatrix<T, Layout> &m) const
 {
     return gt(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator>(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator>(const T &n) const
 {
     return gt(n);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator>=(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator>=(const cmatrix<T, Layout> &m) const
 {
     return geq(m);
 }
 
-template <class T>
-cmatrix<cbool> cmatrix<T>::operator>=(const T &n) const
+template <class T, class Layout>
+cmatrix<cbool> cmatrix<T, Layout>::operator>=(const T &n) const
 {
     return geq(n);
 }
 
 // ==================================================
 // ARITHMETIC OPERATORS
+// The operators +, -, * and / return the nodes of CMatrixExpr.hpp
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator+(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::operator^(const unsigned int &n) const
 {
-    return __map_op_arithmetic(std::plus<T>(), m);
-}
-
-template <class T>
-cmatrix<T> cmatrix<T>::operator+(const T &n) const
-{
-    return __map_op_arithmetic(std::plus<T>(), n);
-}
-
-template <class T>
-cmatrix<T> operator+(const T &n, const cmatrix<T> &m)
-{
-    return m + n;
-}
-
-template <class T>
-cmatrix<T> cmatrix<T>::operator-(const cmatrix<T> &m) const
-{
-    return __map_op_arithmetic(std::minus<T>(), m);
-}
-
-template <class T>
-cmatrix<T> cmatrix<T>::operator-(const T &n) const
-{
-    return __map_op_arithmetic(std::minus<T>(), n);
-}
-
-template <class T>
-cmatrix<T> operator-(const T &n, const cmatrix<T> &m)
-{
-    return (-1) * m + n;
+    return __map_op_arithmetic([&](const T &a, const unsigned int &b)
+                               { return std::pow(a, b); },
+                               n);
 }
 
-template <class T>
-cmatrix<T> operator-(const cmatrix<T> &m)
-{
-    return m * (-1);
-}
+// ==================================================
+// ARITHMETIC ASSIGNMENT OPERATORS
+// The result is evaluated in place, in the buffer of the matrix
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator*(const cmatrix<T> &m) const
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator+=(const cmatrix<T, Layout> &m)
 {
-    return __map_op_arithmetic(std::multiplies<T>(), m);
+    return __assign_update(*this + m);
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator*(const T &n) const
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator+=(const T &n)
 {
-    return __map_op_arithmetic(std::multiplies<T>(), n);
+    return __assign_update(*this + n);
 }
 
-template <class T>
-cmatrix<T> operator*(const T &n, const cmatrix<T> &m)
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator+=(const cmatrix_expr::expr<E, T> &e)
 {
-    return m * n;
+    return __assign_update(*this + e.self());
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator/(const T &n) const
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator-=(const cmatrix<T, Layout> &m)
 {
-    if (n == 0)
-        throw std::invalid_argument("The value must be different from 0.");
-
-    return __map_op_arithmetic(std::divides<T>(), n);
+    return __assign_update(*this - m);
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator^(const unsigned int &n) const
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator-=(const T &n)
 {
-    return __map_op_arithmetic([&](const T &a, const unsigned int &b)
-                               { return std::pow(a, b); },
-                               n);
+    return __assign_update(*this - n);
 }
 
-// ==================================================
-// ARITHMETIC ASSIGNMENT OPERATORS
-
-template <class T>
-cmatrix<T> &cmatrix<T>::operator+=(const cmatrix<T> &m)
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator-=(const cmatrix_expr::expr<E, T> &e)
 {
-    return *this = *this + m;
+    return __assign_update(*this - e.self());
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator+=(const T &n)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator*=(const cmatrix<T, Layout> &m)
 {
-    return *this = *this + n;
+    return __assign_update(*this * m);
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator-=(const cmatrix<T> &m)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator*=(const T &n)
 {
-    return *this = *this - m;
+    return __assign_update(*this * n);
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator-=(const T &n)
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator*=(const cmatrix_expr::expr<E, T> &e)
 {
-    return *this = *this - n;
+    return __assign_update(*this * e.self());
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator*=(const cmatrix<T> &m)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator/=(const T &n)
 {
-    return *this = *this * m;
+    return __assign_update(*this / n);
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator*=(const T &n)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator/=(const cmatrix<T, Layout> &m)
 {
-    return *this = *this * n;
+    return __assign_update(*this / m);
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator/=(const T &n)
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator/=(const cmatrix_expr::expr<E, T> &e)
 {
-    return *this = *this / n;
+    return __assign_update(*this / e.self());
 }
 
-template <class T>
-cmatrix<T> &cmatrix<T>::operator^=(const unsigned int &n)
+template <class T, class Layout>
+cmatrix<T, Layout> &cmatrix<T, Layout>::operator^=(const unsigned int &n)
 {
-    return *this = *this ^ n;
+    apply([&](const T &a)
+          { return T(std::pow(a, n)); });
+    return *this;
 }
 
 // ==================================================
 // OTHER OPERATORS
 
-template <class T>
-std::ostream &operator<<(std::ostream &out, const cmatrix<T> &m)
+template <class T, class Layout>
+std::ostream &operator<<(std::ostream &out, const cmatrix<T, Layout> &m)
 {
     out << "[";
 
@@ -261,7 +279,7 @@ std::ostream &operator<<(std::ostream &out, const cmatrix<T> &m)
 
         for (size_t j = 0; j < m.width(); j++)
         {
-            out << m.cell(i, j);
+            out << m.__at(i, j);
 
             if (j != m.width() - 1)
                 out << ", ";
@@ -278,8 +296,8 @@ std::ostream &operator<<(std::ostream &out, const cmatrix<T> &m)
     return out;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::operator!() const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::operator!() const
 {
     return not_();
 }
@@ -287,34 +305,215 @@ cmatrix<T> cmatrix<T>::operator!() const
 // ==================================================
 // PRIVATE METHODS
 
-template <class T>
-cmatrix<T> cmatrix<T>::__map_op_arithmetic(const std::function<T(T, T)> &f, const cmatrix<T> &m) const
+template <class T, class Layout>
+template <class E>
+void cmatrix<T, Layout>::__assign_expr(const E &e)
 {
-    __check_size(m);
+    const bool rows = cmatrix_layout::is_row_major<Layout>::value;
+    const size_t cells = height() * width();
+    const size_t &length = Layout::length(height(), width());
+    T *data = matrix.data();
 
-    // Initialize a matrix with the same dimensions of the current matrix
-    cmatrix<T> result = copy();
+    // Compute each cell of the line from the cells of the operands, without temporary matrix
+    // The lines are the rows, or the columns with the column-major layout
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, cells, Layout::lines(height(), width()), [&](size_t i)
+                           {
+        T *line = data + i * m_stride;
 
-    // Apply the operator to each cell of the matrix
-    #pragma omp parallel for collapse(2)
-    for (size_t r = 0; r < height(); r++)
-        for (size_t c = 0; c < width(); c++)
-            result.set_cell(r, c, f(cell(r, c), m.cell(r, c)));
+        for (size_t k = 0; k < length; k++)
+            line[k] = rows ? e(i, k) : e(k, i); });
+}
 
-    return result;
+template <class T, class Layout>
+template <cmatrix_simd::op O>
+void cmatrix<T, Layout>::__assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::leaf<T>> &e)
+{
+    const size_t &stride = Layout::row_step(m_stride), &step = Layout::col_step(m_stride);
+
+    if (not e.lhs().contiguous(stride, step) or not e.rhs().contiguous(stride, step))
+        return __assign_broadcast(e);
+
+    // The buffers have the same layout: process them as a single line
+    // The padding of the lines is processed too, so the kernel doesn't stop at the end of each line
+    const T *a = e.lhs().m_data;
+    const T *b = e.rhs().m_data;
+    T *out = matrix.data();
+    const size_t n = Layout::lines(height(), width()) * m_stride;
+    const size_t chunks = (n + cmatrix_simd::CHUNK - 1) / cmatrix_simd::CHUNK;
+
+    // Apply the operator to each chunk of cells with the kernel of the processor
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, n, chunks, [&](size_t i)
+                           {
+        const size_t begin = i * cmatrix_simd::CHUNK;
+        cmatrix_simd::binary<O>(a + begin, b + begin, out + begin, std::min(cmatrix_simd::CHUNK, n - begin)); });
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::__map_op_arithmetic(const std::function<T(T, T)> &f, const T &val) const
+template <class T, class Layout>
+template <cmatrix_simd::op O>
+void cmatrix<T, Layout>::__assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::scalar<T>> &e)
 {
-    cmatrix<T> result = copy();
+    if (not e.lhs().contiguous(Layout::row_step(m_stride), Layout::col_step(m_stride)))
+        return __assign_expr<cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::scalar<T>>>(e);
 
-    #pragma omp parallel for collapse(2)
-    for (size_t i = 0; i < height(); i++)
+    const T *a = e.lhs().m_data;
+    const T &val = e.rhs().m_value;
+    T *out = matrix.data();
+    const size_t n = Layout::lines(height(), width()) * m_stride;
+    const size_t chunks = (n + cmatrix_simd::CHUNK - 1) / cmatrix_simd::CHUNK;
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, n, chunks, [&](size_t i)
+                           {
+        const size_t begin = i * cmatrix_simd::CHUNK;
+        cmatrix_simd::scalar<O>(a + begin, val, out + begin, std::min(cmatrix_simd::CHUNK, n - begin)); });
+}
+
+template <class T, class Layout>
+template <cmatrix_simd::op O>
+void cmatrix<T, Layout>::__assign_broadcast(const cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::leaf<T>> &e)
+{
+    const bool rows = cmatrix_layout::is_row_major<Layout>::value;
+    const cmatrix_expr::leaf<T> &a = e.lhs();
+    const cmatrix_expr::leaf<T> &b = e.rhs();
+    const size_t &length = Layout::length(height(), width());
+    T *out = matrix.data();
+
+    // The distances between two lines of the result, and between two cells of a line, in the operands
+    const size_t a_line = rows ? a.m_stride : a.m_step, a_cell = rows ? a.m_step : a.m_stride;
+    const size_t b_line = rows ? b.m_stride : b.m_step, b_cell = rows ? b.m_step : b.m_stride;
+
+    // A broadcast cell is a single value for each line, only usable by the kernel as the right operand
+    // The operands stored in another layout are read cell by cell
+    if (a_cell > 1 or b_cell > 1 or (a_cell == 0 and b_cell == 1))
+        return __assign_expr<cmatrix_expr::binary<O, cmatrix_expr::leaf<T>, cmatrix_expr::leaf<T>>>(e);
+
+    // Each line is computed by the kernel of the processor, the broadcast line being read in place for each one
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, height() * width(), Layout::lines(height(), width()), [&](size_t i)
+                           {
+        const T *a_line_data = a.m_data + i * a_line;
+        const T *b_line_data = b.m_data + i * b_line;
+        T *out_line = out + i * m_stride;
+
+        if (b_cell == 0)
+            cmatrix_simd::scalar<O>(a_line_data, *b_line_data, out_line, length);
+
+        else
+            cmatrix_simd::binary<O>(a_line_data, b_line_data, out_line, length); });
+}
+
+template <class T, class Layout>
+template <class E>
+cmatrix<T, Layout> &cmatrix<T, Layout>::__assign_update(const E &e)
+{
+    cmatrix_expr::check_size(height(), width(), e.height(), e.width());
+
+    // A broadcast view of the matrix would be read after its row or column is updated
+    if (__overlaps(e))
+        *this = cmatrix<T, Layout>(e);
+
+    else
+        __assign_expr(e);
+
+    return *this;
+}
+
+template <class T, class Layout>
+template <class E>
+bool cmatrix<T, Layout>::__overlaps(const E &e) const
+{
+    // The const buffer is not copied if it is shared
+    const T *begin = matrix.data();
+    return e.overlaps(begin, begin + matrix.size());
+}
+
+template <class T, class Layout>
+template <class F>
+cmatrix<T, Layout> cmatrix<T, Layout>::__map_op_arithmetic(const F &f, const T &val) const
+{
+    cmatrix<T, Layout> result(height(), width());
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, height() * width(), height(), [&](size_t i)
+                           {
         for (size_t j = 0; j < width(); j++)
-            result.set_cell(i, j, f(cell(i, j), val));
+            result.__at(i, j) = f(__at(i, j), val); });
 
     return result;
 }
 
+// ==================================================
+// BOOLEAN MATRICES
+
+inline cmatrix_expr::leaf<cbool>::leaf(const cmatrix<cbool> &m)
+    : m_words(m.matrix.words()), m_height(m.m_height), m_width(m.m_width), m_stride(m.m_stride), m_step(1) {}
+
+template <>
+template <class E>
+inline void cmatrix<cbool>::__assign_expr(const E &e)
+{
+    std::uint64_t *out = matrix.words();
+    const size_t cells = height() * width();
+
+    // Each thread builds whole words, so two threads never write the same word
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, cells, matrix.nwords(), [&](size_t w)
+                           {
+        std::uint64_t word = 0;
+        size_t r = w * cmatrix_bits::WORD / width();
+        size_t c = w * cmatrix_bits::WORD % width();
+
+        for (size_t b = 0; b < cmatrix_bits::WORD and w * cmatrix_bits::WORD + b < cells; b++)
+        {
+            word |= std::uint64_t(bool(e(r, c))) << b;
+
+            if (++c == width())
+            {
+                c = 0;
+                r++;
+            }
+        }
+
+        out[w] = word; });
+}
+
+// The boolean matrices have no view: their operands are matrices
+template <>
+template <class E>
+inline bool cmatrix<cbool>::__overlaps(const E &) const
+{
+    return false;
+}
+
+template <>
+template <cmatrix_simd::op O>
+inline void cmatrix<cbool>::__assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<cbool>, cmatrix_expr::leaf<cbool>> &e)
+{
+    // The words of a broadcast operand don't match the words of the result: build them cell by cell
+    if (not e.lhs().contiguous(m_stride, 1) or not e.rhs().contiguous(m_stride, 1))
+        return __assign_expr<cmatrix_expr::binary<O, cmatrix_expr::leaf<cbool>, cmatrix_expr::leaf<cbool>>>(e);
+
+    const std::uint64_t *a = e.lhs().m_words;
+    const std::uint64_t *b = e.rhs().m_words;
+    std::uint64_t *out = matrix.words();
+
+    // The operators of cbool are logical operators: apply them to 64 cells at once
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, matrix.nwords(), matrix.nwords(), [&](size_t w)
+                           { out[w] = cmatrix_bits::word_op<O>::apply(a[w], b[w]); });
+}
+
+template <>
+template <cmatrix_simd::op O>
+inline void cmatrix<cbool>::__assign_expr(const cmatrix_expr::binary<O, cmatrix_expr::leaf<cbool>, cmatrix_expr::scalar<cbool>> &e)
+{
+    if (not e.lhs().contiguous(m_stride, 1))
+        return __assign_expr<cmatrix_expr::binary<O, cmatrix_expr::leaf<cbool>, cmatrix_expr::scalar<cbool>>>(e);
+
+    const std::uint64_t *a = e.lhs().m_words;
+    const std::uint64_t b = e.rhs().m_value ? ~std::uint64_t(0) : 0;
+    std::uint64_t *out = matrix.words();
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, matrix.nwords(), matrix.nwords(), [&](size_t w)
+                           { out[w] = cmatrix_bits::word_op<O>::apply(a[w], b); });
+
+    // The value is broadcast to the unused bits of the last word
+    matrix.clear_tail();
+}
+
 #endif // CMATRIX_OPERATOR_TPP
@@ -12,41 +12,53 @@
 // ==================================================
 // SET FUNCTIONS
 
-template <class T>
-void cmatrix<T>::set_row(const size_t &n, const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::set_row(const size_t &n, const std::vector<T> &val)
 {
     __check_valid_row_id(n);
     __check_valid_row(val);
-    matrix[n] = val;
+
+    // The cells of a row are contiguous in the row-major layout
+    if (cmatrix_layout::is_row_major<Layout>::value)
+        std::copy(val.begin(), val.end(), matrix.begin() + __index(n, 0));
+
+    else
+        for (size_t i = 0; i < width(); i++)
+            __at(n, i) = val[i];
 }
 
-template <class T>
-void cmatrix<T>::set_column(const size_t &n, const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::set_column(const size_t &n, const std::vector<T> &val)
 {
     __check_valid_col_id(n);
     __check_valid_col(val);
 
-    // For each row, set the value at the given position
-    for (size_t i = 0; i < height(); i++)
-        matrix[i][n] = val[i];
+    // The cells of a column are contiguous in the column-major layout
+    if (not cmatrix_layout::is_row_major<Layout>::value)
+        std::copy(val.begin(), val.end(), matrix.begin() + __index(0, n));
+
+    // Otherwise, for each row, set the value at the given position
+    else
+        for (size_t i = 0; i < height(); i++)
+            __at(i, n) = val[i];
 }
 
-template <class T>
-void cmatrix<T>::set_cell(const size_t &row, const size_t &col, const T &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::set_cell(const size_t &row, const size_t &col, const T &val)
 {
     __check_valid_row_id(row);
     __check_valid_col_id(col);
-    matrix[row][col] = val;
+    matrix[__index(row, col)] = val;
 }
 
-template <class T>
-void cmatrix<T>::set_diag(const std::vector<T> &val)
+template <class T, class Layout>
+void cmatrix<T, Layout>::set_diag(const std::vector<T> &val)
 {
     __check_valid_diag(val);
 
     // Iterate over the diagonal
     for (size_t i = 0; i < std::min(width(), height()); i++)
-        set_cell(i, i, val[i]);
+        __at(i, i) = val[i];
 }
 
 #endif // CMATRIX_SETTER_TPP
@@ -0,0 +1,448 @@
+/**
+ * @file CMatrixSparse.tpp
+ * @brief This file contains the implementation of the csr_matrix class.
+ *
+ * @see csr_matrix
+ */
+
+#ifndef CMATRIX_SPARSE_TPP
+#define CMATRIX_SPARSE_TPP
+
+// ==================================================
+// CONSTRUCTORS
+
+template <class T>
+csr_matrix<T>::csr_matrix(const size_t &height, const size_t &width)
+    : m_height(height), m_width(height == 0 ? 0 : width), m_row_ptr(height + 1, 0) {}
+
+template <class T>
+csr_matrix<T>::csr_matrix(const cmatrix<T> &m)
+    : m_height(m.height()), m_width(m.width()), m_row_ptr(m.height() + 1, 0)
+{
+    const T zero = T();
+
+    // Keep the nonzero cells, row by row
+    for (size_t r = 0; r < height(); r++)
+    {
+        for (size_t c = 0; c < width(); c++)
+            if (m.__at(r, c) != zero)
+            {
+                m_col_ids.push_back(c);
+                m_values.push_back(m.__at(r, c));
+            }
+
+        m_row_ptr[r + 1] = m_values.size();
+    }
+}
+
+template <class T>
+csr_matrix<T> csr_matrix<T>::from_coo(const size_t &height, const size_t &width,
+                                      const std::vector<size_t> &rows,
+                                      const std::vector<size_t> &cols,
+                                      const std::vector<T> &values)
+{
+    if (rows.size() != cols.size() or rows.size() != values.size())
+        throw std::invalid_argument("The rows, the columns and the values must have the same size. Actual: " +
+                                    std::to_string(rows.size()) +
+                                    ", " +
+                                    std::to_string(cols.size()) +
+                                    " and " +
+                                    std::to_string(values.size()));
+
+    csr_matrix<T> m(height, width);
+
+    for (size_t i = 0; i < rows.size(); i++)
+    {
+        m.__check_valid_row_id(rows[i]);
+        m.__check_valid_col_id(cols[i]);
+    }
+
+    // Count the cells of each row, and deduce the position of the first cell of each row
+    std::vector<size_t> row_ptr(height + 1, 0);
+
+    for (size_t i = 0; i < rows.size(); i++)
+        row_ptr[rows[i] + 1]++;
+
+    for (size_t r = 0; r < height; r++)
+        row_ptr[r + 1] += row_ptr[r];
+
+    // Place each cell in its row
+    std::vector<std::pair<size_t, T>> cells(rows.size());
+    std::vector<size_t> next(row_ptr.begin(), row_ptr.end() - 1);
+
+    for (size_t i = 0; i < rows.size(); i++)
+        cells[next[rows[i]]++] = std::pair<size_t, T>(cols[i], values[i]);
+
+    // Sort the cells of each row by column, and sum the cells with the same column
+    m.m_col_ids.reserve(cells.size());
+    m.m_values.reserve(cells.size());
+
+    for (size_t r = 0; r < height; r++)
+    {
+        std::stable_sort(cells.begin() + row_ptr[r], cells.begin() + row_ptr[r + 1],
+                         [](const std::pair<size_t, T> &a, const std::pair<size_t, T> &b)
+                         { return a.first < b.first; });
+
+        for (size_t i = row_ptr[r]; i < row_ptr[r + 1]; i++)
+        {
+            if (m.m_values.size() > m.m_row_ptr[r] and m.m_col_ids.back() == cells[i].first)
+                m.m_values.back() += cells[i].second;
+
+            else
+            {
+                m.m_col_ids.push_back(cells[i].first);
+                m.m_values.push_back(cells[i].second);
+            }
+        }
+
+        m.m_row_ptr[r + 1] = m.m_values.size();
+    }
+
+    return m;
+}
+
+// ==================================================
+// GETTERS
+
+template <class T>
+size_t csr_matrix<T>::height() const
+{
+    return m_height;
+}
+
+template <class T>
+size_t csr_matrix<T>::width() const
+{
+    return m_width;
+}
+
+template <class T>
+std::pair<size_t, size_t> csr_matrix<T>::size() const
+{
+    return std::pair<size_t, size_t>(height(), width());
+}
+
+template <class T>
+size_t csr_matrix<T>::nnz() const
+{
+    return m_values.size();
+}
+
+template <class T>
+bool csr_matrix<T>::is_empty() const
+{
+    return height() == 0 or width() == 0;
+}
+
+template <class T>
+const std::vector<size_t> &csr_matrix<T>::row_ptr() const
+{
+    return m_row_ptr;
+}
+
+template <class T>
+const std::vector<size_t> &csr_matrix<T>::col_ids() const
+{
+    return m_col_ids;
+}
+
+template <class T>
+const std::vector<T> &csr_matrix<T>::values() const
+{
+    return m_values;
+}
+
+template <class T>
+T csr_matrix<T>::cell(const size_t &row, const size_t &col) const
+{
+    __check_valid_row_id(row);
+    __check_valid_col_id(col);
+
+    // The columns of a row are sorted
+    const std::vector<size_t>::const_iterator first = m_col_ids.begin() + m_row_ptr[row];
+    const std::vector<size_t>::const_iterator last = m_col_ids.begin() + m_row_ptr[row + 1];
+    const std::vector<size_t>::const_iterator it = std::lower_bound(first, last, col);
+
+    if (it != last and *it == col)
+        return m_values[it - m_col_ids.begin()];
+
+    return T();
+}
+
+// ==================================================
+// CONVERSION METHODS
+
+template <class T>
+cmatrix<T> csr_matrix<T>::to_cmatrix() const
+{
+    cmatrix<T> m(height(), width());
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, nnz(), height(), [&](size_t r)
+                           {
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+            m.__at(r, m_col_ids[i]) = m_values[i]; });
+
+    return m;
+}
+
+// ==================================================
+// MATH METHODS
+
+template <class T>
+std::vector<T> csr_matrix<T>::matvec(const std::vector<T> &x) const
+{
+    if (x.size() != width())
+        throw std::invalid_argument("The size of the vector must be equal to the number of columns of the matrix. Expected: " +
+                                    std::to_string(width()) +
+                                    ". Actual: " +
+                                    std::to_string(x.size()));
+
+    std::vector<T> y(height());
+
+    cmatrix_exec::for_each(cmatrix_parallel::PRODUCT, nnz(), height(), [&](size_t r)
+                           {
+        T sum = T();
+
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+            sum += m_values[i] * x[m_col_ids[i]];
+
+        y[r] = sum; });
+
+    return y;
+}
+
+template <class T>
+cmatrix<T> csr_matrix<T>::matmul(const cmatrix<T> &m) const
+{
+    // Check if the number of columns of the first matrix
+    // is equal to the number of rows of the second matrix
+    if (width() != m.height())
+        throw std::invalid_argument("The number of columns of the first matrix must be equal to the number of rows of the second matrix. Expected: " +
+                                    std::to_string(width()) +
+                                    ". Actual: " +
+                                    std::to_string(m.height()));
+
+    cmatrix<T> result(height(), m.width());
+
+    // Each row of the result is a combination of the rows of m selected by the stored cells
+    cmatrix_exec::for_each(cmatrix_parallel::PRODUCT, nnz() * m.width(), height(), [&](size_t r)
+                           {
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+        {
+            const T &val = m_values[i];
+            const size_t &k = m_col_ids[i];
+
+            for (size_t c = 0; c < m.width(); c++)
+                result.__at(r, c) += val * m.__at(k, c);
+        } });
+
+    return result;
+}
+
+template <class T>
+csr_matrix<T> csr_matrix<T>::transpose() const
+{
+    csr_matrix<T> m(width(), height());
+
+    // Count the cells of each column, which become the rows
+    for (size_t i = 0; i < nnz(); i++)
+        m.m_row_ptr[m_col_ids[i] + 1]++;
+
+    for (size_t c = 0; c < width(); c++)
+        m.m_row_ptr[c + 1] += m.m_row_ptr[c];
+
+    // Place the cells row by row, so the columns of each new row are sorted
+    std::vector<size_t> next(m.m_row_ptr.begin(), m.m_row_ptr.end() - 1);
+    m.m_col_ids.resize(nnz());
+    m.m_values.resize(nnz());
+
+    for (size_t r = 0; r < height(); r++)
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+        {
+            const size_t pos = next[m_col_ids[i]]++;
+            m.m_col_ids[pos] = r;
+            m.m_values[pos] = m_values[i];
+        }
+
+    return m;
+}
+
+// ==================================================
+// STATISTICS METHODS
+
+template <class T>
+cmatrix<T> csr_matrix<T>::sum(const unsigned int &axis, const T &zero) const
+{
+    // Compute the sum for each row
+    if (axis == 0)
+    {
+        cmatrix<T> m(height(), 1);
+
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, nnz(), height(), [&](size_t r)
+                               {
+            T sum = zero;
+
+            for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+                sum += m_values[i];
+
+            m.__at(r, 0) = sum; });
+
+        return m;
+    }
+
+    // Compute the sum for each column
+    else if (axis == 1)
+    {
+        cmatrix<T> m(1, width(), zero);
+
+        for (size_t i = 0; i < nnz(); i++)
+            m.__at(0, m_col_ids[i]) += m_values[i];
+
+        return m;
+    }
+
+    else
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+}
+
+template <class T>
+cmatrix<T> csr_matrix<T>::max(const unsigned int &axis) const
+{
+    // Compute the maximum for each row
+    if (axis == 0)
+    {
+        cmatrix<T> m(height(), 1);
+
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, nnz(), height(), [&](size_t r)
+                               {
+            const size_t first = m_row_ptr[r];
+            const size_t last = m_row_ptr[r + 1];
+
+            // A row with less stored cells than columns has a zero
+            T max = (last - first < width() or first == last) ? T() : m_values[first];
+
+            for (size_t i = first; i < last; i++)
+                if (m_values[i] > max)
+                    max = m_values[i];
+
+            m.__at(r, 0) = max; });
+
+        return m;
+    }
+
+    // Compute the maximum for each column
+    else if (axis == 1)
+    {
+        cmatrix<T> m(1, width());
+        std::vector<size_t> counts(width(), 0);
+
+        for (size_t i = 0; i < nnz(); i++)
+        {
+            const size_t &c = m_col_ids[i];
+
+            if (counts[c]++ == 0 or m_values[i] > m.__at(0, c))
+                m.__at(0, c) = m_values[i];
+        }
+
+        // A column with less stored cells than rows has a zero
+        for (size_t c = 0; c < width(); c++)
+            if (counts[c] < height() and (counts[c] == 0 or T() > m.__at(0, c)))
+                m.__at(0, c) = T();
+
+        return m;
+    }
+
+    else
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+}
+
+// ==================================================
+// OPERATORS
+
+template <class T>
+csr_matrix<T> csr_matrix<T>::operator*(const T &n) const
+{
+    csr_matrix<T> m = *this;
+    m *= n;
+    return m;
+}
+
+template <class T>
+csr_matrix<T> csr_matrix<T>::operator/(const T &n) const
+{
+    csr_matrix<T> m = *this;
+    m /= n;
+    return m;
+}
+
+template <class T>
+cmatrix<T> csr_matrix<T>::operator+(const T &n) const
+{
+    cmatrix<T> m(height(), width(), n);
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, nnz(), height(), [&](size_t r)
+                           {
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+            m.__at(r, m_col_ids[i]) = m_values[i] + n; });
+
+    return m;
+}
+
+template <class T>
+cmatrix<T> csr_matrix<T>::operator-(const T &n) const
+{
+    cmatrix<T> m(height(), width(), T() - n);
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, nnz(), height(), [&](size_t r)
+                           {
+        for (size_t i = m_row_ptr[r]; i < m_row_ptr[r + 1]; i++)
+            m.__at(r, m_col_ids[i]) = m_values[i] - n; });
+
+    return m;
+}
+
+template <class T>
+csr_matrix<T> &csr_matrix<T>::operator*=(const T &n)
+{
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, nnz(), nnz(), [&](size_t i)
+                           { m_values[i] *= n; });
+
+    return *this;
+}
+
+template <class T>
+csr_matrix<T> &csr_matrix<T>::operator/=(const T &n)
+{
+    if (n == 0)
+        throw std::invalid_argument("The value must be different from 0.");
+
+    cmatrix_exec::for_each(cmatrix_parallel::ELEMENTWISE, nnz(), nnz(), [&](size_t i)
+                           { m_values[i] /= n; });
+
+    return *this;
+}
+
+// ==================================================
+// CHECK METHODS
+
+template <class T>
+void csr_matrix<T>::__check_valid_row_id(const size_t &n) const
+{
+    if (n >= height())
+        throw std::out_of_range("Invalid row index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(height()));
+}
+
+template <class T>
+void csr_matrix<T>::__check_valid_col_id(const size_t &n) const
+{
+    if (n >= width())
+        throw std::out_of_range("Invalid column index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(width()));
+}
+
+#endif // CMATRIX_SPARSE_TPP
@@ -17,14 +17,14 @@ cmatrix<int> cmatrix<int>::randint(const size_t &height, const size_t &width, co
 {
     // Set the seed
     std::srand(seed);
-    std::vector<std::vector<int>> m(height, std::vector<int>(width));
+    cmatrix<int> m(height, width);
 
     // Generate a random number for each cell
-    for (size_t r = 0; r < height; r++)
-        for (size_t c = 0; c < width; c++)
-            m[r][c] = rand() % max + min;
+    for (size_t r = 0; r < m.height(); r++)
+        for (size_t c = 0; c < m.width(); c++)
+            m.__at(r, c) = rand() % max + min;
 
-    return cmatrix<int>(m);
+    return m;
 }
 
 template <> inline
@@ -32,14 +32,14 @@ cmatrix<float> cmatrix<float>::randfloat(const size_t &height, const size_t &wid
 {
     // Set the seed
     std::srand(seed);
-    std::vector<std::vector<float>> m(height, std::vector<float>(width));
+    cmatrix<float> m(height, width);
 
     // Generate a random number for each cell
-    for (size_t r = 0; r < height; r++)
-        for (size_t c = 0; c < width; c++)
-            m[r][c] = (float)rand() / RAND_MAX * (max - min) + min;
+    for (size_t r = 0; r < m.height(); r++)
+        for (size_t c = 0; c < m.width(); c++)
+            m.__at(r, c) = (float)rand() / RAND_MAX * (max - min) + min;
 
-    return cmatrix<float>(m);
+    return m;
 }
 
 template <> inline
@@ -59,8 +59,8 @@ cmatrix<int> cmatrix<int>::identity(const size_t &size)
 // ==================================================
 // OTHERS METHODS
 
-template <class T>
-bool cmatrix<T>::is_matrix(const std::vector<std::vector<T>> &m)
+template <class T, class Layout>
+bool cmatrix<T, Layout>::is_matrix(const std::vector<std::vector<T>> &m)
 {
     size_t rowSize = 0;
 
@@ -79,10 +79,10 @@ bool cmatrix<T>::is_matrix(const std::vector<std::vector<T>> &m)
     return true;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::merge(const cmatrix<T> &m1, const cmatrix<T> &m2, const unsigned int &axis)
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::merge(const cmatrix<T, Layout> &m1, const cmatrix<T, Layout> &m2, const unsigned int &axis)
 {
-    cmatrix<T> m = m1.copy();
+    cmatrix<T, Layout> m = m1.copy();
     m.concatenate(m2, axis);
     return m;
 }
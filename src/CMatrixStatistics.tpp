@@ -9,196 +9,120 @@
 #ifndef CMATRIX_STATISTICS_TPP
 #define CMATRIX_STATISTICS_TPP
 
-template <class T>
-cmatrix<T> cmatrix<T>::min(const unsigned int &axis) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::min(const unsigned int &axis) const
 {
-    // Compute the minimum for each row
-    if (axis == 0)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(height(), std::vector<T>(1));
-
-#pragma omp parallel for
-        for (size_t r = 0; r < height(); r++)
-        {
-            // Push the first element of the row to the result matrix
-            m[r][0] = cell(r, 0);
-
-            // Check if the current element is smaller than the stored one
-            for (size_t c = 0; c < width(); c++)
-                if (cell(r, c) < m[r][0])
-                    m[r][0] = cell(r, c);
-        }
-
-        return cmatrix<T>(m);
-    }
+    if (axis != 0 and axis != 1)
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 
-    // Compute the minimum for each column
-    else if (axis == 1)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(1, std::vector<T>(width()));
-
-#pragma omp parallel for
-        for (size_t i = 0; i < width(); i++)
-        {
-            // Push the first element of the column to the result matrix
-            m[0][i] = cell(0, i);
-
-            // Check if the current element is smaller than the stored one
-            for (size_t j = 0; j < height(); j++)
-                if (cell(j, i) < m[0][i])
-                    m[0][i] = cell(j, i);
-        }
-
-        return cmatrix<T>(m);
-    }
+    // Initialize the minimum of each row with its first cell, or of each column with its first cell
+    std::vector<T> acc = is_empty() ? std::vector<T>() : axis == 0 ? columns_vec(0) : rows_vec(0);
 
-    else
-        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+    // Check if the current element is smaller than the stored one
+    __fold(acc, axis, [](const T &min, const T &val, const size_t &)
+           { return val < min ? val : min; });
+
+    // The result is a column for the rows, a row for the columns
+    cmatrix<T, Layout> m = axis == 0 ? cmatrix<T, Layout>(height(), 1) : cmatrix<T, Layout>(1, width());
+
+    for (size_t i = 0; i < acc.size(); i++)
+        m.__at(axis == 0 ? i : 0, axis == 0 ? 0 : i) = acc[i];
+
+    return m;
 }
 
-template <class T>
-T cmatrix<T>::min_all() const
+template <class T, class Layout>
+T cmatrix<T, Layout>::min_all() const
 {
     // Precondition: the matrix must have at least one element
     if (is_empty())
         throw std::invalid_argument("The matrix must have at least one element.");
 
     // Initialize the minimum to the first element of the matrix
-    T min = cell(0, 0);
+    T min = __at(0, 0);
 
     // Check if the current element is smaller than the stored one
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            if (cell(i, j) < min)
-                min = cell(i, j);
+            if (__at(i, j) < min)
+                min = __at(i, j);
 
     return min;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::max(const unsigned int &axis) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::max(const unsigned int &axis) const
 {
-    // Compute the maximum for each row
-    if (axis == 0)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(height(), std::vector<T>(1));
-
-#pragma omp parallel for
-        for (size_t r = 0; r < height(); r++)
-        {
-            // Push the first element of the row to the result matrix
-            m[r][0] = cell(r, 0);
-
-            // Check if the current element is greater than the stored one
-            for (size_t c = 0; c < width(); c++)
-                if (cell(r, c) > m[r][0])
-                    m[r][0] = cell(r, c);
-        }
-
-        return cmatrix<T>(m);
-    }
+    if (axis != 0 and axis != 1)
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 
-    // Compute the maximum for each column
-    else if (axis == 1)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(1, std::vector<T>(width()));
-
-#pragma omp parallel for
-        for (size_t c = 0; c < width(); c++)
-        {
-            // Push the first element of the column to the result matrix
-            m[0][c] = cell(0, c);
-
-            // Check if the current element is greater than the stored one
-            for (size_t r = 0; r < height(); r++)
-                if (cell(r, c) > m[0][c])
-                    m[0][c] = cell(r, c);
-        }
-
-        return cmatrix<T>(m);
-    }
+    // Initialize the maximum of each row with its first cell, or of each column with its first cell
+    std::vector<T> acc = is_empty() ? std::vector<T>() : axis == 0 ? columns_vec(0) : rows_vec(0);
 
-    else
-        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+    // Check if the current element is greater than the stored one
+    __fold(acc, axis, [](const T &max, const T &val, const size_t &)
+           { return val > max ? val : max; });
+
+    // The result is a column for the rows, a row for the columns
+    cmatrix<T, Layout> m = axis == 0 ? cmatrix<T, Layout>(height(), 1) : cmatrix<T, Layout>(1, width());
+
+    for (size_t i = 0; i < acc.size(); i++)
+        m.__at(axis == 0 ? i : 0, axis == 0 ? 0 : i) = acc[i];
+
+    return m;
 }
 
-template <class T>
-T cmatrix<T>::max_all() const
+template <class T, class Layout>
+T cmatrix<T, Layout>::max_all() const
 {
     // Precondition: the matrix must have at least one element
     if (is_empty())
         throw std::invalid_argument("The matrix must have at least one element.");
 
     // Initialize the maximum to the first element of the matrix
-    T max = cell(0, 0);
+    T max = __at(0, 0);
 
     // Check if the current element is greather than the stored one
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            if (cell(i, j) > max)
-                max = cell(i, j);
+            if (__at(i, j) > max)
+                max = __at(i, j);
 
     return max;
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::sum(const unsigned int &axis, const T &zero) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::sum(const unsigned int &axis, const T &zero) const
 {
+    // Initialize the result matrix: a column for the rows, a row for the columns
+    cmatrix<T, Layout> m = axis == 0 ? cmatrix<T, Layout>(height(), 1) : cmatrix<T, Layout>(1, width());
+    sum_into(m, axis, zero);
 
-    // Compute the sum for each row
-    if (axis == 0)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(height(), std::vector<T>(1));
-
-#pragma omp parallel for
-        for (size_t i = 0; i < height(); i++)
-        {
-            // Initialize the sum to zero
-            T sum = zero;
-
-            // Sum all the elements of the row
-            for (size_t j = 0; j < width(); j++)
-                sum += cell(i, j);
-
-            m[i][0] = sum;
-        }
-
-        return cmatrix<T>(m);
-    }
-
-    // Compute the sum for each column
-    else if (axis == 1)
-    {
-        // Initialize the result matrix
-        std::vector<std::vector<T>> m(1, std::vector<T>(width()));
+    return m;
+}
 
-#pragma omp parallel for
-        for (size_t i = 0; i < width(); i++)
-        {
-            // Initialize the sum to zero
-            T sum = zero;
+template <class T, class Layout>
+void cmatrix<T, Layout>::sum_into(cmatrix<T, Layout> &out, const unsigned int &axis, const T &zero) const
+{
+    if (axis != 0 and axis != 1)
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 
-            // Sum all the elements of the column
-            for (size_t j = 0; j < height(); j++)
-                sum += cell(j, i);
+    // The sum of each row is written in a column, and the sum of each column in a row
+    __check_out(out, axis == 0 ? height() : 1, axis == 0 ? 1 : width());
 
-            m[0][i] = sum;
-        }
+    // Sum all the elements of each row or column, in the order of the buffer
+    std::vector<T> acc(axis == 0 ? height() : width(), zero);
+    __fold(acc, axis, [](const T &sum, const T &val, const size_t &)
+           { return sum + val; });
 
-        return cmatrix<T>(m);
-    }
+    typename storage_type::iterator dst = out.matrix.begin();
 
-    else
-        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+    for (size_t i = 0; i < acc.size(); i++)
+        dst[axis == 0 ? out.__index(i, 0) : out.__index(0, i)] = acc[i];
 }
 
-template <class T>
-T cmatrix<T>::sum_all(const T &zero) const
+template <class T, class Layout>
+T cmatrix<T, Layout>::sum_all(const T &zero) const
 {
     // Initialize the sum to zero
     T sum = zero;
@@ -206,166 +130,187 @@ T cmatrix<T>::sum_all(const T &zero) const
     // Sum all the elements of the matrix
     for (size_t i = 0; i < height(); i++)
         for (size_t j = 0; j < width(); j++)
-            sum += cell(i, j);
+            sum += __at(i, j);
 
     return sum;
 }
 
-template <typename T>
-cmatrix<float> cmatrix<T>::__mean(const unsigned int &axis, std::true_type) const
+template <> inline
+cbool cmatrix<cbool>::sum_all(const cbool &zero) const
 {
-    // Return an empty matrix if the matrix is empty
+    // cbool::operator+= adds the values, so the sum counts the true cells, like the loop over the cells
+    // The count is taken from the population count of the words, and wraps around like the char of the cbool
+    return cbool::from_value(static_cast<char>(zero.value() + matrix.count()));
+}
+
+template <typename T, class Layout>
+void cmatrix<T, Layout>::__mean_into(cmatrix<float, Layout> &out, const unsigned int &axis, std::true_type) const
+{
+    // The mean of an empty matrix is empty
     if (is_empty())
-        return cmatrix<float>();
+        return __check_out(out, 0, 0);
 
-    // Compute sum of the elements of each row
-    cmatrix<float> result(sum(axis));
+    if (axis != 0 and axis != 1)
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 
-    // Divide the sum by the dimension of the matrix along the specified axis
-    // (rows or columns) to get the mean
-    result /= axis == 0 ? width() : height();
+    // The dimension of the matrix along the specified axis (rows or columns)
+    const size_t &n = axis == 0 ? width() : height();
+    __check_out(out, axis == 0 ? height() : 1, axis == 0 ? 1 : width());
 
-    return result;
-}
+    // Sum the elements of the rows or columns, in the order of the buffer
+    std::vector<T> acc(axis == 0 ? height() : width(), T());
+    __fold(acc, axis, [](const T &sum, const T &val, const size_t &)
+           { return sum + val; });
 
-template <typename T>
-cmatrix<float> cmatrix<T>::__mean(const unsigned int &axis, std::false_type) const
-{
-    throw std::invalid_argument("The type of the matrix must be arithmetic.");
+    // Take the iterator once, so a shared buffer is copied before writing in it
+    typename cmatrix<float, Layout>::storage_type::iterator dst = out.matrix.begin();
+
+    // Divide each sum by the number of elements
+    for (size_t i = 0; i < acc.size(); i++)
+        dst[axis == 0 ? out.__index(i, 0) : out.__index(0, i)] = float(acc[i]) / n;
 }
 
-template <typename T>
-cmatrix<float> cmatrix<T>::mean(const unsigned int &axis) const
+template <typename T, class Layout>
+void cmatrix<T, Layout>::__mean_into(cmatrix<float, Layout> &out, const unsigned int &axis, std::false_type) const
 {
-    return __mean(axis, std::is_arithmetic<T>());
+    throw std::invalid_argument("The type of the matrix must be arithmetic.");
 }
 
-template <class T>
-cmatrix<float> cmatrix<T>::__std(const unsigned int &axis, std::true_type) const
+template <typename T, class Layout>
+cmatrix<float, Layout> cmatrix<T, Layout>::mean(const unsigned int &axis) const
 {
-    // Compute the standard deviation for each row
-    if (axis == 0)
-    {
-        // Cannot calculate the standard deviation of a single value
-        if (width() == 1)
-            throw std::invalid_argument("The matrix must have more than one column.");
-
-        // Initialize the result matrix
-        std::vector<std::vector<float>> m(height(), std::vector<float>(1));
-
-        // Calculate the mean of each row
-        const cmatrix<float> &matrix_mean = mean(0);
+    // Return an empty matrix if the matrix is empty
+    cmatrix<float, Layout> m;
 
-#pragma omp parallel for
-        for (size_t r = 0; r < height(); r++)
-        {
-            // Calculate the mean of the row
-            const float &mean = matrix_mean.cell(r, 0);
-            float sum = 0;
+    if (not is_empty())
+        m = axis == 0 ? cmatrix<float, Layout>(height(), 1) : cmatrix<float, Layout>(1, width());
 
-            // Calculate the sum of the squares of the differences between the values and the mean
-            for (size_t c = 0; c < width(); c++)
-                sum += std::pow(cell(r, c) - mean, 2);
+    mean_into(m, axis);
 
-            // Calculate the standard deviation and push it to the result matrix
-            m[r][0] = std::sqrt(sum / width());
-        }
+    return m;
+}
 
-        return cmatrix<float>(m);
-    }
+template <typename T, class Layout>
+void cmatrix<T, Layout>::mean_into(cmatrix<float, Layout> &out, const unsigned int &axis) const
+{
+    __mean_into(out, axis, std::is_arithmetic<T>());
+}
 
-    // Compute the standard deviation for each column
-    else if (axis == 1)
-    {
-        // Cannot calculate the standard deviation of a single value
-        if (height() == 1)
-            throw std::invalid_argument("The matrix must have more than one row.");
+template <class T, class Layout>
+cmatrix<float, Layout> cmatrix<T, Layout>::__std(const unsigned int &axis, std::true_type) const
+{
+    if (axis != 0 and axis != 1)
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 
-        // Initialize the result matrix
-        std::vector<std::vector<float>> m(1, std::vector<float>(width()));
+    // Cannot calculate the standard deviation of a single value
+    if (axis == 0 and width() == 1)
+        throw std::invalid_argument("The matrix must have more than one column.");
 
-        // Calculate the mean of each column
-        const cmatrix<float> &matrix_mean = this->mean(1);
+    if (axis == 1 and height() == 1)
+        throw std::invalid_argument("The matrix must have more than one row.");
 
-#pragma omp parallel for
-        for (size_t c = 0; c < width(); c++)
-        {
-            // Calculate the mean of the column
-            const float &mean = matrix_mean.cell(0, c);
-            float sum = 0;
+    // Calculate the mean of each row or column
+    const cmatrix<float, Layout> &matrix_mean = mean(axis);
+    const std::vector<float> &means = is_empty() ? std::vector<float>() : axis == 0 ? matrix_mean.columns_vec(0) : matrix_mean.rows_vec(0);
+    const size_t &n = axis == 0 ? width() : height();
 
-            // Calculate the sum of the squares of the differences between the values and the mean
-            for (size_t r = 0; r < height(); r++)
-                sum += std::pow(cell(r, c) - mean, 2);
+    // Calculate the sum of the squares of the differences between the values and the mean, in the order of the buffer
+    std::vector<float> acc(means.size(), 0);
+    __fold(acc, axis, [&means](const float &sum, const T &val, const size_t &i)
+           { return sum + float(std::pow(val - means[i], 2)); });
 
-            // Calculate the standard deviation and push it to the result matrix
-            m[0][c] = std::sqrt(sum / height());
-        }
+    // Calculate the standard deviation and push it to the result matrix
+    cmatrix<float, Layout> m = axis == 0 ? cmatrix<float, Layout>(height(), 1) : cmatrix<float, Layout>(1, width());
 
-        return cmatrix<float>(m);
-    }
+    for (size_t i = 0; i < acc.size(); i++)
+        m.__at(axis == 0 ? i : 0, axis == 0 ? 0 : i) = std::sqrt(acc[i] / n);
 
-    else
-        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+    return m;
 }
 
-template <class T>
-cmatrix<float> cmatrix<T>::__std(const unsigned int &axis, std::false_type) const
+template <class T, class Layout>
+cmatrix<float, Layout> cmatrix<T, Layout>::__std(const unsigned int &axis, std::false_type) const
 {
     throw std::invalid_argument("The type of the matrix must be arithmetic.");
 }
 
-template <class T>
-cmatrix<float> cmatrix<T>::std(const unsigned int &axis) const
+template <class T, class Layout>
+cmatrix<float, Layout> cmatrix<T, Layout>::std(const unsigned int &axis) const
 {
     return __std(axis, std::is_arithmetic<T>());
 }
 
-template <class T>
-cmatrix<T> cmatrix<T>::median(const unsigned int &axis) const
+template <class T, class Layout>
+cmatrix<T, Layout> cmatrix<T, Layout>::median(const unsigned int &axis) const
 {
     // Compute the median for each row.
     if (axis == 0)
     {
         // Initialize the result matrix.
-        std::vector<std::vector<T>> m(height(), std::vector<T>(1));
+        cmatrix<T, Layout> m(height(), 1);
 
-#pragma omp parallel for
-        for (size_t i = 0; i < height(); i++)
-        {
+        cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), height(), [&](size_t i)
+                               {
             // Get the row and sort it.
             std::vector<T> row = rows_vec(i);
             std::sort(row.begin(), row.end());
 
             // Push the median ( middle value -> row.size() / 2 ) to the result matrix.
-            m[i][0] = row[row.size() / 2];
-        }
+            m.__at(i, 0) = row[row.size() / 2]; });
 
-        return cmatrix<T>(m);
+        return m;
     }
 
     // Compute the median for each column.
     else if (axis == 1)
     {
         // Initialize the result matrix.
-        std::vector<std::vector<T>> m(1, std::vector<T>(width()));
+        cmatrix<T, Layout> m(1, width());
 
-#pragma omp parallel for
-        for (size_t i = 0; i < width(); i++)
-        {
+        cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), width(), [&](size_t i)
+                               {
             // Get the column and sort it.
             std::vector<T> col = columns_vec(i);
             std::sort(col.begin(), col.end());
 
             // Push the median ( middle value -> row.size() / 2 ) to the result matrix.
-            m[0][i] = col[col.size() / 2];
-        }
+            m.__at(0, i) = col[col.size() / 2]; });
 
-        return cmatrix<T>(m);
+        return m;
     }
 
     else
         throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
 }
 
+template <class T, class Layout>
+template <class U, class F>
+void cmatrix<T, Layout>::__fold(std::vector<U> &acc, const unsigned int &axis, const F &f) const
+{
+    const size_t &lines = Layout::lines(height(), width());
+    const size_t &length = Layout::length(height(), width());
+    typename storage_type::const_iterator in = matrix.cbegin();
+
+    // The results of a std::vector<bool> are packed: the threads can't write them, so it runs on a single thread
+    const size_t &work = std::is_same<U, bool>::value ? 0 : lines * length;
+
+    // The results are along the lines of the buffer: each one is folded from its own line
+    if ((axis == 0) == cmatrix_layout::is_row_major<Layout>::value)
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, work, lines, [&](size_t i)
+                               {
+            for (size_t k = 0; k < length; k++)
+                acc[i] = f(acc[i], in[i * m_stride + k], i); });
+
+    // Otherwise, each line updates the results of its cells: the threads share the results by blocks,
+    // and read the lines of the buffer one after the other
+    else
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, work, (length + cmatrix_simd::CHUNK - 1) / cmatrix_simd::CHUNK, [&](size_t b)
+                               {
+            const size_t k0 = b * cmatrix_simd::CHUNK;
+
+            for (size_t i = 0; i < lines; i++)
+                for (size_t k = k0; k < std::min(k0 + cmatrix_simd::CHUNK, length); k++)
+                    acc[k] = f(acc[k], in[i * m_stride + k], k); });
+}
+
 #endif // CMATRIX_STATISTICS_TPP
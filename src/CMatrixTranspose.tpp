@@ -0,0 +1,501 @@
+/**
+ * @file CMatrixTranspose.tpp
+ * @brief This file contains the implementation of the transposition engine used by transpose_into,
+ *        transpose_inplace and the conversions between the layouts.
+ *
+ * @details The engine writes the lines of a buffer as the columns of another one. The buffer is split in
+ *          halves along its longest side until a block of BLOCK x BLOCK cells fits in the L1 cache, whatever
+ *          the size of the caches. The blocks are transposed by tiles kept in the vector registers:
+ *          8 x 8 cells of 4 bytes or 4 x 4 cells of 8 bytes with AVX2, 4 x 4 cells of 4 bytes with SSE4.2.
+ *          So each cache line read or written is used entirely, instead of one cell per line. Down to
+ *          blocks of MACRO x MACRO cells, the first half of each split is spawned as a task.
+ *
+ * @see cmatrix::transpose_into
+ * @see cmatrix::transpose_inplace
+ */
+
+#ifndef CMATRIX_TRANSPOSE_TPP
+#define CMATRIX_TRANSPOSE_TPP
+
+namespace cmatrix_transpose
+{
+    /**
+     * @brief The side of the smallest blocks transposed as a task. (see CMatrixTask.hpp)
+     * Each block is then transposed recursively by its thread, down to blocks of cmatrix_layout::BLOCK.
+     */
+    const size_t MACRO = 256;
+
+    // ==================================================
+    // TILES
+
+    /**
+     * @brief Transpose the cells one by one. Used for the types without vector kernel and for the
+     * iterators of the bit-packed buffers.
+     */
+    struct scalar_tile
+    {
+        static const size_t N = 1;
+
+        template <class In, class Out>
+        static void copy(In src, const size_t &, Out dst, const size_t &)
+        {
+            *dst = *src;
+        }
+
+        template <class It>
+        static void swap(It a, It b, const size_t &)
+        {
+            typedef typename std::iterator_traits<It>::value_type value_type;
+
+            const value_type val = *a;
+            *a = value_type(*b);
+            *b = val;
+        }
+    };
+
+#ifdef CMATRIX_SIMD_X86
+    /**
+     * @brief Transpose a tile of 4 x 4 cells of 4 bytes in SSE registers.
+     */
+    struct sse42_tile32
+    {
+        static const size_t N = 4;
+
+        template <class T>
+        __attribute__((target("sse4.2"))) static void copy(const T *src, const size_t &ss, T *dst, const size_t &ds)
+        {
+            __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float *>(src));
+            __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float *>(src + ss));
+            __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float *>(src + 2 * ss));
+            __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float *>(src + 3 * ss));
+
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+            _mm_storeu_ps(reinterpret_cast<float *>(dst), r0);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst + ds), r1);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst + 2 * ds), r2);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst + 3 * ds), r3);
+        }
+
+        template <class T>
+        __attribute__((target("sse4.2"))) static void swap(T *a, T *b, const size_t &s)
+        {
+            __m128 a0 = _mm_loadu_ps(reinterpret_cast<const float *>(a));
+            __m128 a1 = _mm_loadu_ps(reinterpret_cast<const float *>(a + s));
+            __m128 a2 = _mm_loadu_ps(reinterpret_cast<const float *>(a + 2 * s));
+            __m128 a3 = _mm_loadu_ps(reinterpret_cast<const float *>(a + 3 * s));
+            __m128 b0 = _mm_loadu_ps(reinterpret_cast<const float *>(b));
+            __m128 b1 = _mm_loadu_ps(reinterpret_cast<const float *>(b + s));
+            __m128 b2 = _mm_loadu_ps(reinterpret_cast<const float *>(b + 2 * s));
+            __m128 b3 = _mm_loadu_ps(reinterpret_cast<const float *>(b + 3 * s));
+
+            _MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+            _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+            _mm_storeu_ps(reinterpret_cast<float *>(a), b0);
+            _mm_storeu_ps(reinterpret_cast<float *>(a + s), b1);
+            _mm_storeu_ps(reinterpret_cast<float *>(a + 2 * s), b2);
+            _mm_storeu_ps(reinterpret_cast<float *>(a + 3 * s), b3);
+            _mm_storeu_ps(reinterpret_cast<float *>(b), a0);
+            _mm_storeu_ps(reinterpret_cast<float *>(b + s), a1);
+            _mm_storeu_ps(reinterpret_cast<float *>(b + 2 * s), a2);
+            _mm_storeu_ps(reinterpret_cast<float *>(b + 3 * s), a3);
+        }
+    };
+
+    /**
+     * @brief Transpose a tile of 8 x 8 cells of 4 bytes in AVX registers.
+     */
+    struct avx2_tile32
+    {
+        static const size_t N = 8;
+
+        /**
+         * @brief Transpose 8 registers of 8 cells: interleave the pairs of rows, then the pairs of pairs,
+         * then exchange the halves of the registers.
+         */
+        CMATRIX_SIMD_AVX2 void transpose(__m256 *r)
+        {
+            const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+            const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+            const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+            const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+            const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+            const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+            const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+            const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+            const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+            const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+            const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+            r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+            r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+            r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+            r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+            r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+            r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+            r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+            r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+        }
+
+        template <class T>
+        __attribute__((target("avx2"))) static void copy(const T *src, const size_t &ss, T *dst, const size_t &ds)
+        {
+            __m256 r[8];
+
+            for (size_t i = 0; i < 8; i++)
+                r[i] = _mm256_loadu_ps(reinterpret_cast<const float *>(src + i * ss));
+
+            transpose(r);
+
+            for (size_t i = 0; i < 8; i++)
+                _mm256_storeu_ps(reinterpret_cast<float *>(dst + i * ds), r[i]);
+        }
+
+        template <class T>
+        __attribute__((target("avx2"))) static void swap(T *a, T *b, const size_t &s)
+        {
+            __m256 ra[8], rb[8];
+
+            for (size_t i = 0; i < 8; i++)
+            {
+                ra[i] = _mm256_loadu_ps(reinterpret_cast<const float *>(a + i * s));
+                rb[i] = _mm256_loadu_ps(reinterpret_cast<const float *>(b + i * s));
+            }
+
+            transpose(ra);
+            transpose(rb);
+
+            for (size_t i = 0; i < 8; i++)
+            {
+                _mm256_storeu_ps(reinterpret_cast<float *>(a + i * s), rb[i]);
+                _mm256_storeu_ps(reinterpret_cast<float *>(b + i * s), ra[i]);
+            }
+        }
+    };
+
+    /**
+     * @brief Transpose a tile of 4 x 4 cells of 8 bytes in AVX registers.
+     */
+    struct avx2_tile64
+    {
+        static const size_t N = 4;
+
+        CMATRIX_SIMD_AVX2 void transpose(__m256d *r)
+        {
+            const __m256d t0 = _mm256_unpacklo_pd(r[0], r[1]);
+            const __m256d t1 = _mm256_unpackhi_pd(r[0], r[1]);
+            const __m256d t2 = _mm256_unpacklo_pd(r[2], r[3]);
+            const __m256d t3 = _mm256_unpackhi_pd(r[2], r[3]);
+
+            r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+            r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+            r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+            r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+        }
+
+        template <class T>
+        __attribute__((target("avx2"))) static void copy(const T *src, const size_t &ss, T *dst, const size_t &ds)
+        {
+            __m256d r[4];
+
+            for (size_t i = 0; i < 4; i++)
+                r[i] = _mm256_loadu_pd(reinterpret_cast<const double *>(src + i * ss));
+
+            transpose(r);
+
+            for (size_t i = 0; i < 4; i++)
+                _mm256_storeu_pd(reinterpret_cast<double *>(dst + i * ds), r[i]);
+        }
+
+        template <class T>
+        __attribute__((target("avx2"))) static void swap(T *a, T *b, const size_t &s)
+        {
+            __m256d ra[4], rb[4];
+
+            for (size_t i = 0; i < 4; i++)
+            {
+                ra[i] = _mm256_loadu_pd(reinterpret_cast<const double *>(a + i * s));
+                rb[i] = _mm256_loadu_pd(reinterpret_cast<const double *>(b + i * s));
+            }
+
+            transpose(ra);
+            transpose(rb);
+
+            for (size_t i = 0; i < 4; i++)
+            {
+                _mm256_storeu_pd(reinterpret_cast<double *>(a + i * s), rb[i]);
+                _mm256_storeu_pd(reinterpret_cast<double *>(b + i * s), ra[i]);
+            }
+        }
+    };
+#endif
+
+    /**
+     * @brief Select the tile of an instruction set for the cells of a buffer.
+     * The vector tiles move the bytes of the cells, so they apply to the arithmetic types of 4 or 8 bytes
+     * stored in a plain array. The other buffers are transposed cell by cell.
+     *
+     * @tparam I The instruction set.
+     * @tparam It The iterator on the cells.
+     */
+    template <cmatrix_simd::isa I, class It, size_t S = 0>
+    struct tile
+    {
+        typedef scalar_tile type;
+    };
+
+    template <cmatrix_simd::isa I, class T>
+    struct tile<I, T *, 0> : tile<I, T *, std::is_arithmetic<T>::value and not std::is_same<T, bool>::value ? sizeof(T) : 1>
+    {
+    };
+
+    template <cmatrix_simd::isa I, class T>
+    struct tile<I, T *, 1>
+    {
+        typedef scalar_tile type;
+    };
+
+#ifdef CMATRIX_SIMD_X86
+    template <class T>
+    struct tile<cmatrix_simd::SSE42, T *, 4>
+    {
+        typedef sse42_tile32 type;
+    };
+
+    template <class T>
+    struct tile<cmatrix_simd::AVX2, T *, 4>
+    {
+        typedef avx2_tile32 type;
+    };
+
+    template <class T>
+    struct tile<cmatrix_simd::AVX2, T *, 8>
+    {
+        typedef avx2_tile64 type;
+    };
+
+    template <class T>
+    struct tile<cmatrix_simd::AVX512, T *, 4>
+    {
+        typedef avx2_tile32 type;
+    };
+
+    template <class T>
+    struct tile<cmatrix_simd::AVX512, T *, 8>
+    {
+        typedef avx2_tile64 type;
+    };
+#endif
+
+    // ==================================================
+    // KERNELS
+
+    /**
+     * @brief Transpose a block fitting in the cache, tile by tile, then the remaining cells one by one.
+     *
+     * @tparam K The tile.
+     * @see transpose
+     */
+    template <class K, class In, class Out>
+    void block(In src, const size_t &ss, Out dst, const size_t &ds, const size_t &lines, const size_t &length)
+    {
+        size_t i = 0;
+
+        for (; i + K::N <= lines; i += K::N)
+        {
+            size_t j = 0;
+
+            for (; j + K::N <= length; j += K::N)
+                K::copy(src + i * ss + j, ss, dst + j * ds + i, ds);
+
+            for (; j < length; j++)
+                for (size_t k = i; k < i + K::N; k++)
+                    dst[j * ds + k] = src[k * ss + j];
+        }
+
+        for (; i < lines; i++)
+            for (size_t j = 0; j < length; j++)
+                dst[j * ds + i] = src[i * ss + j];
+    }
+
+    /**
+     * @brief Split the longest side of a block in two halves, on a multiple of the tile, until the block
+     * fits in the cache.
+     *
+     * @tparam K The tile.
+     * @see transpose
+     */
+    template <class K, class In, class Out>
+    void recurse(In src, const size_t &ss, Out dst, const size_t &ds, const size_t &lines, const size_t &length)
+    {
+        const size_t &B = cmatrix_layout::BLOCK;
+
+        if (lines > B and lines >= length)
+        {
+            const size_t half = (lines / 2 + K::N - 1) / K::N * K::N;
+
+            recurse<K>(src, ss, dst, ds, half, length);
+            recurse<K>(src + half * ss, ss, dst + half, ds, lines - half, length);
+        }
+
+        else if (length > B)
+        {
+            const size_t half = (length / 2 + K::N - 1) / K::N * K::N;
+
+            recurse<K>(src, ss, dst, ds, lines, half);
+            recurse<K>(src + half, ss, dst + half * ds, ds, lines, length - half);
+        }
+
+        else
+            block<K>(src, ss, dst, ds, lines, length);
+    }
+
+    /**
+     * @brief Split the longest side of a block in two halves while it exceeds MACRO x MACRO cells, and spawn
+     * a task for the first half: the idle threads steal the biggest halves first.
+     *
+     * @tparam K The tile.
+     * @see transpose
+     */
+    template <class K, class In, class Out>
+    void split(In src, const size_t &ss, Out dst, const size_t &ds, const size_t &lines, const size_t &length)
+    {
+        if (lines * length <= MACRO * MACRO)
+            return recurse<K>(src, ss, dst, ds, lines, length);
+
+        cmatrix_task::group halves;
+
+        if (lines >= length)
+        {
+            const size_t half = (lines / 2 + K::N - 1) / K::N * K::N;
+
+            halves.spawn([=]()
+                         { split<K>(src, ss, dst, ds, half, length); });
+            split<K>(src + half * ss, ss, dst + half, ds, lines - half, length);
+        }
+
+        else
+        {
+            const size_t half = (length / 2 + K::N - 1) / K::N * K::N;
+
+            halves.spawn([=]()
+                         { split<K>(src, ss, dst, ds, lines, half); });
+            split<K>(src + half, ss, dst + half * ds, ds, lines, length - half);
+        }
+
+        halves.sync();
+    }
+
+    /**
+     * @brief Transpose the buffer as tasks of the scheduler of the execution policy.
+     *
+     * @tparam K The tile.
+     * @see transpose
+     */
+    template <class K, class In, class Out>
+    void tasks(In src, const size_t &ss, Out dst, const size_t &ds, const size_t &lines, const size_t &length)
+    {
+        cmatrix_task::run(cmatrix_parallel::TRANSPOSE, lines * length, [&]()
+                          { split<K>(src, ss, dst, ds, lines, length); });
+    }
+
+    /**
+     * @brief Transpose a square buffer in place: swap the tiles above the diagonal with the tiles below it,
+     * then the remaining cells one by one.
+     *
+     * @tparam K The tile.
+     * @see transpose_square
+     */
+    template <class K, class It>
+    void square(It a, const size_t &s, const size_t &n)
+    {
+        const size_t tiles = n / K::N;
+
+        // Each thread swaps a row of tiles with the column of tiles of the same index
+        cmatrix_exec::for_each(cmatrix_parallel::TRANSPOSE, n * n, tiles, [&](size_t t)
+                               {
+            const size_t i = t * K::N;
+
+            // The tile of the diagonal is read entirely before being written
+            K::copy(a + i * s + i, s, a + i * s + i, s);
+
+            for (size_t j = i + K::N; j < tiles * K::N; j += K::N)
+                K::swap(a + i * s + j, a + j * s + i, s);
+
+            for (size_t r = i; r < i + K::N; r++)
+                for (size_t c = tiles * K::N; c < n; c++)
+                    scalar_tile::swap(a + r * s + c, a + c * s + r, s); }, true);
+
+        // The cells of the last rows and columns, beyond the last tile
+        for (size_t r = tiles * K::N; r < n; r++)
+            for (size_t c = r + 1; c < n; c++)
+                scalar_tile::swap(a + r * s + c, a + c * s + r, s);
+    }
+
+    // ==================================================
+    // ENGINE
+
+    /**
+     * @brief Write the lines of a buffer as the columns of another buffer: dst[j * ds + i] = src[i * ss + j].
+     * It is the transpose of a matrix in the same layout, and the conversion of a matrix to the other layout.
+     *
+     * @param src The first cell of the buffer to read.
+     * @param ss The distance between two lines of `src`.
+     * @param dst The first cell of the buffer to write.
+     * @param ds The distance between two lines of `dst`.
+     * @param lines The number of lines of `src`, the number of cells of the lines of `dst`.
+     * @param length The number of cells of the lines of `src`, the number of lines of `dst`.
+     *
+     * @note The buffers must not overlap.
+     * @note PARALLELIZED METHOD with tasks. The halves of the buffer are spawned down to MACRO x MACRO cells.
+     */
+    template <class In, class Out>
+    void transpose(In src, const size_t &ss, Out dst, const size_t &ds, const size_t &lines, const size_t &length)
+    {
+        switch (cmatrix_simd::level())
+        {
+        case cmatrix_simd::AVX512:
+            return tasks<typename tile<cmatrix_simd::AVX512, Out>::type>(src, ss, dst, ds, lines, length);
+        case cmatrix_simd::AVX2:
+            return tasks<typename tile<cmatrix_simd::AVX2, Out>::type>(src, ss, dst, ds, lines, length);
+        case cmatrix_simd::SSE42:
+            return tasks<typename tile<cmatrix_simd::SSE42, Out>::type>(src, ss, dst, ds, lines, length);
+        default:
+            return tasks<scalar_tile>(src, ss, dst, ds, lines, length);
+        }
+    }
+
+    /**
+     * @brief Transpose a square buffer in place, without any other buffer.
+     *
+     * @param a The first cell of the buffer.
+     * @param s The distance between two lines.
+     * @param n The number of lines, and of cells per line.
+     *
+     * @note PARALLELIZED METHOD with OpenMP. The rows of tiles are distributed across the threads.
+     */
+    template <class It>
+    void transpose_square(It a, const size_t &s, const size_t &n)
+    {
+        switch (cmatrix_simd::level())
+        {
+        case cmatrix_simd::AVX512:
+            return square<typename tile<cmatrix_simd::AVX512, It>::type>(a, s, n);
+        case cmatrix_simd::AVX2:
+            return square<typename tile<cmatrix_simd::AVX2, It>::type>(a, s, n);
+        case cmatrix_simd::SSE42:
+            return square<typename tile<cmatrix_simd::SSE42, It>::type>(a, s, n);
+        default:
+            return square<scalar_tile>(a, s, n);
+        }
+    }
+}
+
+#endif // CMATRIX_TRANSPOSE_TPP
@@ -0,0 +1,294 @@
+/**
+ * @file CMatrixView.tpp
+ * @brief This file contains the implementation of the cmatrix_view class.
+ *
+ * @see cmatrix_view
+ */
+
+#ifndef CMATRIX_VIEW_TPP
+#define CMATRIX_VIEW_TPP
+
+// ==================================================
+// CONSTRUCTORS
+
+template <class T>
+cmatrix_view<T>::cmatrix_view(const T *data, const size_t &height, const size_t &width, const size_t &row_stride, const size_t &col_stride)
+    : m_data(data), m_height(height), m_width(width), m_row_stride(row_stride), m_col_stride(col_stride) {}
+
+// ==================================================
+// GETTERS
+
+template <class T>
+size_t cmatrix_view<T>::height() const
+{
+    return m_height;
+}
+
+template <class T>
+size_t cmatrix_view<T>::width() const
+{
+    return m_width;
+}
+
+template <class T>
+std::pair<size_t, size_t> cmatrix_view<T>::size() const
+{
+    return std::pair<size_t, size_t>(height(), width());
+}
+
+template <class T>
+bool cmatrix_view<T>::is_empty() const
+{
+    return height() == 0 or width() == 0;
+}
+
+template <class T>
+size_t cmatrix_view<T>::row_stride() const
+{
+    return m_row_stride;
+}
+
+template <class T>
+size_t cmatrix_view<T>::col_stride() const
+{
+    return m_col_stride;
+}
+
+template <class T>
+const T *cmatrix_view<T>::data() const
+{
+    return m_data;
+}
+
+template <class T>
+const T &cmatrix_view<T>::operator()(const size_t &row, const size_t &col) const
+{
+    return m_data[row * m_row_stride + col * m_col_stride];
+}
+
+template <class T>
+void cmatrix_view<T>::broadcast_to(const size_t &height, const size_t &width)
+{
+    if (m_height != height)
+        m_row_stride = 0;
+
+    if (m_width != width)
+        m_col_stride = 0;
+
+    m_height = height;
+    m_width = width;
+}
+
+template <class T>
+bool cmatrix_view<T>::overlaps(const T *begin, const T *end) const
+{
+    if (is_empty())
+        return false;
+
+    // The cells of the view are between its first cell and its last cell
+    const T *last = m_data + (m_height - 1) * m_row_stride + (m_width - 1) * m_col_stride;
+    const std::less<const T *> lt;
+
+    return not lt(last, begin) and lt(m_data, end);
+}
+
+template <class T>
+const T &cmatrix_view<T>::cell(const size_t &row, const size_t &col) const
+{
+    __check_valid_row_id(row);
+    __check_valid_col_id(col);
+
+    return (*this)(row, col);
+}
+
+template <class T>
+cmatrix_view<T> cmatrix_view<T>::slice_rows(const size_t &start, const size_t &end) const
+{
+    __check_valid_row_id(start);
+    __check_valid_row_id(end);
+
+    if (start > end)
+        throw std::invalid_argument("The start index must be less than or equal to the end index");
+
+    // Move the first cell, the strides are unchanged
+    return cmatrix_view<T>(m_data + start * m_row_stride, end - start + 1, m_width, m_row_stride, m_col_stride);
+}
+
+template <class T>
+cmatrix_view<T> cmatrix_view<T>::slice_columns(const size_t &start, const size_t &end) const
+{
+    __check_valid_col_id(start);
+    __check_valid_col_id(end);
+
+    if (start > end)
+        throw std::invalid_argument("The start index must be less than or equal to the end index");
+
+    return cmatrix_view<T>(m_data + start * m_col_stride, m_height, end - start + 1, m_row_stride, m_col_stride);
+}
+
+template <class T>
+cmatrix_view<T> cmatrix_view<T>::row(const size_t &n) const
+{
+    return slice_rows(n, n);
+}
+
+template <class T>
+cmatrix_view<T> cmatrix_view<T>::column(const size_t &n) const
+{
+    return slice_columns(n, n);
+}
+
+template <class T>
+cmatrix_view<T> cmatrix_view<T>::transpose() const
+{
+    return cmatrix_view<T>(m_data, m_width, m_height, m_col_stride, m_row_stride);
+}
+
+// ==================================================
+// READ-ONLY OPERATIONS
+
+template <class T>
+cmatrix<T> cmatrix_view<T>::copy() const
+{
+    return cmatrix<T>(*this);
+}
+
+template <class T>
+cmatrix<T> cmatrix_view<T>::sum(const unsigned int &axis, const T &zero) const
+{
+    // Compute the sum for each row
+    if (axis == 0)
+    {
+        cmatrix<T> m(height(), 1);
+
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, height() * width(), height(), [&](size_t r)
+                               {
+            T sum = zero;
+
+            for (size_t c = 0; c < width(); c++)
+                sum += (*this)(r, c);
+
+            m.__at(r, 0) = sum; });
+
+        return m;
+    }
+
+    // Compute the sum for each column
+    else if (axis == 1)
+    {
+        cmatrix<T> m(1, width());
+
+        cmatrix_exec::for_each(cmatrix_parallel::REDUCTION, height() * width(), width(), [&](size_t c)
+                               {
+            T sum = zero;
+
+            for (size_t r = 0; r < height(); r++)
+                sum += (*this)(r, c);
+
+            m.__at(0, c) = sum; });
+
+        return m;
+    }
+
+    else
+        throw std::invalid_argument("The axis must be 0: horizontal, or 1: vertical. Actual: " + std::to_string(axis) + ".");
+}
+
+template <class T>
+cmatrix<T> cmatrix_view<T>::map(const std::function<T(T)> &f) const
+{
+    cmatrix<T> m(height(), width());
+
+    cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), height(), [&](size_t r)
+                           {
+        for (size_t c = 0; c < width(); c++)
+            m.__at(r, c) = f((*this)(r, c)); });
+
+    return m;
+}
+
+template <class T>
+cmatrix<T> cmatrix_view<T>::map(const std::function<T(T, size_t, size_t)> &f) const
+{
+    cmatrix<T> m(height(), width());
+
+    cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, height() * width(), height(), [&](size_t r)
+                           {
+        for (size_t c = 0; c < width(); c++)
+            m.__at(r, c) = f((*this)(r, c), r, c); });
+
+    return m;
+}
+
+template <class T>
+cmatrix<T> cmatrix_view<T>::matmul(const cmatrix_view<T> &m) const
+{
+    cmatrix<T> result(height(), m.width());
+    matmul_into(result, m);
+
+    return result;
+}
+
+template <class T>
+template <class Layout>
+void cmatrix_view<T>::matmul_into(cmatrix<T, Layout> &out, const cmatrix_view<T> &m) const
+{
+    // Check if the number of columns of the first matrix
+    // is equal to the number of rows of the second matrix
+    if (width() != m.height())
+        throw std::invalid_argument("The number of columns of the first matrix must be equal to the number of rows of the second matrix. Expected: " +
+                                    std::to_string(width()) +
+                                    ". Actual: " +
+                                    std::to_string(m.height()));
+
+    cmatrix<T, Layout>::__check_out(out, height(), m.width());
+
+    // Take the buffer of the output first, so a buffer shared with an operand is copied before the check
+    T *c = out.matrix.data();
+    const T *end = c + out.matrix.size();
+
+    // The engine accumulates in the output, which must not be read as an operand
+    const std::less<const T *> lt;
+    if ((not lt(data(), c) and lt(data(), end)) or (not lt(m.data(), c) and lt(m.data(), end)))
+        throw std::invalid_argument("The output matrix must not share its cells with the operands of the product.");
+
+    std::fill(c, c + out.matrix.size(), T());
+
+    // The engine reads the operands and writes the result through their strides, so the views are not copied
+    cmatrix_gemm::gemm(height(), m.width(), width(),
+                       data(), row_stride(), col_stride(),
+                       m.data(), m.row_stride(), m.col_stride(),
+                       c, Layout::row_step(out.m_stride), Layout::col_step(out.m_stride));
+}
+
+template <class T>
+template <class Layout>
+cmatrix<T> cmatrix_view<T>::matmul(const cmatrix<T, Layout> &m) const
+{
+    return matmul(m.view());
+}
+
+// ==================================================
+// CHECK METHODS
+
+template <class T>
+void cmatrix_view<T>::__check_valid_row_id(const size_t &n) const
+{
+    if (n >= height())
+        throw std::out_of_range("Invalid row index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(height()));
+}
+
+template <class T>
+void cmatrix_view<T>::__check_valid_col_id(const size_t &n) const
+{
+    if (n >= width())
+        throw std::out_of_range("Invalid column index. Expected: 0 <= " +
+                                std::to_string(n) +
+                                " < " +
+                                std::to_string(width()));
+}
+
+#endif // CMATRIX_VIEW_TPP
@@ -5,6 +5,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <set>
 #include "CMatrix.hpp"
 
 // ==================================================
@@ -69,6 +70,48 @@ TEST(MatrixTest, Constructor)
     EXPECT_NO_THROW(cmatrix<cbool> m_9());
 }
 
+/** Test move constructors and move assignment of cmatrix class */
+TEST(MatrixTest, ConstructorMove)
+{
+    // MOVE CONSTRUCTOR
+    cmatrix<int> m_1 = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> m_2 = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> m_3(std::move(m_1));
+    EXPECT_EQ(m_3, m_2);
+    EXPECT_TRUE(m_1.is_empty());
+
+    // MOVE ASSIGNMENT
+    cmatrix<int> m_4 = {{7}};
+    m_4 = std::move(m_3);
+    EXPECT_EQ(m_4, m_2);
+    EXPECT_TRUE(m_3.is_empty());
+
+    // MOVED MATRIX CAN BE REUSED
+    m_3 = {{1, 2}};
+    EXPECT_EQ(m_3.width(), 2);
+
+    // MOVE FROM A VECTOR MATRIX
+    std::vector<std::vector<std::string>> v_1 = {{"a", "b"}, {"c", "d"}};
+    cmatrix<std::string> m_5(std::move(v_1));
+    cmatrix<std::string> m_6 = {{"a", "b"}, {"c", "d"}};
+    EXPECT_EQ(m_5, m_6);
+    EXPECT_TRUE(v_1.empty());
+    std::vector<std::vector<int>> v_2 = {{1, 2}, {3}};
+    EXPECT_THROW(cmatrix<int> m_7(std::move(v_2)), std::invalid_argument);
+
+    // OPERATORS WITH EXPIRING MATRICES
+    cmatrix<double> m_8 = {{1, 2}, {3, 4}};
+    cmatrix<double> m_9 = {{3, 5}, {7, 9}};
+    EXPECT_EQ(cmatrix<double>(m_8) * 2 + 1, m_9);
+    EXPECT_EQ(1 + 2 * cmatrix<double>(m_8), m_9);
+    EXPECT_EQ(cmatrix<double>(m_8) + cmatrix<double>(m_8) + 1 + m_8 - m_8, m_9);
+    EXPECT_EQ(m_9 - cmatrix<double>(m_8), m_8 + 1);
+    EXPECT_EQ(10 - cmatrix<double>(m_9), 9 - m_9 + 1);
+    EXPECT_EQ(-cmatrix<double>(m_8), m_8 * (-1));
+    EXPECT_EQ(cmatrix<double>(m_9) / 1, m_9);
+    EXPECT_THROW(cmatrix<double>(m_8) + cmatrix<double>(1, 3), std::invalid_argument);
+}
+
 // ==================================================
 // GETTER METHODS
 
@@ -275,6 +318,39 @@ TEST(MatrixTest, cell)
     EXPECT_THROW(m.cell(0, 3), std::out_of_range);
 }
 
+/** Test the unchecked accessors of cmatrix class */
+TEST(MatrixTest, at_unchecked)
+{
+    // 2x3 MATRIX
+    cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(m.at_unchecked(1, 2), 6);
+    m.at_unchecked(0, 1) = 10;
+    EXPECT_EQ(m, cmatrix<int>({{1, 10, 3}, {4, 5, 6}}));
+
+    // RAW POINTERS
+    EXPECT_EQ(m.data()[4], 5);
+    EXPECT_EQ(m.row_data(1), m.data() + 3);
+    m.row_data(1)[2] = 0;
+    EXPECT_EQ(m.cell(1, 2), 0);
+
+    const cmatrix<int> &c = m;
+    EXPECT_EQ(c.row_data(0)[1], 10);
+    EXPECT_EQ(c.at_unchecked(1, 0), 4);
+
+    // BOOLEAN MATRIX
+    cmatrix<cbool> m_bool = {{1, 0}, {0, 1}};
+    m_bool.at_unchecked(0, 1) = 1;
+    EXPECT_EQ(m_bool, cmatrix<cbool>({{1, 1}, {0, 1}}));
+
+    // OUT OF RANGE - ONLY CHECKED IF ENABLED
+    if (CMATRIX_BOUNDS_CHECK)
+    {
+        EXPECT_THROW(m.at_unchecked(2, 0), std::out_of_range);
+        EXPECT_THROW(m.at_unchecked(0, 3), std::out_of_range);
+        EXPECT_THROW(m.row_data(2), std::out_of_range);
+    }
+}
+
 /** Test slice_rows method of cmatrix class */
 TEST(MatrixTest, slice_rows)
 {
@@ -293,6 +369,16 @@ TEST(MatrixTest, slice_rows)
     cmatrix<int> m_3 = {{1}, {2}, {3}};
     EXPECT_EQ(m_3.slice_rows(0, 0), cmatrix<int>({{1}}));
 
+    // TEMPORARY MATRIX - A COPY INSTEAD OF A VIEW
+    cmatrix<int> s = cmatrix<int>::randint(3, CMATRIX_INLINE_SIZE + 1, 0, 9, 2).slice_rows(1, 2);
+    EXPECT_EQ(s.size(), std::make_pair(size_t(2), size_t(CMATRIX_INLINE_SIZE + 1)));
+    auto s_2 = cmatrix<int>(m).slice_rows(1, 1);
+    s_2.set_cell(0, 0, 0);
+    EXPECT_EQ(s_2, cmatrix<int>({{0, 5, 6}}));
+    EXPECT_TRUE((std::is_same<decltype(cmatrix<int, cmatrix_layout::col_major>().slice_rows(0, 0)), cmatrix<int, cmatrix_layout::col_major>>::value));
+    EXPECT_TRUE((std::is_same<decltype(m.slice_rows(0, 0)), cmatrix_view<int>>::value));
+    EXPECT_THROW(cmatrix<int>(m).slice_rows(0, 3), std::out_of_range);
+
     // OUT OF RANGE - ROW
     EXPECT_THROW(m.slice_rows(0, 3), std::out_of_range);
 
@@ -320,6 +406,12 @@ TEST(MatrixTest, slice_columns)
     cmatrix<int> m_3 = {{1}, {2}, {3}};
     EXPECT_EQ(m_3.slice_columns(0, 0), m_3);
 
+    // TEMPORARY MATRIX - A COPY INSTEAD OF A VIEW
+    auto s = cmatrix<int, cmatrix_layout::col_major>(m).slice_columns(1, 2);
+    s.set_cell(0, 0, 0);
+    EXPECT_EQ(s, cmatrix<int>({{0, 3}, {5, 6}, {8, 9}}));
+    EXPECT_TRUE((std::is_same<decltype(m.slice_columns(0, 0)), cmatrix_view<int>>::value));
+
     // OUT OF RANGE - COLUMN
     EXPECT_THROW(m.slice_columns(0, 3), std::out_of_range);
 
@@ -327,6 +419,234 @@ TEST(MatrixTest, slice_columns)
     EXPECT_THROW(m.slice_columns(1, 0), std::invalid_argument);
 }
 
+/** Test view method of cmatrix class */
+TEST(MatrixTest, view)
+{
+    // WHOLE MATRIX
+    cmatrix<int> m = {{1, 2, 3},
+                      {4, 5, 6},
+                      {7, 8, 9}};
+    cmatrix_view<int> v = m.view();
+    EXPECT_EQ(v, m);
+    EXPECT_EQ(v.cell(1, 2), 6);
+    EXPECT_THROW(v.cell(3, 0), std::out_of_range);
+
+    // SLICES WITHOUT COPY
+    cmatrix_view<int> v_2 = m.slice_rows(1, 2).slice_columns(1, 2);
+    EXPECT_EQ(v_2.data(), &v.cell(1, 1));
+    EXPECT_EQ(v_2, cmatrix<int>({{5, 6}, {8, 9}}));
+    EXPECT_EQ(v.row(2), cmatrix<int>({{7, 8, 9}}));
+    EXPECT_EQ(v.column(0), cmatrix<int>({{1}, {4}, {7}}));
+
+    // TRANSPOSE WITHOUT COPY
+    EXPECT_EQ(v.transpose(), m.transpose());
+    EXPECT_EQ(v.transpose().slice_rows(0, 0), cmatrix<int>({{1, 4, 7}}));
+    EXPECT_EQ(v.transpose().transpose().data(), v.data());
+
+    // READ-ONLY OPERATIONS
+    EXPECT_EQ(v_2.sum(), cmatrix<int>({{11}, {17}}));
+    EXPECT_EQ(v_2.sum(1), cmatrix<int>({{13, 15}}));
+    EXPECT_EQ(v_2.sum_all(), 28);
+    EXPECT_EQ(v_2.min_all(), 5);
+    EXPECT_EQ(v_2.map([](int x) { return x * 10; }), cmatrix<int>({{50, 60}, {80, 90}}));
+    EXPECT_EQ(v_2 + v_2, v_2 * 2);
+    EXPECT_EQ(m, cmatrix<int>(v));
+
+    // PRODUCT WITH VIEWS
+    EXPECT_EQ(m.matmul(v.transpose()), m.matmul(m.transpose()));
+    EXPECT_EQ(v.transpose().matmul(m), m.transpose().matmul(m));
+    EXPECT_EQ(v_2.matmul(v.slice_rows(0, 1)), cmatrix<int>({{29, 40, 51}, {44, 61, 78}}));
+    EXPECT_THROW(v_2.matmul(m), std::invalid_argument);
+
+    // COMPARISONS AND MASKS WITH VIEWS
+    EXPECT_EQ(m.eq(v.transpose()), cmatrix<cbool>({{1, 0, 0}, {0, 1, 0}, {0, 0, 1}}));
+    EXPECT_EQ(m.neq(v.transpose()), m.neq(m.transpose()));
+    EXPECT_EQ(m.lt(v.transpose()), m.lt(m.transpose()));
+    EXPECT_EQ(m.gt(v.transpose()), m.gt(m.transpose()));
+    EXPECT_EQ(m.leq(v.transpose()), m.leq(m.transpose()));
+    EXPECT_EQ(m.geq(v.transpose()), m.geq(m.transpose()));
+    EXPECT_EQ(cmatrix<int>({{5, 7}, {9, 9}}).geq(v_2), cmatrix<cbool>({{1, 1}, {1, 1}}));
+    EXPECT_EQ(m.gt(v.row(1)), cmatrix<cbool>({{0, 0, 0}, {0, 0, 0}, {1, 1, 1}}));
+    EXPECT_EQ(m.eq(v.column(1).transpose()), cmatrix<cbool>({{0, 0, 0}, {0, 1, 0}, {0, 0, 0}}));
+    EXPECT_THROW(m.eq(v_2), std::invalid_argument);
+    EXPECT_EQ(m.mask([](int a, int b) { return a + b == 10; }, v.transpose()), cmatrix<cbool>({{0, 0, 1}, {0, 1, 0}, {1, 0, 0}}));
+    EXPECT_EQ(m.mask([](int a, int b) { return a < b; }, v.transpose()), m.lt(m.transpose()));
+    EXPECT_EQ(m.mask(std::function<bool(int, int)>([](int a, int b) { return a == b; }), v.transpose()), m.eq(m.transpose()));
+    EXPECT_THROW(m.mask([](int a, int b) { return a == b; }, v_2), std::invalid_argument);
+
+    cmatrix<double> strided = cmatrix<int>::randint(70, 90, -9, 9, 5).cast<double>();
+    cmatrix_view<double> every_other(strided.view().data(), 35, 45, 2 * strided.width(), 2);
+    cmatrix<double> copied = every_other;
+    cmatrix<double> c_2 = cmatrix<int>::randint(35, 45, -9, 9, 6).cast<double>();
+    EXPECT_EQ(c_2.lt(every_other), c_2.lt(copied));
+    EXPECT_EQ(c_2.mask([](double a, double b) { return a == b; }, every_other), c_2.eq(copied));
+
+    // A VIEW OF THE ASSIGNED MATRIX IS READ BEFORE THE MATRIX IS WRITTEN
+    cmatrix<int> a = {{1, 2}, {3, 4}};
+    a = a + a.view().transpose();
+    EXPECT_EQ(a, cmatrix<int>({{2, 5}, {5, 8}}));
+
+    cmatrix<double> big = cmatrix<int>::randint(40, 40, -9, 9, 3).cast<double>();
+    cmatrix<double> expected = big + big.transpose();
+    big = big + big.view().transpose();
+    EXPECT_EQ(big, expected);
+
+    // EMPTY MATRIX
+    cmatrix<int> m_2;
+    EXPECT_TRUE(m_2.view().is_empty());
+    EXPECT_EQ(m_2.view(), m_2);
+}
+
+/** Test the copy-on-write buffer of cmatrix class */
+TEST(MatrixTest, copy_on_write)
+{
+    // THE MATRICES STORED INLINE ARE COPIED, SO THE BUFFER OF A BIGGER ONE IS CHECKED
+    cmatrix<int> big(2, CMATRIX_INLINE_SIZE + 1, 1);
+    const int *data = big.view().data();
+
+    // COPIES SHARE THE BUFFER
+    cmatrix<int> big_2 = big;
+    cmatrix<int> big_3 = big.copy();
+    EXPECT_EQ(big_2.view().data(), data);
+    EXPECT_EQ(big_3.view().data(), data);
+
+    // READ-ONLY METHODS DON'T COPY
+    const cmatrix<int> &c_2 = big_2;
+    EXPECT_EQ(c_2.cell(1, 0), 1);
+    EXPECT_EQ(big_2.sum_all(), 2 * (CMATRIX_INLINE_SIZE + 1));
+    EXPECT_EQ(big_2.view().data(), data);
+
+    // WRITES DETACH THE MODIFIED MATRIX ONLY
+    big_2.set_cell(0, 0, 10);
+    EXPECT_NE(big_2.view().data(), data);
+    EXPECT_EQ(big.view().data(), data);
+    EXPECT_EQ(big, cmatrix<int>(2, CMATRIX_INLINE_SIZE + 1, 1));
+
+    cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> m_2 = m;
+    cmatrix<int> m_3 = m.copy();
+    m_2.set_cell(0, 0, 10);
+    EXPECT_EQ(m, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+    EXPECT_EQ(m_2, cmatrix<int>({{10, 2, 3}, {4, 5, 6}}));
+
+    m_3.cell(1, 1) = 0;
+    EXPECT_EQ(m, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+    EXPECT_EQ(m_3, cmatrix<int>({{1, 2, 3}, {4, 0, 6}}));
+
+    cmatrix<int> m_4 = m;
+    m_4.apply([](int x) { return -x; });
+    m_4 += m;
+    EXPECT_EQ(m_4, cmatrix<int>(2, 3, 0));
+    EXPECT_EQ(m, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+
+    cmatrix<int> m_5 = m;
+    m_5.insert_row(0, {7, 8, 9});
+    m_5.fill(1);
+    EXPECT_EQ(m_5, cmatrix<int>(3, 3, 1));
+    EXPECT_EQ(m, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+
+    // BOOLEAN MATRIX
+    cmatrix<cbool> b = m > 2;
+    cmatrix<cbool> b_2 = b;
+    b_2.set_cell(0, 0, true);
+    EXPECT_EQ(b, cmatrix<cbool>({{false, false, true}, {true, true, true}}));
+    EXPECT_EQ(b_2, cmatrix<cbool>({{true, false, true}, {true, true, true}}));
+
+    // A REFERENCE TAKEN BEFORE A COPY DOESN'T WRITE IN THE COPY
+    cmatrix<float> f(4, 10, 1);
+    float &r = f.cell(0, 0);
+    cmatrix<float> f_2 = f;
+    r = 42;
+    EXPECT_EQ(f.cell(0, 0), 42);
+    EXPECT_EQ(f_2, cmatrix<float>(4, 10, 1));
+    EXPECT_NE(f_2.view().data(), f.view().data());
+
+    // THE COPIES OF THE COPY STILL SHARE ITS BUFFER
+    cmatrix<float> f_3 = f_2;
+    EXPECT_EQ(f_3.view().data(), f_2.view().data());
+
+    // THE POINTERS TOO, AND THE REFERENCE FOLLOWS THE MOVED MATRIX
+    float *p = f_3.data();
+    float *row = f_3.row_data(1);
+    cmatrix<float> f_4 = std::move(f_3);
+    cmatrix<float> f_5 = f_4;
+    p[0] = 7;
+    row[0] = 8;
+    f_4.at_unchecked(2, 0) = 9;
+    EXPECT_EQ(f_4.cell(0, 0), 7);
+    EXPECT_EQ(f_4.cell(1, 0), 8);
+    EXPECT_EQ(f_4.cell(2, 0), 9);
+    EXPECT_EQ(f_5, cmatrix<float>(4, 10, 1));
+    EXPECT_EQ(f_2, cmatrix<float>(4, 10, 1));
+
+    cmatrix<int, cmatrix_layout::col_major> g(10, 4, 1);
+    int *col = g.col_data(3);
+    cmatrix<int, cmatrix_layout::col_major> g_2 = g;
+    col[0] = 5;
+    EXPECT_EQ(g.cell(0, 3), 5);
+    EXPECT_EQ(g_2, cmatrix<int>(10, 4, 1));
+
+    // THE PROXY ON A BIT TOO
+    cmatrix<cbool> b_3(2, 40, false);
+    cmatrix_bits::reference bit = b_3.cell(1, 5);
+    cmatrix<cbool> b_4 = b_3;
+    bit = true;
+    EXPECT_TRUE(b_3.cell(1, 5));
+    EXPECT_EQ(b_4, cmatrix<cbool>(2, 40, false));
+}
+
+/** Test the csr_matrix class */
+TEST(MatrixTest, sparse)
+{
+    cmatrix<int> m = {{0, 2, 0, 0}, {0, 0, 0, 0}, {3, 0, -1, 0}};
+    csr_matrix<int> s(m);
+
+    // CONVERSION
+    EXPECT_EQ(s.size(), (std::pair<size_t, size_t>(3, 4)));
+    EXPECT_EQ(s.nnz(), size_t(3));
+    EXPECT_EQ(s.row_ptr(), std::vector<size_t>({0, 1, 1, 3}));
+    EXPECT_EQ(s.col_ids(), std::vector<size_t>({1, 0, 2}));
+    EXPECT_EQ(s.to_cmatrix(), m);
+    EXPECT_EQ(s.cell(2, 2), -1);
+    EXPECT_EQ(s.cell(1, 3), 0);
+    EXPECT_THROW(s.cell(3, 0), std::out_of_range);
+
+    // COORDINATE FORMAT - UNSORTED AND DUPLICATED CELLS
+    csr_matrix<int> s_2 = csr_matrix<int>::from_coo(3, 4, {2, 0, 2, 2}, {2, 1, 0, 2}, {-3, 2, 3, 2});
+    EXPECT_EQ(s_2.to_cmatrix(), m);
+    EXPECT_EQ(s_2.nnz(), size_t(3));
+    EXPECT_THROW(csr_matrix<int>::from_coo(3, 4, {0}, {4}, {1}), std::out_of_range);
+    EXPECT_THROW(csr_matrix<int>::from_coo(3, 4, {0}, {1, 2}, {1}), std::invalid_argument);
+
+    // PRODUCTS
+    cmatrix<int> d = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+    EXPECT_EQ(s.matmul(d), m.matmul(d));
+    EXPECT_EQ(s.matvec({1, 2, 3, 4}), std::vector<int>({4, 0, 0}));
+    EXPECT_THROW(s.matmul(m), std::invalid_argument);
+    EXPECT_THROW(s.matvec({1, 2}), std::invalid_argument);
+
+    // TRANSPOSE
+    EXPECT_EQ(s.transpose().to_cmatrix(), m.transpose());
+    EXPECT_EQ(s.transpose().transpose().col_ids(), s.col_ids());
+
+    // OPERATORS WITH A VALUE
+    EXPECT_EQ((s * 2).to_cmatrix(), m * 2);
+    EXPECT_EQ((s * 2 / 2).to_cmatrix(), m);
+    EXPECT_EQ(s + 1, m + 1);
+    EXPECT_EQ(s - 1, m - 1);
+    EXPECT_THROW(s / 0, std::invalid_argument);
+
+    // REDUCTIONS
+    EXPECT_EQ(s.sum(0), m.sum(0));
+    EXPECT_EQ(s.sum(1), m.sum(1));
+    EXPECT_EQ(s.max(0), m.max(0));
+    EXPECT_EQ(s.max(1), m.max(1));
+    EXPECT_EQ((s * -1).max(0), cmatrix<int>(m * -1).max(0));
+    EXPECT_EQ((s * -1).max(1), cmatrix<int>(m * -1).max(1));
+    EXPECT_THROW(s.sum(2), std::invalid_argument);
+    EXPECT_THROW(s.max(2), std::invalid_argument);
+}
+
 /** Test width method of cmatrix class */
 TEST(MatrixTest, width)
 {
@@ -444,6 +764,129 @@ TEST(MatrixTest, transpose)
     // EMPTY MATRIX
     cmatrix<std::string> m_7;
     EXPECT_EQ(m_7.transpose(), cmatrix<std::string>());
+
+    // THE TRANSPOSE SHARES THE BUFFER, IN THE OTHER LAYOUT
+    const cmatrix<int> m_8 = cmatrix<int>::randint(20, 30, 0, 9, 1);
+    const cmatrix<int, cmatrix_layout::col_major> m_9 = m_8.transpose();
+    EXPECT_EQ(m_9.data(), m_8.data());
+    EXPECT_EQ(m_9.height(), 30);
+    EXPECT_EQ(m_9.cell(4, 7), m_8.cell(7, 4));
+    const cmatrix<int> m_9_t = m_9.transpose();
+    EXPECT_EQ(m_9_t.data(), m_8.data());
+    EXPECT_EQ(m_9_t, m_8);
+
+    // MODIFYING THE TRANSPOSE COPIES THE BUFFER
+    cmatrix<int, cmatrix_layout::col_major> m_9_bis = m_8.transpose();
+    m_9_bis.cell(4, 7) = 10;
+    EXPECT_NE(m_9_bis.data(), m_8.data());
+    EXPECT_NE(m_8.cell(7, 4), 10);
+
+    // ASSIGNING THE TRANSPOSE TO THE SAME LAYOUT COPIES THE CELLS
+    cmatrix<int> m_10 = m_1.transpose();
+    EXPECT_EQ(m_10, m_2);
+    EXPECT_TRUE(cmatrix<int>({{1, 2}, {2, 1}}).is_symetric());
+    EXPECT_FALSE(m_1.is_symetric());
+
+    // CBOOL MATRIX
+    cmatrix<cbool> m_11 = {{true, false, true}};
+    EXPECT_EQ(m_11.transpose(), cmatrix<cbool>({{true}, {false}, {true}}));
+}
+
+/** Check the transposition engine against the cells, for a type and dimensions */
+template <class T>
+void check_transpose(const size_t &height, const size_t &width)
+{
+    cmatrix<T> m(height, width);
+    cmatrix<T> sq(width, width);
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+            m.cell(r, c) = T((r * 7 + c * 3) % 11);
+
+    for (size_t r = 0; r < width; r++)
+        for (size_t c = 0; c < width; c++)
+            sq.cell(r, c) = T((r * 5 + c) % 13);
+
+    cmatrix<T> t(width, height);
+    m.transpose_into(t);
+    const cmatrix<T, cmatrix_layout::col_major> col = m;
+    cmatrix<T> inplace = sq;
+    inplace.transpose_inplace();
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+        {
+            EXPECT_EQ(t.cell(c, r), m.cell(r, c));
+            EXPECT_EQ(col.cell(r, c), m.cell(r, c));
+        }
+
+    for (size_t r = 0; r < width; r++)
+        for (size_t c = 0; c < width; c++)
+            EXPECT_EQ(inplace.cell(c, r), sq.cell(r, c));
+}
+
+/** Test transpose_inplace method, and the transposition engine for each instruction set */
+TEST(MatrixTest, transpose_inplace)
+{
+    // 3x3 MATRIX
+    cmatrix<int> m_1 = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    m_1.transpose_inplace();
+    EXPECT_EQ(m_1, cmatrix<int>({{1, 4, 7}, {2, 5, 8}, {3, 6, 9}}));
+
+    // THE COPIES ARE NOT TRANSPOSED
+    cmatrix<int> m_2 = cmatrix<int>::randint(40, 40, 0, 9, 1);
+    const cmatrix<int> m_3 = m_2;
+    m_2.transpose_inplace();
+    EXPECT_EQ(m_2, m_3.transpose());
+    EXPECT_NE(m_2, m_3);
+
+    // COLUMN-MAJOR MATRIX
+    cmatrix<int, cmatrix_layout::col_major> m_4 = m_3;
+    m_4.transpose_inplace();
+    EXPECT_EQ(m_4, m_2);
+
+    // NOT SQUARE AND EMPTY MATRICES
+    cmatrix<int> m_5 = {{1, 2, 3}};
+    EXPECT_THROW(m_5.transpose_inplace(), std::invalid_argument);
+    cmatrix<std::string> m_6;
+    EXPECT_NO_THROW(m_6.transpose_inplace());
+
+    // EACH INSTRUCTION SET - TILES, REMAINING CELLS AND RECURSIVE SPLITS
+    const cmatrix_simd::isa detected = cmatrix_simd::level();
+
+    for (int level = cmatrix_simd::SCALAR; level <= detected; level++)
+    {
+        cmatrix_simd::set_level(cmatrix_simd::isa(level));
+
+        check_transpose<float>(7, 13);
+        check_transpose<float>(301, 157);
+        check_transpose<double>(70, 45);
+        check_transpose<std::int32_t>(45, 70);
+        check_transpose<std::int64_t>(19, 9);
+        check_transpose<short>(33, 35);
+    }
+
+    cmatrix_simd::set_level(detected);
+
+    // CBOOL MATRICES - BIT-PACKED CELLS
+    const cmatrix<cbool> m_7 = cmatrix<int>::randint(70, 67, 0, 1, 3) > 0;
+    cmatrix<cbool> m_8(67, 70);
+    m_7.transpose_into(m_8);
+    cmatrix<cbool> m_9 = cmatrix<int>::randint(70, 70, 0, 1, 4) > 0;
+    const cmatrix<cbool> m_10 = m_9;
+    m_9.transpose_inplace();
+
+    for (size_t r = 0; r < 70; r++)
+        for (size_t c = 0; c < 67; c++)
+        {
+            EXPECT_EQ(m_8.cell(c, r), m_7.cell(r, c));
+            EXPECT_EQ(m_9.cell(c, r), m_10.cell(r, c));
+        }
+
+    // STRING MATRICES
+    cmatrix<std::string> m_11 = {{"a", "b"}, {"c", "d"}};
+    m_11.transpose_inplace();
+    EXPECT_EQ(m_11, cmatrix<std::string>({{"a", "c"}, {"b", "d"}}));
 }
 
 /** Test diag method of cmatrix class */
@@ -1012,6 +1455,112 @@ TEST(MatrixTest, lt)
     EXPECT_THROW(m.lt(cmatrix<int>(2, 2, 1)), std::invalid_argument);
 }
 
+template <class T>
+void check_mask_bits(const size_t &height, const size_t &width)
+{
+    cmatrix<T> m_1(height, width);
+    cmatrix<T> m_2(height, width);
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+        {
+            m_1.set_cell(r, c, T((r * width + c) % 5));
+            m_2.set_cell(r, c, T((r + 2 * c) % 7));
+        }
+
+    const cmatrix<cbool> eq = m_1.eq(m_2), neq = m_1.neq(m_2), lt = m_1.lt(m_2), gt_val = m_1.gt(T(2)), leq_val = m_1.leq(T(2));
+    size_t count = 0;
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+        {
+            const T a = m_1.cell(r, c), b = m_2.cell(r, c);
+            EXPECT_EQ(bool(eq.cell(r, c)), a == b);
+            EXPECT_EQ(bool(neq.cell(r, c)), a != b);
+            EXPECT_EQ(bool(lt.cell(r, c)), a < b);
+            EXPECT_EQ(bool(gt_val.cell(r, c)), a > T(2));
+            EXPECT_EQ(bool(leq_val.cell(r, c)), a <= T(2));
+            count += a > T(2);
+        }
+
+    // WORD OPERATIONS ON THE MASK
+    EXPECT_EQ(gt_val.not_(), leq_val);
+    EXPECT_EQ(m_1.get(gt_val).width(), count);
+    EXPECT_EQ(m_1.find_all(gt_val).size(), count);
+    EXPECT_EQ(m_1.get(gt_val), m_1.get(gt_val.not_().not_()));
+}
+
+/** Test the bit-packed storage of the boolean matrices */
+TEST(MatrixTest, mask_bits)
+{
+    const cmatrix_simd::isa detected = cmatrix_simd::level();
+
+    for (int level = cmatrix_simd::SCALAR; level <= detected; level++)
+    {
+        cmatrix_simd::set_level(cmatrix_simd::isa(level));
+
+        // SMALL MATRICES - LAST WORD INCOMPLETE
+        check_mask_bits<float>(7, 13);
+        check_mask_bits<double>(7, 13);
+        check_mask_bits<std::int32_t>(7, 13);
+        check_mask_bits<std::int64_t>(7, 13);
+
+        // LARGE MATRICES - SEVERAL CHUNKS
+        check_mask_bits<float>(131, 129);
+        check_mask_bits<std::int64_t>(131, 129);
+
+        // OTHER TYPES - SCALAR KERNELS
+        check_mask_bits<short>(9, 11);
+    }
+
+    cmatrix_simd::set_level(detected);
+
+    // LOGICAL OPERATORS
+    cmatrix<cbool> m_1 = {{1, 0, 1, 0}, {1, 1, 0, 0}};
+    cmatrix<cbool> m_2 = {{1, 1, 0, 0}, {0, 1, 0, 1}};
+    EXPECT_EQ(m_1 + m_2, cmatrix<cbool>({{1, 1, 1, 0}, {1, 1, 0, 1}}));
+    EXPECT_EQ(m_1 * m_2, cmatrix<cbool>({{1, 0, 0, 0}, {0, 1, 0, 0}}));
+    EXPECT_EQ(m_1 - m_2, cmatrix<cbool>({{0, 1, 1, 0}, {1, 0, 0, 1}}));
+    EXPECT_EQ(m_1 + cbool(1), cmatrix<cbool>(2, 4, 1));
+    EXPECT_EQ(m_1.lt(m_2), cmatrix<cbool>({{0, 1, 0, 0}, {0, 0, 0, 1}}));
+    EXPECT_EQ(m_1.eq(cbool(0)), m_1.not_());
+    EXPECT_EQ(m_1.sum_all().value(), 4);
+    EXPECT_EQ(m_1.sum_all(cbool(1)).value(), 5);
+    EXPECT_EQ(cmatrix<cbool>(2, 4, 0).sum_all().value(), 0);
+    EXPECT_EQ(cmatrix<cbool>(9, 13, 1).sum_all().value(), 117);
+    EXPECT_EQ(cmatrix<cbool>(20, 20, 1).sum_all().value(), static_cast<char>(400));
+
+    // SHIFT THE CELLS ACROSS THE WORDS
+    cmatrix<cbool> m_3(40, 3, 0);
+    m_3.cell(39, 2) = 1;
+    m_3.insert_row(0, {1, 0, 1});
+    std::vector<std::pair<size_t, size_t>> ids = {{0, 0}, {0, 2}, {40, 2}};
+    EXPECT_EQ(m_3.find_all(m_3), ids);
+    m_3.remove_row(0);
+    ids = {{39, 2}};
+    EXPECT_EQ(m_3.find_all(m_3), ids);
+    m_3.insert_column(1, std::vector<cbool>(40, 1));
+    EXPECT_EQ(m_3.get(m_3).width(), size_t(41));
+    EXPECT_EQ(m_3.cell(39, 3), 1);
+
+    // SLICE THE CELLS ACROSS THE WORDS - A COPY INSTEAD OF A VIEW
+    EXPECT_TRUE((std::is_same<decltype(m_3.slice_rows(0, 0)), cmatrix<cbool>>::value));
+    EXPECT_EQ(m_3.slice_rows(38, 39), cmatrix<cbool>({{0, 1, 0, 0}, {0, 1, 0, 1}}));
+    cmatrix<cbool> m_4 = m_3.slice_rows(20, 39);
+    EXPECT_EQ(m_4.height(), size_t(20));
+    EXPECT_EQ(m_4.sum_all().value(), 21);
+    EXPECT_EQ(m_4.cell(19, 3), 1);
+    cmatrix<cbool> m_5(40, 2, 0);
+    m_5.cell(39, 1) = 1;
+    EXPECT_EQ(m_3.slice_columns(2, 3), m_5);
+    EXPECT_EQ(m_3.slice_columns(1, 1), cmatrix<cbool>(40, 1, 1));
+    EXPECT_EQ(cmatrix<cbool>(m_3).slice_columns(3, 3), m_5.slice_columns(1, 1));
+    EXPECT_THROW(m_3.slice_rows(0, 40), std::out_of_range);
+    EXPECT_THROW(m_3.slice_columns(4, 4), std::out_of_range);
+    EXPECT_THROW(m_3.slice_rows(2, 1), std::invalid_argument);
+    EXPECT_THROW(m_3.slice_columns(2, 1), std::invalid_argument);
+}
+
 /** Test remove_row method of cmatrix class */
 TEST(MatrixTest, remove_row)
 {
@@ -1771,6 +2320,56 @@ TEST(MatrixTest, map)
     EXPECT_EQ(m_9, expected3.cast<float>());
 }
 
+/** A function object, to pass to the methods taking a callable */
+struct square
+{
+    int operator()(int x) const { return x * x; }
+};
+
+/** A function, to pass to the methods taking a callable */
+bool is_even(int x)
+{
+    return x % 2 == 0;
+}
+
+/** Test the methods of cmatrix class taking any callable */
+TEST(MatrixTest, callables)
+{
+    cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+
+    // FUNCTION OBJECT
+    EXPECT_EQ(m.map(square()), cmatrix<int>({{1, 4, 9}, {16, 25, 36}}));
+    EXPECT_EQ(m.map<float>(square()), cmatrix<float>({{1, 4, 9}, {16, 25, 36}}));
+
+    // FUNCTION POINTER
+    EXPECT_EQ(m.mask(is_even), cmatrix<cbool>({{false, true, false}, {true, false, true}}));
+    EXPECT_EQ(m.find(is_even), std::make_pair(0, 1));
+    EXPECT_EQ(m.find_all(&is_even).size(), 3);
+    EXPECT_TRUE(m.any(is_even));
+    EXPECT_FALSE(m.all(is_even));
+
+    // STATEFUL LAMBDA
+    int calls = 0;
+    cmatrix<int> m_2 = m;
+    m_2.apply([&calls](int x, size_t r, size_t c)
+              { calls++; return x + int(r * 10 + c); });
+    EXPECT_EQ(calls, 6);
+    EXPECT_EQ(m_2, cmatrix<int>({{1, 3, 5}, {14, 16, 18}}));
+    EXPECT_EQ(m.mask([](int a, int b) { return a < b; }, m_2), cmatrix<cbool>({{false, true, true}, {true, true, true}}));
+
+    // STD::FUNCTION
+    std::function<int(int)> f = [](int x) { return -x; };
+    const std::function<int(int)> &c_f = f;
+    EXPECT_EQ(m.map(f), m * -1);
+    EXPECT_EQ(m.map(c_f), m * -1);
+    m_2.apply(c_f);
+    EXPECT_EQ(m_2, cmatrix<int>({{-1, -3, -5}, {-14, -16, -18}}));
+
+    // VALUES ARE NOT CALLABLES
+    EXPECT_TRUE(m.any(5));
+    EXPECT_EQ(m.find(6), std::make_pair(1, 2));
+}
+
 /** Test fill method of cmatrix class */
 TEST(MatrixTest, fill)
 {
@@ -2188,6 +2787,30 @@ TEST(MatrixTest, mat_mul)
     cmatrix<int> m_13 = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
     cmatrix<int> m_14 = {{6, 5, 4}, {3, 2, 1}};
     EXPECT_THROW(m_13.matmul(m_14), std::invalid_argument);
+
+    // LARGE MATRICES - BLOCKED PRODUCT WITH PARTIAL TILES
+    cmatrix<int> m_15 = cmatrix<int>::randint(157, 301, -10, 20, 1);
+    cmatrix<int> m_16 = cmatrix<int>::randint(301, 45, -10, 20, 2);
+    cmatrix<int> m_17(157, 45);
+    for (size_t i = 0; i < m_17.height(); i++)
+        for (size_t j = 0; j < m_17.width(); j++)
+            for (size_t k = 0; k < m_15.width(); k++)
+                m_17.cell(i, j) += m_15.cell(i, k) * m_16.cell(k, j);
+    EXPECT_EQ(m_15.matmul(m_16), m_17);
+
+    cmatrix<double> m_18(m_15);
+    cmatrix<double> m_19(m_16);
+    EXPECT_TRUE(m_18.matmul(m_19).near(cmatrix<double>(m_17)));
+
+    // TRANSPOSED OPERANDS - NOT COPIED
+    cmatrix<int> m_20 = m_15.transpose();
+    cmatrix<int> m_21 = m_16.transpose();
+    EXPECT_EQ(m_20.transpose().matmul(m_16), m_17);
+    EXPECT_EQ(m_15.matmul(m_21.transpose()), m_17);
+    EXPECT_EQ(m_20.transpose().matmul(m_21.transpose()), m_17);
+    EXPECT_EQ(m_1.matmul(m_2.transpose()), m_1.matmul(cmatrix<int>(m_2.transpose())));
+    EXPECT_EQ(m_1.transpose().matmul(m_2), cmatrix<int>(m_1.transpose()).matmul(m_2));
+    EXPECT_EQ(m_4.transpose().matmul(m_8), cmatrix<int>({{25, 35, 45}, {35, 49, 63}, {45, 63, 81}}));
 }
 
 /** Test matpow method of cmatrix class */
@@ -2210,6 +2833,820 @@ TEST(MatrixTest, matpow)
     cmatrix<int> m_7;
     cmatrix<int> m_8;
     EXPECT_EQ(m_7.matpow(2), m_8);
+
+    // ODD AND EVEN POWERS - PRODUCTS, NOT ELEMENTWISE POWERS
+    cmatrix<int> m_9 = cmatrix<int>::randint(5, 5, -2, 2, 1);
+    cmatrix<int> m_10 = cmatrix<int>::identity(5);
+    EXPECT_EQ(m_9.matpow(0), m_10);
+    EXPECT_EQ(m_9.matpow(1), m_9);
+
+    for (unsigned int n = 1; n <= 9; n++)
+    {
+        m_10 = m_10.matmul(m_9);
+        EXPECT_EQ(m_9.matpow(n), m_10);
+    }
+
+    // LARGE POWER - STEADY STATE OF A MARKOV CHAIN
+    cmatrix<double> m_11 = {{0.9, 0.1}, {0.5, 0.5}};
+    cmatrix<double> m_12 = m_11.matpow(1000);
+    EXPECT_NEAR(m_12.cell(0, 0), 5. / 6, 1e-9);
+    EXPECT_NEAR(m_12.cell(1, 1), 1. / 6, 1e-9);
+
+    cmatrix<double> m_13 = cmatrix<float>::randfloat(40, 40, 0, 1, 2);
+    m_13 /= m_13.sum(0).matmul(cmatrix<double>(1, 40, 1));
+    EXPECT_TRUE(m_13.matpow(1025).sum(0).near(cmatrix<double>(40, 1, 1)));
+
+    // THE LOOP DOESN'T ALLOCATE - THREE BUFFERS FOR ANY POWER
+    size_t three;
+    {
+        cmatrix_arena scope;
+        cmatrix<double> a(40, 40), b(40, 40), c(40, 40);
+        three = scope.used();
+    }
+    {
+        cmatrix_arena scope;
+        cmatrix<double> m_14 = m_13.matpow(1025);
+        EXPECT_EQ(scope.used(), three);
+    }
+}
+
+/** Test the methods writing their result in a given matrix */
+TEST(MatrixTest, into)
+{
+    // MATMUL - THE BUFFER OF THE OUTPUT IS REUSED
+    cmatrix<int> a = cmatrix<int>::randint(40, 50, -9, 9, 1);
+    cmatrix<int> b = cmatrix<int>::randint(50, 30, -9, 9, 2);
+    cmatrix<int> out(40, 30, 7);
+    const int *buffer = out.data();
+    a.matmul_into(out, b);
+    EXPECT_EQ(out, a.matmul(b));
+    a.matmul_into(out, b.view());
+    EXPECT_EQ(out, a.matmul(b));
+    EXPECT_EQ(out.data(), buffer);
+
+    // MATMUL - WRONG DIMENSIONS OR ALIASED OPERANDS
+    cmatrix<int> sq = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    cmatrix<int> wrong(30, 40);
+    EXPECT_THROW(a.matmul_into(wrong, b), std::invalid_argument);
+    EXPECT_THROW(sq.matmul_into(sq, sq), std::invalid_argument);
+    EXPECT_THROW(sq.matmul_into(sq, sq.view()), std::invalid_argument);
+
+    // MATMUL - AN OUTPUT SHARING ITS BUFFER IS COPIED
+    cmatrix<int> shared = sq;
+    sq.matmul_into(shared, sq);
+    EXPECT_EQ(shared, cmatrix<int>({{30, 36, 42}, {66, 81, 96}, {102, 126, 150}}));
+    EXPECT_EQ(sq, cmatrix<int>({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}));
+
+    // TRANSPOSE
+    cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> t(3, 2);
+    m.transpose_into(t);
+    EXPECT_EQ(t, cmatrix<int>({{1, 4}, {2, 5}, {3, 6}}));
+    EXPECT_THROW(m.transpose_into(m), std::invalid_argument);
+    EXPECT_THROW(t.transpose_into(t), std::invalid_argument);
+
+    // MAP
+    cmatrix<float> f(2, 3);
+    m.map_into(f, [](int x)
+               { return x + 0.5f; });
+    EXPECT_EQ(f, cmatrix<float>({{1.5, 2.5, 3.5}, {4.5, 5.5, 6.5}}));
+    m.map_into(f, [](int x, size_t r, size_t c)
+               { return float(x * r + c); });
+    EXPECT_EQ(f, cmatrix<float>({{0, 1, 2}, {4, 6, 8}}));
+    EXPECT_THROW(m.map_into(t, [](int x)
+                            { return x; }),
+                 std::invalid_argument);
+
+    // MAP - IN PLACE
+    const int *cells = m.data();
+    m.map_into(m, [](int x)
+               { return x * 2; });
+    EXPECT_EQ(m, cmatrix<int>({{2, 4, 6}, {8, 10, 12}}));
+    EXPECT_EQ(m.data(), cells);
+
+    // SUM
+    cmatrix<int> rows(2, 1);
+    cmatrix<int> cols(1, 3);
+    m.sum_into(rows, 0);
+    m.sum_into(cols, 1);
+    EXPECT_EQ(rows, cmatrix<int>({{12}, {30}}));
+    EXPECT_EQ(cols, cmatrix<int>({{10, 14, 18}}));
+    EXPECT_THROW(m.sum_into(cols, 0), std::invalid_argument);
+    EXPECT_THROW(m.sum_into(rows, 2), std::invalid_argument);
+
+    // MEAN
+    cmatrix<float> means(2, 1);
+    m.mean_into(means, 0);
+    EXPECT_EQ(means, cmatrix<float>({{4}, {10}}));
+    EXPECT_THROW(m.mean_into(means, 1), std::invalid_argument);
+
+    // MASK
+    cmatrix<cbool> mask(2, 3);
+    m.mask_into(mask, [](int x)
+                { return x > 5; });
+    EXPECT_EQ(mask, cmatrix<cbool>({{0, 0, 1}, {1, 1, 1}}));
+    m.mask_into(
+        mask, [](int x, int y)
+        { return x == y; },
+        cmatrix<int>({{2, 0, 6}, {0, 10, 0}}));
+    EXPECT_EQ(mask, cmatrix<cbool>({{1, 0, 1}, {0, 1, 0}}));
+    cmatrix<cbool> mask_t(3, 2);
+    EXPECT_THROW(m.mask_into(mask_t, [](int x)
+                             { return x > 5; }),
+                 std::invalid_argument);
+}
+
+/** Test the matrices storing their cells in the object */
+TEST(MatrixTest, inline_storage)
+{
+    if (CMATRIX_INLINE_SIZE == 0)
+        GTEST_SKIP() << "The inline storage is disabled.";
+
+    // THE CELLS OF A SMALL MATRIX ARE IN THE OBJECT
+    cmatrix<int> m = {{1, 2}, {3, 4}};
+    const char *begin = reinterpret_cast<const char *>(&m);
+    const char *cells = reinterpret_cast<const char *>(m.data());
+    EXPECT_TRUE(cells >= begin and cells < begin + sizeof(m));
+
+    // COPIES AND MOVES COPY THE CELLS
+    cmatrix<int> m_2 = m;
+    EXPECT_NE(m_2.data(), m.data());
+    m_2.set_cell(0, 0, 5);
+    EXPECT_EQ(m, cmatrix<int>({{1, 2}, {3, 4}}));
+    cmatrix<int> m_3 = std::move(m_2);
+    EXPECT_EQ(m_3, cmatrix<int>({{5, 2}, {3, 4}}));
+    EXPECT_TRUE(m_2.is_empty());
+
+    // A MATRIX GROWING OVER THE LIMIT MOVES TO THE HEAP, AND BACK WHEN IT SHRINKS
+    cmatrix<int> g(1, CMATRIX_INLINE_SIZE, 1);
+    g.insert_row(1, std::vector<int>(CMATRIX_INLINE_SIZE, 2));
+    EXPECT_EQ(g.sum_all(), 3 * CMATRIX_INLINE_SIZE);
+    cells = reinterpret_cast<const char *>(g.data());
+    begin = reinterpret_cast<const char *>(&g);
+    EXPECT_FALSE(cells >= begin and cells < begin + sizeof(g));
+    g.remove_row(0);
+    EXPECT_EQ(g, cmatrix<int>(1, CMATRIX_INLINE_SIZE, 2));
+    cells = reinterpret_cast<const char *>(g.data());
+    EXPECT_TRUE(cells >= begin and cells < begin + sizeof(g));
+
+    // THE REDUCTIONS OF A ROW OR A COLUMN
+    cmatrix<int> r = cmatrix<int>::randint(100, 8, 0, 9, 1);
+    cmatrix<int> sum = r.sum(1);
+    EXPECT_EQ(sum.width(), 8);
+    EXPECT_EQ(sum.sum_all(), r.sum_all());
+    cells = reinterpret_cast<const char *>(sum.data());
+    begin = reinterpret_cast<const char *>(&sum);
+    EXPECT_TRUE(cells >= begin and cells < begin + sizeof(sum));
+
+    // THE OTHER TYPES USE THE SHARED BUFFER
+    cmatrix<std::string> s = {{"a", "b"}};
+    cmatrix<std::string> s_2 = s;
+    EXPECT_EQ(s_2.cell(0, 1), "b");
+}
+
+/** Test the matrices allocated in an arena */
+TEST(MatrixTest, arena)
+{
+    cmatrix<int> outside(10, 10, 1);
+    cmatrix<int> shared(10, 10, 1);
+    cmatrix<int> shared_copy = shared;
+    cmatrix<int> assigned(10, 10, 0), copied(10, 10, 0);
+    EXPECT_EQ(cmatrix_arena::current(), nullptr);
+
+    {
+        // THE MATRICES CREATED IN THE SCOPE DRAW FROM THE ARENA
+        cmatrix_arena scope(1 << 12);
+        EXPECT_EQ(cmatrix_arena::current(), &scope);
+
+        cmatrix<int> m(10, 10, 2);
+        EXPECT_GE(scope.used(), 100 * sizeof(int));
+        EXPECT_EQ(scope.blocks(), 1);
+
+        cmatrix<int> sum = m + outside;
+        cmatrix<int> r = sum.matmul(m) - outside;
+        EXPECT_EQ(r, cmatrix<int>(10, 10, 59));
+        cmatrix<cbool> mask = r > 0;
+        EXPECT_EQ(mask.sum_all().value(), 100);
+
+        // A BUFFER BIGGER THAN THE BLOCKS GETS ITS OWN BLOCK
+        cmatrix<double> big(100, 100, 1);
+        EXPECT_EQ(big.sum_all(), 10000);
+        EXPECT_GE(scope.blocks(), 2);
+
+        // THE SCOPES CAN BE NESTED
+        {
+            cmatrix_arena inner;
+            cmatrix<int> copy = m.copy();
+            copy.set_cell(0, 0, 0);
+            EXPECT_EQ(cmatrix_arena::current(), &inner);
+            EXPECT_GT(inner.used(), 0);
+        }
+        EXPECT_EQ(cmatrix_arena::current(), &scope);
+
+        // THE MATRICES CREATED BEFORE THE SCOPE ARE STILL USABLE
+        outside.set_cell(0, 0, 5);
+
+        // A SHARED MATRIX CREATED BEFORE THE SCOPE COPIES ITS BUFFER IN THE HEAP
+        const size_t used = scope.used();
+        shared.set_cell(0, 0, 7);
+        EXPECT_EQ(scope.used(), used);
+
+        // A MATRIX CREATED BEFORE THE SCOPE COPIES THE BUFFERS OF THE ARENA ASSIGNED TO IT
+        assigned = m.matmul(m);
+        copied = m;
+        EXPECT_EQ(assigned, cmatrix<int>(10, 10, 40));
+    }
+
+    EXPECT_EQ(cmatrix_arena::current(), nullptr);
+    EXPECT_EQ(outside.sum_all(), 104);
+    EXPECT_EQ(shared.sum_all(), 106);
+    EXPECT_EQ(shared_copy.sum_all(), 100);
+    EXPECT_EQ(assigned.sum_all(), 4000);
+    EXPECT_EQ(copied.sum_all(), 200);
+
+    // THE BIT-PACKED MATRICES TOO
+    cmatrix<cbool> mask_outside;
+
+    {
+        cmatrix_arena scope;
+        mask_outside = cmatrix<int>(10, 10, 1) > 0;
+    }
+
+    EXPECT_EQ(mask_outside.all(cbool(true)), true);
+}
+
+/** A resource counting the buffers it allocates */
+struct counting_resource : cmatrix_alloc::resource
+{
+    std::atomic<size_t> allocated{0};
+    std::atomic<size_t> released{0};
+    std::atomic<size_t> bytes{0};
+
+    void *allocate(const size_t &n)
+    {
+        allocated++;
+        bytes += n;
+        return ::operator new(n);
+    }
+
+    void deallocate(void *p, const size_t &n)
+    {
+        released++;
+        bytes -= n;
+        ::operator delete(p);
+    }
+};
+
+/** Test the resource of the buffers allocated outside of an arena */
+TEST(MatrixTest, resource)
+{
+    counting_resource memory;
+    cmatrix_alloc::resource *heap = cmatrix_alloc::set_resource(&memory);
+    EXPECT_EQ(cmatrix_alloc::get_resource(), &memory);
+
+    {
+        // THE BUFFERS ARE ALLOCATED FROM THE RESOURCE, AND RELEASED WITH THE SIZE THEY WERE ALLOCATED WITH
+        cmatrix<double> m(20, 20, 1.5);
+        cmatrix<double> r = m.matmul(m) + m;
+        cmatrix<cbool> mask = r > 0;
+        EXPECT_EQ(r, cmatrix<double>(20, 20, 46.5));
+        EXPECT_TRUE(mask.all(cbool(true)));
+        EXPECT_GE(memory.allocated.load(), 3);
+        EXPECT_GE(memory.bytes.load(), 2 * 400 * sizeof(double));
+
+        // THE ARENAS DON'T DRAW FROM THE RESOURCE
+        const size_t allocated = memory.allocated.load();
+        {
+            cmatrix_arena scope;
+            cmatrix<double> t = r * 2;
+            EXPECT_EQ(t.sum_all(), 400 * 93);
+        }
+        EXPECT_EQ(memory.allocated.load(), allocated);
+
+        // A BUFFER GOES BACK TO THE RESOURCE THAT ALLOCATED IT
+        EXPECT_EQ(cmatrix_alloc::set_resource(nullptr), &memory);
+        EXPECT_EQ(cmatrix_alloc::get_resource(), heap);
+        cmatrix<double> c = r * 2;
+        EXPECT_EQ(memory.allocated.load(), allocated);
+    }
+
+    EXPECT_EQ(memory.released.load(), memory.allocated.load());
+    EXPECT_EQ(memory.bytes.load(), 0);
+}
+
+/** Test the cost model deciding the number of threads of the operations */
+TEST(MatrixTest, parallel)
+{
+    const size_t elementwise = cmatrix_parallel::threshold(cmatrix_parallel::ELEMENTWISE);
+    const size_t callable = cmatrix_parallel::threshold(cmatrix_parallel::CALLABLE);
+    EXPECT_EQ(elementwise, cmatrix_parallel::DEFAULT_THRESHOLDS[cmatrix_parallel::ELEMENTWISE]);
+
+    // THE WORK UNDER THE THRESHOLD RUNS ON THE CALLING THREAD
+    EXPECT_EQ(cmatrix_parallel::team(cmatrix_parallel::ELEMENTWISE, 9), 1);
+    EXPECT_EQ(cmatrix_parallel::team(cmatrix_parallel::ELEMENTWISE, 0), 1);
+    EXPECT_LE(cmatrix_parallel::team(cmatrix_parallel::ELEMENTWISE, elementwise * 1000), cmatrix_parallel::threads());
+
+    // THE SMALL MATRICES DON'T FORK A TEAM
+    std::atomic<int> team(0);
+    cmatrix<int> m(3, 3, 1);
+    m.apply([&team](int x) { team = std::max(team.load(), omp_get_num_threads()); return x + 1; });
+    EXPECT_EQ(team, 1);
+    EXPECT_EQ(m, cmatrix<int>(3, 3, 2));
+
+    {
+        // A SCOPE SETS THE THRESHOLDS AND THE NUMBER OF THREADS OF THE CALLS OF THE THREAD
+        cmatrix_parallel::scope wide(4);
+        wide.set_threshold(cmatrix_parallel::CALLABLE, 0);
+        EXPECT_EQ(cmatrix_parallel::threads(), 4);
+        EXPECT_EQ(cmatrix_parallel::threshold(cmatrix_parallel::CALLABLE), 0);
+        EXPECT_EQ(cmatrix_parallel::threshold(cmatrix_parallel::ELEMENTWISE), elementwise);
+        EXPECT_EQ(cmatrix_parallel::team(cmatrix_parallel::CALLABLE, 9), 4);
+
+        m.apply([&team](int x) { team = std::max(team.load(), omp_get_num_threads()); return x + 1; });
+        EXPECT_GT(team, 1);
+        EXPECT_EQ(m, cmatrix<int>(3, 3, 3));
+
+        // THE SCOPES CAN BE NESTED
+        {
+            cmatrix_parallel::scope serial(1);
+            EXPECT_EQ(cmatrix_parallel::threads(), 1);
+            EXPECT_EQ(cmatrix_parallel::threshold(cmatrix_parallel::CALLABLE), 0);
+            EXPECT_EQ(cmatrix_parallel::team(cmatrix_parallel::CALLABLE, 1 << 20), 1);
+        }
+        EXPECT_EQ(cmatrix_parallel::threads(), 4);
+
+        // THE CALLS FROM A PARALLEL REGION RUN ON THEIR THREAD
+        int nested = 0;
+        #pragma omp parallel num_threads(2) reduction(max : nested)
+        nested = cmatrix_parallel::team(cmatrix_parallel::CALLABLE, 1 << 20);
+        EXPECT_EQ(nested, 1);
+    }
+
+    EXPECT_EQ(cmatrix_parallel::threshold(cmatrix_parallel::CALLABLE), callable);
+
+    // THE THRESHOLDS OF THE PROGRAM
+    cmatrix_parallel::set_threshold(cmatrix_parallel::ELEMENTWISE, 0);
+    cmatrix_parallel::set_threads(3);
+    EXPECT_EQ(cmatrix_parallel::team(cmatrix_parallel::ELEMENTWISE, 9), 3);
+
+    cmatrix<float> a = cmatrix<float>::randfloat(37, 41, 0, 1, 2);
+    cmatrix<float> b = cmatrix<float>::randfloat(37, 41, 0, 1, 3);
+    cmatrix<float> sum = a + b;
+
+    cmatrix_parallel::reset_thresholds();
+    cmatrix_parallel::set_threads(0);
+    EXPECT_EQ(cmatrix_parallel::threshold(cmatrix_parallel::ELEMENTWISE), elementwise);
+    EXPECT_EQ(cmatrix_parallel::threads(), omp_get_max_threads());
+
+    // THE RESULTS DON'T DEPEND ON THE NUMBER OF THREADS
+    EXPECT_EQ(sum, a + b);
+    EXPECT_EQ(sum.sum(1), cmatrix<float>(a + b).sum(1));
+}
+
+/** A pool running the tasks on the calling thread, counting the loops submitted to it */
+struct counting_pool : cmatrix_exec::pool
+{
+    size_t runs = 0;
+
+    size_t size() const { return 3; }
+
+    void run(const size_t &tasks, const std::function<void(size_t)> &task)
+    {
+        runs++;
+
+        for (size_t i = 0; i < tasks; i++)
+            task(i);
+    }
+};
+
+/** Test the execution backends of the parallel loops */
+TEST(MatrixTest, exec)
+{
+    EXPECT_EQ(cmatrix_exec::current().type, cmatrix_exec::OPENMP);
+
+    // THE POOL RUNS ALL THE TASKS, AND RETHROWS THEIR EXCEPTIONS
+    cmatrix_exec::worker_pool workers(4);
+    std::atomic<size_t> done(0);
+    EXPECT_EQ(workers.size(), 4);
+    workers.run(100, [&done](size_t i) { done += i; });
+    EXPECT_EQ(done, 4950);
+    EXPECT_THROW(workers.run(10, [](size_t i) { if (i == 7) throw std::runtime_error("task"); }), std::runtime_error);
+
+    cmatrix<double> a = cmatrix<float>::randfloat(300, 200, -1, 1, 4).cast<double>();
+    cmatrix<double> b = cmatrix<float>::randfloat(200, 250, -1, 1, 5).cast<double>();
+    cmatrix<double> product, sum, transposed;
+    std::vector<std::thread::id> ids;
+    std::mutex mutex;
+    int team = 0;
+
+    {
+        // THE LOOPS RUN ON THE THREADS OF THE POOL, WITHOUT OPENMP TEAM
+        cmatrix_exec::scope exec(cmatrix_exec::thread_pool(workers));
+        cmatrix_parallel::scope model;
+        model.set_threshold(cmatrix_parallel::CALLABLE, 0);
+        EXPECT_EQ(cmatrix_exec::current().workers, &workers);
+
+        cmatrix<int> m(64, 3, 1);
+        m.apply([&](int x)
+                { std::lock_guard<std::mutex> lock(mutex);
+                  ids.push_back(std::this_thread::get_id());
+                  team = std::max(team, omp_get_num_threads());
+                  return x + 1; });
+        EXPECT_EQ(m, cmatrix<int>(64, 3, 2));
+        EXPECT_EQ(team, 1);
+        EXPECT_GT(std::set<std::thread::id>(ids.begin(), ids.end()).size(), 1);
+
+        // THE LOOPS CALLED BY A TASK RUN ON ITS THREAD
+        std::atomic<int> nested(0);
+        cmatrix_exec::for_each(cmatrix_parallel::CALLABLE, 1 << 20, 8, [&nested](size_t)
+                               { nested = std::max(nested.load(), cmatrix_parallel::team(cmatrix_parallel::CALLABLE, 1 << 20)); });
+        EXPECT_EQ(nested, 1);
+
+        product = a.matmul(b);
+        sum = a + a;
+        transposed = cmatrix<float>::randfloat(1000, 700, 0, 1, 6).cast<double>();
+        EXPECT_EQ(transposed.transpose(), cmatrix<double>(transposed.transpose()));
+    }
+
+    EXPECT_EQ(cmatrix_exec::current().type, cmatrix_exec::OPENMP);
+
+    {
+        // THE SERIAL BACKEND RUNS THE LOOPS ON THE CALLING THREAD
+        cmatrix_exec::scope exec(cmatrix_exec::serial());
+        cmatrix_parallel::scope model;
+        model.set_threshold(cmatrix_parallel::CALLABLE, 0);
+
+        ids.clear();
+        cmatrix<int>(64, 3, 1).map([&](int x)
+                                   { std::lock_guard<std::mutex> lock(mutex);
+                                     ids.push_back(std::this_thread::get_id());
+                                     return x; });
+        EXPECT_EQ(std::set<std::thread::id>(ids.begin(), ids.end()), std::set<std::thread::id>({std::this_thread::get_id()}));
+
+        // THE RESULTS DON'T DEPEND ON THE BACKEND
+        EXPECT_EQ(product, a.matmul(b));
+        EXPECT_EQ(sum, a + a);
+    }
+
+    // THE POLICY OF THE PROGRAM ACCEPTS THE POOLS OF THE APPLICATION
+    counting_pool pool;
+    cmatrix_exec::set_policy(cmatrix_exec::thread_pool(pool));
+    cmatrix_parallel::set_threshold(cmatrix_parallel::REDUCTION, 0);
+    EXPECT_EQ(cmatrix<int>(8, 8, 1).sum(0), cmatrix<int>(8, 1, 8));
+    EXPECT_EQ(pool.runs, 1);
+
+    cmatrix_exec::set_policy(cmatrix_exec::openmp());
+    cmatrix_parallel::reset_thresholds();
+    EXPECT_EQ(product, a.matmul(b));
+}
+
+/** Sum the cells of the rows [first, last) of a matrix, spawning a task for the first half */
+static double sum_rows(const cmatrix<double> &m, const size_t &first, const size_t &last, std::atomic<int> &tasks)
+{
+    tasks++;
+
+    if (last - first <= 8)
+    {
+        double sum = 0;
+
+        for (size_t r = first; r < last; r++)
+            for (size_t c = 0; c < m.width(); c++)
+                sum += m.cell(r, c);
+
+        return sum;
+    }
+
+    const size_t half = (first + last) / 2;
+    double left = 0;
+    cmatrix_task::group g;
+    g.spawn([&]()
+            { left = sum_rows(m, first, half, tasks); });
+    const double right = sum_rows(m, half, last, tasks);
+    g.sync();
+
+    return left + right;
+}
+
+/** Test the work-stealing scheduler and the tasks */
+TEST(MatrixTest, task)
+{
+    cmatrix<double> m = cmatrix<int>::randint(200, 30, -9, 9, 7).cast<double>();
+    const double expected = m.sum_all();
+    std::atomic<int> tasks(0);
+
+    // OUTSIDE OF A SCHEDULER, THE TASKS RUN WHEN SPAWNED
+    EXPECT_EQ(sum_rows(m, 0, m.height(), tasks), expected);
+
+    cmatrix_task::scheduler scheduler(4);
+    EXPECT_EQ(scheduler.size(), 4);
+
+    {
+        // THE TASKS ARE STOLEN BY THE THREADS OF THE SCHEDULER
+        cmatrix_exec::scope exec(cmatrix_exec::thread_pool(scheduler));
+        std::vector<std::thread::id> ids;
+        std::mutex mutex;
+        double sum = 0;
+
+        cmatrix_task::run(cmatrix_parallel::REDUCTION, 1 << 30, [&]()
+                          {
+                              cmatrix_task::group g;
+
+                              for (size_t i = 0; i < 64; i++)
+                                  g.spawn([&]()
+                                          { std::lock_guard<std::mutex> lock(mutex);
+                                            ids.push_back(std::this_thread::get_id());
+                                            std::this_thread::sleep_for(std::chrono::microseconds(200)); });
+
+                              g.sync();
+                              sum = sum_rows(m, 0, m.height(), tasks); });
+        EXPECT_EQ(ids.size(), 64);
+        EXPECT_GT(std::set<std::thread::id>(ids.begin(), ids.end()).size(), 1);
+        EXPECT_EQ(sum, expected);
+
+        // THE EXCEPTIONS OF THE TASKS ARE RETHROWN BY SYNC
+        EXPECT_THROW(cmatrix_task::run(cmatrix_parallel::REDUCTION, 1 << 30, []()
+                                       {
+                                           cmatrix_task::group g;
+                                           g.spawn([]() { throw std::runtime_error("task"); });
+                                           g.sync(); }),
+                     std::runtime_error);
+
+        // THE SCHEDULER RUNS THE PARALLEL LOOPS, AND THE HALVES OF THE TRANSPOSITIONS
+        cmatrix_parallel::scope model;
+        model.set_threshold(cmatrix_parallel::TRANSPOSE, 0);
+        model.set_threshold(cmatrix_parallel::CALLABLE, 0);
+
+        cmatrix<int> n(64, 3, 1);
+        n.apply([](int x) { return x + 1; });
+        EXPECT_EQ(n, cmatrix<int>(64, 3, 2));
+
+        cmatrix<double> t = cmatrix<float>::randfloat(1000, 700, 0, 1, 8).cast<double>();
+        cmatrix<double, cmatrix_layout::col_major> converted(t);
+        cmatrix<double> transposed(700, 1000);
+        t.transpose_into(transposed);
+
+        for (size_t r = 0; r < t.height(); r += 37)
+            for (size_t c = 0; c < t.width(); c += 11)
+            {
+                EXPECT_EQ(converted.cell(r, c), t.cell(r, c));
+                EXPECT_EQ(transposed.cell(c, r), t.cell(r, c));
+            }
+
+        cmatrix<cbool> bits = cmatrix<int>::randint(300, 500, 0, 1, 9) > 0;
+        EXPECT_EQ(bits.transpose().transpose(), bits);
+        EXPECT_EQ(bits.transpose().cell(417, 123), bits.cell(123, 417));
+    }
+
+    // THE TASKS ARE OPENMP TASKS WITH THE OPENMP POLICY
+    double sum = 0;
+    cmatrix_task::run(cmatrix_parallel::REDUCTION, 1 << 30, [&]()
+                      { sum = sum_rows(m, 0, m.height(), tasks); });
+    EXPECT_EQ(sum, expected);
+    EXPECT_EQ(cmatrix<double>(cmatrix<double, cmatrix_layout::col_major>(m)), m);
+
+    // THE EXCEPTIONS LEAVE THE OPENMP TEAM
+    cmatrix_exec::scope exec(cmatrix_exec::openmp());
+    cmatrix_parallel::scope team;
+    team.set_threads(4);
+    EXPECT_THROW(cmatrix_task::run(cmatrix_parallel::REDUCTION, 1 << 30, []()
+                                   {
+                                       cmatrix_task::group g;
+                                       g.spawn([]() { throw std::runtime_error("task"); });
+                                       g.sync(); }),
+                 std::runtime_error);
+    EXPECT_THROW(cmatrix_task::run(cmatrix_parallel::REDUCTION, 1 << 30, []()
+                                   { throw std::logic_error("computation"); }),
+                 std::logic_error);
+}
+
+/** Test the distance between the rows of the buffer */
+TEST(MatrixTest, stride)
+{
+    // THE ROWS OF THE FLOATING POINT MATRICES ARE PADDED WITH CMATRIX_ALIGNED_ROWS
+    cmatrix<float> m(3, 5, 1.5);
+    cmatrix<int> i(3, 5, 1);
+    EXPECT_EQ(m.width(), 5);
+    EXPECT_EQ(m.stride(), CMATRIX_ALIGNED_ROWS ? 16 : 5);
+    EXPECT_EQ(i.stride(), 5);
+    EXPECT_EQ(cmatrix<double>(2, 9).stride(), CMATRIX_ALIGNED_ROWS ? 16 : 9);
+
+    // EACH ROW STARTS ON A CACHE LINE
+    for (size_t r = 0; r < m.height(); r++)
+    {
+        EXPECT_EQ(m.row_data(r), m.data() + r * m.stride());
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(m.row_data(r)) % (CMATRIX_ALIGNED_ROWS ? 64 : 1), 0);
+    }
+
+    // THE PADDING IS NOT PART OF THE MATRIX
+    cmatrix<float> n = {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(n + n, cmatrix<float>({{2, 4, 6}, {8, 10, 12}}));
+    EXPECT_EQ(n * 2.f - 1.f, cmatrix<float>({{1, 3, 5}, {7, 9, 11}}));
+    EXPECT_EQ((n > 2.f).sum_all().value(), 4);
+    EXPECT_EQ(n.sum_all(), 21);
+    EXPECT_EQ(n.transpose(), cmatrix<float>({{1, 4}, {2, 5}, {3, 6}}));
+    EXPECT_EQ(n.matmul(n.transpose()), cmatrix<float>({{14, 32}, {32, 77}}));
+    EXPECT_EQ(n.to_vector(), (std::vector<std::vector<float>>{{1, 2, 3}, {4, 5, 6}}));
+
+    n.insert_row(1, {7, 8, 9});
+    n.insert_column(0, {0, 0, 0});
+    EXPECT_EQ(n, cmatrix<float>({{0, 1, 2, 3}, {0, 7, 8, 9}, {0, 4, 5, 6}}));
+    EXPECT_EQ(n.stride(), CMATRIX_ALIGNED_ROWS ? 16 : 4);
+
+    n.remove_row(0);
+    EXPECT_EQ(n.mask([](float x) { return x > 6; }), cmatrix<cbool>({{false, true, true, true}, {false, false, false, false}}));
+
+    cmatrix<float> e;
+    e.insert_column(0, {1, 2});
+    EXPECT_EQ(e, cmatrix<float>({{1}, {2}}));
+}
+
+TEST(MatrixTest, layout)
+{
+    typedef cmatrix<int, cmatrix_layout::col_major> cmatrix_col;
+
+    // THE CELLS OF A COLUMN-MAJOR MATRIX ARE STORED COLUMN BY COLUMN
+    cmatrix_col m = {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(m.height(), 2);
+    EXPECT_EQ(m.width(), 3);
+    EXPECT_EQ(m.stride(), 2);
+    EXPECT_EQ(m.cell(1, 0), 4);
+    EXPECT_EQ(std::vector<int>(m.data(), m.data() + 6), std::vector<int>({1, 4, 2, 5, 3, 6}));
+    EXPECT_EQ(m.col_data(1)[1], 5);
+    EXPECT_EQ(m.to_vector(), (std::vector<std::vector<int>>{{1, 2, 3}, {4, 5, 6}}));
+
+    // FROM A VECTOR, COPIED
+    const std::vector<std::vector<int>> v = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix_col m_2(v);
+    EXPECT_EQ(m_2.height(), 2);
+    EXPECT_EQ(m_2.width(), 3);
+    EXPECT_EQ(m_2.cell(0, 2), 3);
+    EXPECT_EQ(m_2.cell(1, 0), 4);
+    EXPECT_EQ(std::vector<int>(m_2.data(), m_2.data() + 6), std::vector<int>({1, 4, 2, 5, 3, 6}));
+    EXPECT_EQ(v, (std::vector<std::vector<int>>{{1, 2, 3}, {4, 5, 6}}));
+
+    // CONVERSION BETWEEN THE LAYOUTS
+    cmatrix<int> r = m;
+    EXPECT_EQ(r, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+    EXPECT_EQ(cmatrix_col(r), m);
+    EXPECT_EQ(m, r);
+
+    cmatrix<int> big(70, 45);
+    for (size_t i = 0; i < big.height(); i++)
+        for (size_t j = 0; j < big.width(); j++)
+            big.cell(i, j) = i * 100 + j;
+    cmatrix_col big_col = big;
+    EXPECT_EQ(big_col.cell(69, 44), 6944);
+    EXPECT_EQ(cmatrix<int>(big_col), big);
+
+    // OPERATORS
+    EXPECT_EQ(m + m, cmatrix<int>({{2, 4, 6}, {8, 10, 12}}));
+    EXPECT_EQ(m * 2 - 1, cmatrix<int>({{1, 3, 5}, {7, 9, 11}}));
+    EXPECT_EQ(m + r, cmatrix<int>({{2, 4, 6}, {8, 10, 12}}));
+    EXPECT_EQ(m + cmatrix<int>({{10, 20, 30}}), cmatrix<int>({{11, 22, 33}, {14, 25, 36}}));
+    EXPECT_EQ(m + cmatrix_col({{10}, {20}}), cmatrix<int>({{11, 12, 13}, {24, 25, 26}}));
+    cmatrix_col a = m;
+    a += m;
+    a *= 2;
+    EXPECT_EQ(a, cmatrix<int>({{4, 8, 12}, {16, 20, 24}}));
+    EXPECT_EQ(m, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+
+    // THE RESULT IS COMPUTED IN THE BUFFER OF AN EXPIRING COLUMN-MAJOR MATRIX
+    cmatrix_col t = big;
+    const int *cells = t.data();
+    cmatrix_col u = std::move(t) * 2 + big;
+    EXPECT_EQ(u.data(), cells);
+    EXPECT_EQ(u, big * 3);
+    cmatrix_col x = big;
+    cells = x.data();
+    cmatrix_col w = 1 - (std::move(x) + cmatrix_col(big));
+    EXPECT_EQ(w.data(), cells);
+    EXPECT_EQ(w, 1 - big * 2);
+    EXPECT_TRUE((std::is_same<decltype(cmatrix_col() + r), cmatrix_col>::value));
+    EXPECT_TRUE((std::is_same<decltype(cmatrix_col() - cmatrix<int>()), cmatrix_col>::value));
+
+    // STATISTICS
+    EXPECT_EQ(m.sum(0), cmatrix<int>({{6}, {15}}));
+    EXPECT_EQ(m.sum(1), cmatrix<int>({{5, 7, 9}}));
+    EXPECT_EQ(m.min(0), cmatrix<int>({{1}, {4}}));
+    EXPECT_EQ(m.max(1), cmatrix<int>({{4, 5, 6}}));
+    EXPECT_EQ(m.mean(0), cmatrix<float>({{2}, {5}}));
+    EXPECT_EQ(m.mean(1), cmatrix<float>({{2.5, 3.5, 4.5}}));
+    EXPECT_EQ(m.std(1), cmatrix<float>({{1.5, 1.5, 1.5}}));
+    EXPECT_EQ(m.median(0), cmatrix<int>({{2}, {5}}));
+    EXPECT_EQ(big_col.sum(1), big.sum(1));
+    EXPECT_EQ(big_col.max(0), big.max(0));
+
+    // ROWS AND COLUMNS
+    EXPECT_EQ(m.columns_vec(2), std::vector<int>({3, 6}));
+    EXPECT_EQ(m.rows_vec(1), std::vector<int>({4, 5, 6}));
+    cmatrix_col s = m;
+    s.set_column(0, {7, 8});
+    s.set_row(0, {0, 0, 0});
+    EXPECT_EQ(s, cmatrix<int>({{0, 0, 0}, {8, 5, 6}}));
+
+    // MANIPULATION
+    cmatrix_col n = m;
+    n.insert_row(1, {7, 8, 9});
+    n.insert_column(0, {0, 0, 0});
+    EXPECT_EQ(n, cmatrix<int>({{0, 1, 2, 3}, {0, 7, 8, 9}, {0, 4, 5, 6}}));
+    n.remove_row(0);
+    n.remove_column(1);
+    EXPECT_EQ(n, cmatrix<int>({{0, 8, 9}, {0, 5, 6}}));
+    cmatrix_col c0 = m, c1 = m;
+    c0.concatenate(m, 0);
+    c1.concatenate(m, 1);
+    EXPECT_EQ(c0, cmatrix<int>({{1, 2, 3}, {4, 5, 6}, {1, 2, 3}, {4, 5, 6}}));
+    EXPECT_EQ(c1, cmatrix<int>({{1, 2, 3, 1, 2, 3}, {4, 5, 6, 4, 5, 6}}));
+
+    cmatrix_col e;
+    e.insert_column(0, {1, 2});
+    EXPECT_EQ(e, cmatrix<int>({{1}, {2}}));
+
+    // MATH AND MASKS
+    EXPECT_EQ(m.transpose(), cmatrix<int>({{1, 4}, {2, 5}, {3, 6}}));
+    EXPECT_EQ(m.matmul(m.transpose()), cmatrix<int>({{14, 32}, {32, 77}}));
+    EXPECT_EQ(m.matmul(r.transpose()), cmatrix<int>({{14, 32}, {32, 77}}));
+    EXPECT_EQ(m > 2, cmatrix<cbool>({{false, false, true}, {true, true, true}}));
+    EXPECT_EQ(m.mask([](int x) { return x % 2 == 0; }), cmatrix<cbool>({{false, true, false}, {true, false, true}}));
+}
+
+/** Test the fixed-size matrices */
+TEST(MatrixTest, fixed)
+{
+    // CONSTRUCTORS
+    cmatrix_fixed<int, 2, 3> m = {{1, 2, 3}, {4, 5, 6}};
+    EXPECT_EQ(m.height(), 2);
+    EXPECT_EQ(m.width(), 3);
+    EXPECT_EQ(m.cell(1, 2), 6);
+    EXPECT_EQ((cmatrix_fixed<int, 2, 2>(7).sum_all()), 28);
+    EXPECT_EQ((cmatrix_fixed<int, 2, 2>().sum_all()), 0);
+    EXPECT_THROW((cmatrix_fixed<int, 2, 2>({{1, 2}})), std::invalid_argument);
+    EXPECT_THROW((cmatrix_fixed<int, 2, 2>({{1, 2}, {3}})), std::invalid_argument);
+    EXPECT_THROW(m.cell(2, 0), std::out_of_range);
+
+    // COMPILE TIME ACCESS
+    static_assert(cmatrix_fixed<int, 3, 4>::height() == 3, "height");
+    static_assert(cmatrix_fixed<int, 3, 3>::is_square(), "is_square");
+
+    // CONVERSIONS
+    cmatrix<int> d = m.to_cmatrix();
+    EXPECT_EQ(d, cmatrix<int>({{1, 2, 3}, {4, 5, 6}}));
+    EXPECT_EQ((cmatrix_fixed<int, 2, 3>(d)), m);
+    EXPECT_THROW((cmatrix_fixed<int, 3, 2>(d)), std::invalid_argument);
+
+    // TRANSPOSE AND PRODUCT
+    cmatrix_fixed<int, 3, 2> t = m.transpose();
+    EXPECT_EQ(t, (cmatrix_fixed<int, 3, 2>({{1, 4}, {2, 5}, {3, 6}})));
+    EXPECT_EQ(m.matmul(t).to_cmatrix(), d.matmul(d.transpose()));
+    EXPECT_EQ(t.matmul(m).to_cmatrix(), d.transpose().matmul(d));
+
+    // OPERATORS
+    EXPECT_EQ(m + m, m * 2);
+    EXPECT_EQ((m - m).sum_all(), 0);
+    EXPECT_EQ(-m + m, (cmatrix_fixed<int, 2, 3>(0)));
+    EXPECT_EQ((m * m).to_cmatrix(), d * d);
+    EXPECT_EQ((m + 1).to_cmatrix(), d + 1);
+    EXPECT_EQ((m - 1).to_cmatrix(), d - 1);
+    EXPECT_EQ((m / 2).to_cmatrix(), d / 2);
+    EXPECT_THROW(m / 0, std::invalid_argument);
+    std::stringstream ss;
+    ss << m;
+    EXPECT_EQ(ss.str(), "[[1, 2, 3], [4, 5, 6]]");
+
+    // DETERMINANT
+    EXPECT_EQ((cmatrix_fixed<int, 1, 1>({{5}})).det(), 5);
+    EXPECT_EQ((cmatrix_fixed<int, 2, 2>({{1, 2}, {3, 4}})).det(), -2);
+    EXPECT_EQ((cmatrix_fixed<int, 3, 3>({{2, 0, 1}, {1, 3, 2}, {1, 1, 2}})).det(), 6);
+    EXPECT_EQ((cmatrix_fixed<int, 4, 4>({{1, 0, 2, -1}, {3, 0, 0, 5}, {2, 1, 4, -3}, {1, 0, 5, 0}})).det(), 30);
+    cmatrix_fixed<double, 5, 5> g = {{2, 1, 0, 0, 3}, {1, 3, 1, 0, 0}, {0, 1, 4, 1, 0}, {0, 0, 1, 5, 1}, {3, 0, 0, 1, 6}};
+    cmatrix_fixed<double, 4, 4> h = {{1, 0, 2, -1}, {3, 0, 0, 5}, {2, 1, 4, -3}, {1, 0, 5, 0}};
+    EXPECT_NEAR(h.det(), 30, 1e-9);
+    EXPECT_NEAR(g.det(), 30, 1e-9);
+
+    // THE DETERMINANT OF THE INTEGER MATRICES ABOVE 4x4 IS EXACT
+    cmatrix_fixed<int, 5, 5> g_int = {{2, 1, 0, 0, 3}, {1, 3, 1, 0, 0}, {0, 1, 4, 1, 0}, {0, 0, 1, 5, 1}, {3, 0, 0, 1, 6}};
+    EXPECT_EQ(g_int.det(), 30);
+    EXPECT_EQ((cmatrix_fixed<int, 5, 5>({{0, 1, 0, 0, 0}, {1, 0, 0, 0, 0}, {0, 0, 0, 0, 1}, {0, 0, 1, 0, 0}, {0, 0, 0, 1, 0}})).det(), -1);
+    EXPECT_EQ((cmatrix_fixed<int, 5, 5>(3)).det(), 0);
+
+    for (unsigned int seed = 1; seed <= 20; seed++)
+    {
+        const cmatrix<int> r_5 = cmatrix<int>::randint(5, 5, -9, 9, seed);
+        const cmatrix<int> r_6 = cmatrix<int>::randint(6, 6, -9, 9, seed);
+        EXPECT_EQ((cmatrix_fixed<int, 5, 5>(r_5)).det(), std::llround((cmatrix_fixed<double, 5, 5>(r_5.cast<double>())).det()));
+        EXPECT_EQ((cmatrix_fixed<long long, 6, 6>(r_6.cast<long long>())).det(), std::llround((cmatrix_fixed<double, 6, 6>(r_6.cast<double>())).det()));
+    }
+
+    // INVERSE
+    cmatrix_fixed<double, 2, 2> a = {{4, 7}, {2, 6}};
+    EXPECT_TRUE(a.inverse().near(cmatrix_fixed<double, 2, 2>({{0.6, -0.7}, {-0.2, 0.4}})));
+    cmatrix_fixed<double, 3, 3> b = {{2, 0, 1}, {1, 3, 2}, {1, 1, 2}};
+    EXPECT_TRUE(b.matmul(b.inverse()).near(cmatrix_fixed<double, 3, 3>::identity()));
+    EXPECT_TRUE(h.matmul(h.inverse()).near(cmatrix_fixed<double, 4, 4>::identity()));
+    EXPECT_TRUE(g.inverse().matmul(g).near(cmatrix_fixed<double, 5, 5>::identity()));
+    EXPECT_THROW((cmatrix_fixed<double, 2, 2>({{1, 2}, {2, 4}})).inverse(), std::invalid_argument);
+    EXPECT_THROW((cmatrix_fixed<double, 3, 3>(1)).inverse(), std::invalid_argument);
+    EXPECT_THROW((cmatrix_fixed<double, 5, 5>(1)).inverse(), std::invalid_argument);
 }
 
 /** Test log method of cmatrix class */
@@ -2735,6 +4172,210 @@ TEST(MatrixTest, op_pow)
     EXPECT_EQ(m_7 ^ 2, m_8);
 }
 
+/** Check the arithmetic operators of a matrix against the operators applied cell by cell */
+template <class T>
+void check_op_simd(const size_t &height, const size_t &width)
+{
+    cmatrix<T> m_1(height, width);
+    cmatrix<T> m_2(height, width);
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+        {
+            m_1.set_cell(r, c, T(r * width + c) - T(100));
+            m_2.set_cell(r, c, T((r + 2 * c) % 7 + 1));
+        }
+
+    const cmatrix<T> add = m_1 + m_2, sub = m_1 - m_2, mul = m_1 * m_2;
+    const cmatrix<T> add_val = m_1 + T(3), sub_val = m_1 - T(3), mul_val = m_1 * T(3), div_val = m_1 / T(3);
+
+    for (size_t r = 0; r < height; r++)
+        for (size_t c = 0; c < width; c++)
+        {
+            const T a = m_1.cell(r, c), b = m_2.cell(r, c);
+            EXPECT_EQ(add.cell(r, c), T(a + b));
+            EXPECT_EQ(sub.cell(r, c), T(a - b));
+            EXPECT_EQ(mul.cell(r, c), T(a * b));
+            EXPECT_EQ(add_val.cell(r, c), T(a + T(3)));
+            EXPECT_EQ(sub_val.cell(r, c), T(a - T(3)));
+            EXPECT_EQ(mul_val.cell(r, c), T(a * T(3)));
+            EXPECT_EQ(div_val.cell(r, c), T(a / T(3)));
+        }
+
+    // In place operators
+    cmatrix<T> m_3 = m_1;
+    m_3 += m_2;
+    EXPECT_EQ(m_3, add);
+    m_3 -= m_2;
+    EXPECT_EQ(m_3, m_1);
+    m_3 *= m_2;
+    EXPECT_EQ(m_3, mul);
+    m_3 = m_1;
+    m_3 /= T(3);
+    EXPECT_EQ(m_3, div_val);
+}
+
+/** Test the SIMD kernels of the arithmetic operators for each instruction set */
+TEST(MatrixTest, op_simd)
+{
+    const cmatrix_simd::isa detected = cmatrix_simd::level();
+    const cmatrix_simd::isa levels[] = {cmatrix_simd::SCALAR, cmatrix_simd::SSE42, cmatrix_simd::AVX2, cmatrix_simd::AVX512};
+
+    for (const cmatrix_simd::isa &level : levels)
+    {
+        cmatrix_simd::set_level(level);
+        EXPECT_LE(cmatrix_simd::level(), detected);
+
+        // ODD DIMENSIONS - REMAINING CELLS AFTER THE LAST REGISTER
+        check_op_simd<float>(7, 13);
+        check_op_simd<double>(7, 13);
+        check_op_simd<std::int32_t>(7, 13);
+        check_op_simd<std::int64_t>(7, 13);
+
+        // LARGE MATRICES - SEVERAL CHUNKS
+        check_op_simd<float>(131, 129);
+        check_op_simd<std::int32_t>(131, 129);
+        check_op_simd<std::int64_t>(131, 129);
+
+        // OTHER TYPES - SCALAR KERNELS
+        check_op_simd<short>(9, 11);
+    }
+
+    cmatrix_simd::set_level(detected);
+    EXPECT_EQ(cmatrix_simd::level(), detected);
+}
+
+/** Test the expression templates of the arithmetic operators */
+TEST(MatrixTest, op_expr)
+{
+    // FUSED EXPRESSION
+    cmatrix<int> m_1 = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> m_2 = {{6, 5, 4}, {3, 2, 1}};
+    cmatrix<int> m_3 = {{15, 15, 15}, {15, 15, 15}};
+    cmatrix<int> m_4 = m_1 * 2 + m_2 * 2 + 1 - (m_1 - m_1);
+    EXPECT_EQ(m_4, m_3);
+    EXPECT_EQ((m_1 + m_2) * 2 + 1, m_3);
+    EXPECT_EQ(m_3, (m_1 + m_2) * 2 + 1);
+
+    // EXPRESSION REFERENCING THE ASSIGNED MATRIX
+    cmatrix<int> m_5 = m_1;
+    m_5 = m_2 - m_5 * 2;
+    cmatrix<int> m_6 = {{4, 1, -2}, {-5, -8, -11}};
+    EXPECT_EQ(m_5, m_6);
+    m_5 += (m_1 * 2) - m_2;
+    EXPECT_EQ(m_5, cmatrix<int>(2, 3, 0));
+
+    // ASSIGNMENT CHANGING THE DIMENSIONS
+    cmatrix<int> m_7 = {{1}};
+    m_7 = m_1 + 1;
+    cmatrix<int> m_8 = {{2, 3, 4}, {5, 6, 7}};
+    EXPECT_EQ(m_7, m_8);
+
+    // REDUCTIONS WITHOUT EVALUATION
+    EXPECT_EQ((m_1 + m_2).sum_all(), 42);
+    EXPECT_EQ((m_1 - m_2).min_all(), -5);
+    EXPECT_EQ((m_1 * m_2).max_all(), 12);
+    EXPECT_EQ((m_1 * 2).eval(), m_1 + m_1);
+    EXPECT_THROW((cmatrix<int>() + 1).min_all(), std::invalid_argument);
+
+    // OTHER TYPES
+    cmatrix<std::string> m_9 = {{"a", "b"}};
+    cmatrix<std::string> m_10 = {{"ac", "bc"}};
+    EXPECT_EQ(m_9 + std::string("c"), m_10);
+
+    // NOT EQUAL DIMENSIONS
+    EXPECT_THROW(m_1 * 2 + m_7.transpose(), std::invalid_argument);
+    EXPECT_THROW(m_1 += m_7.transpose() * 2, std::invalid_argument);
+}
+
+/** Test the broadcasting of the single rows and columns by the operators */
+TEST(MatrixTest, op_broadcast)
+{
+    cmatrix<int> m = {{1, 2, 3}, {4, 5, 6}};
+    cmatrix<int> row = {{10, 20, 30}};
+    cmatrix<int> col = {{100}, {200}};
+
+    // ROW AND COLUMN
+    EXPECT_EQ(m + row, cmatrix<int>({{11, 22, 33}, {14, 25, 36}}));
+    EXPECT_EQ(row - m, cmatrix<int>({{9, 18, 27}, {6, 15, 24}}));
+    EXPECT_EQ(m - col, cmatrix<int>({{-99, -98, -97}, {-196, -195, -194}}));
+    EXPECT_EQ(col - m, cmatrix<int>({{99, 98, 97}, {196, 195, 194}}));
+    EXPECT_EQ(m * col, cmatrix<int>({{100, 200, 300}, {800, 1000, 1200}}));
+    EXPECT_EQ(row + col, cmatrix<int>({{110, 120, 130}, {210, 220, 230}}));
+    EXPECT_EQ(m + cmatrix<int>(1, 1, 1), m + 1);
+
+    // EXPRESSIONS AND VIEWS
+    EXPECT_EQ(m - row * 2 + 1, cmatrix<int>({{-18, -37, -56}, {-15, -34, -53}}));
+    EXPECT_EQ(m - m.slice_rows(0, 0), cmatrix<int>({{0, 0, 0}, {3, 3, 3}}));
+    EXPECT_EQ((m + col).sum_all(), 921);
+
+    // EXPIRING MATRICES
+    EXPECT_EQ(cmatrix<int>(m) + row, m + row);
+    EXPECT_EQ(cmatrix<int>(row) + m, m + row);
+    EXPECT_EQ(cmatrix<int>(col) - cmatrix<int>(m), col - m);
+
+    // ASSIGNMENT OPERATORS
+    cmatrix<int> m_2 = m;
+    m_2 += row;
+    m_2 -= col;
+    m_2 *= row;
+    EXPECT_EQ(m_2, cmatrix<int>({{-890, -1560, -2010}, {-1860, -3500, -4920}}));
+    m_2 /= cmatrix<int>({{10, 20, 30}});
+    EXPECT_EQ(m_2, cmatrix<int>({{-89, -78, -67}, {-186, -175, -164}}));
+    EXPECT_THROW(row += m, std::invalid_argument);
+    EXPECT_EQ(row, cmatrix<int>({{10, 20, 30}}));
+
+    // BROADCAST VIEWS OF THE ASSIGNED MATRIX
+    cmatrix<int> r = {{1, 2}, {3, 4}, {5, 6}};
+    cmatrix<int> n = r.copy(), k = r.copy();
+    r -= r.slice_rows(0, 0);
+    n = n - n.slice_rows(0, 0);
+    k = k.slice_columns(0, 0) + k;
+    EXPECT_EQ(r, cmatrix<int>({{0, 0}, {2, 2}, {4, 4}}));
+    EXPECT_EQ(n, cmatrix<int>({{0, 0}, {2, 2}, {4, 4}}));
+    EXPECT_EQ(k, cmatrix<int>({{2, 3}, {6, 7}, {10, 11}}));
+
+    // A copy would share the buffer, and the assigned matrix would move to a new one
+    cmatrix<float> f = cmatrix<int>::randint(50, 40, -9, 9, 5).cast<float>();
+    cmatrix<float> f_2 = cmatrix<int>::randint(50, 40, -9, 9, 6).cast<float>();
+    cmatrix<float> expected = f - cmatrix<float>(f.slice_columns(0, 0));
+    cmatrix<float> expected_2 = f_2 * cmatrix<float>(f_2.slice_rows(0, 0));
+    f -= f.slice_columns(0, 0);
+    f_2 *= f_2.slice_rows(0, 0);
+    EXPECT_EQ(f, expected);
+    EXPECT_EQ(f_2, expected_2);
+
+    // CENTERED MATRIX - SIMD KERNELS ROW BY ROW
+    cmatrix<float> m_3(67, 35);
+    m_3.apply([](float x, size_t r, size_t c) { return float(r * 3 + c % 7); });
+    cmatrix<float> mean = m_3.mean(1);
+    cmatrix<float> max = m_3.max(0);
+    cmatrix<float> centered = m_3 - mean;
+    cmatrix<float> normalized = m_3 / (max + 1);
+    for (size_t r = 0; r < m_3.height(); r++)
+        for (size_t c = 0; c < m_3.width(); c++)
+        {
+            EXPECT_FLOAT_EQ(centered.cell(r, c), m_3.cell(r, c) - mean.cell(0, c));
+            EXPECT_FLOAT_EQ(normalized.cell(r, c), m_3.cell(r, c) / (max.cell(r, 0) + 1));
+        }
+
+    // BOOLEAN MATRICES
+    cmatrix<cbool> b = {{1, 0, 0}, {0, 0, 1}};
+    EXPECT_EQ(b + cmatrix<cbool>({{0, 1, 0}}), cmatrix<cbool>({{1, 1, 0}, {0, 1, 1}}));
+    EXPECT_EQ(b * cmatrix<cbool>({{1}, {0}}), cmatrix<cbool>({{1, 0, 0}, {0, 0, 0}}));
+
+    // MASKS
+    EXPECT_EQ(m.gt(cmatrix<int>({{2, 2, 5}})), cmatrix<cbool>({{0, 0, 0}, {1, 1, 1}}));
+    EXPECT_EQ(m.leq(cmatrix<int>({{1}, {5}})), cmatrix<cbool>({{1, 0, 0}, {1, 1, 0}}));
+    EXPECT_EQ(cmatrix<int>({{2}, {5}}).eq(m), cmatrix<cbool>({{0, 1, 0}, {0, 1, 0}}));
+    EXPECT_EQ(b.eq(cmatrix<cbool>({{1, 0, 1}})), cmatrix<cbool>({{1, 1, 0}, {0, 1, 1}}));
+
+    // INCOMPATIBLE DIMENSIONS
+    EXPECT_THROW(m + cmatrix<int>(1, 2), std::invalid_argument);
+    EXPECT_THROW(m - cmatrix<int>(3, 1), std::invalid_argument);
+    EXPECT_THROW(m.lt(cmatrix<int>(2, 2)), std::invalid_argument);
+}
+
 /** Test op_assign_sum method of cmatrix class */
 TEST(MatrixTest, op_assign_sum)
 {
@@ -2903,6 +4544,18 @@ TEST(MatrixTest, op_assign_power)
     cmatrix<int> m_7;
     m_7 ^= 2;
     EXPECT_EQ(m_7, cmatrix<int>());
+
+    // IN PLACE - THE BUFFER IS KEPT
+    cmatrix<int> m_8 = {{1, 2}, {3, 4}};
+    const int *data = m_8.data();
+    m_8 ^= 3;
+    m_8 += m_8;
+    m_8 -= 1;
+    m_8 *= cmatrix<int>(2, 2, 2);
+    m_8 /= 2;
+    m_8 += 2 * m_8;
+    EXPECT_EQ(m_8.data(), data);
+    EXPECT_EQ(m_8, cmatrix<int>({{3, 45}, {159, 381}}));
 }
 
 /** Test op_not method of cmatrix class */